@@ -0,0 +1,130 @@
+#include "bench.h"
+#include "../include/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+// HARNESS STATE
+
+
+static BenchResult results[BENCH_MAX_RESULTS];
+static int result_count = 0;
+
+
+// HELPERS
+
+
+// Sort helper for per-operation times
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of sorted samples
+static double sample_percentile(const double *sorted, int count, double percentile) {
+    int rank = (int)(percentile / 100.0 * count + 0.999999);
+    if (rank < 1) {
+        rank = 1;
+    }
+    return sorted[min(rank, count) - 1];
+}
+
+// Time one batch of operations
+static int64_t time_batch(BenchFn fn, void *context, long iterations) {
+    int64_t start = get_monotonic_ns();
+    fn(context, iterations);
+    return get_monotonic_ns() - start;
+}
+
+
+// HARNESS API
+
+
+// Run and record one benchmark
+const BenchResult* bench_run(const char *name, long size, BenchFn fn, void *context) {
+    if (result_count >= BENCH_MAX_RESULTS) {
+        fprintf(stderr, "Too many benchmark results\n");
+        return NULL;
+    }
+
+    // Calibrate the batch size; this also warms caches and branch predictors
+    long iterations = 1;
+    while (time_batch(fn, context, iterations) < BENCH_MIN_BATCH_NS && iterations < (1L << 30)) {
+        iterations *= 2;
+    }
+    for (int i = 0; i < BENCH_WARMUP_BATCHES; i++) {
+        time_batch(fn, context, iterations);
+    }
+
+    double samples[BENCH_SAMPLES];
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        samples[i] = (double)time_batch(fn, context, iterations) / iterations;
+    }
+    qsort(samples, BENCH_SAMPLES, sizeof(double), compare_double);
+
+    BenchResult *result = &results[result_count++];
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    result->size = size;
+    result->iterations = iterations;
+    result->median_ns = sample_percentile(samples, BENCH_SAMPLES, 50.0);
+    result->p90_ns = sample_percentile(samples, BENCH_SAMPLES, 90.0);
+    result->p99_ns = sample_percentile(samples, BENCH_SAMPLES, 99.0);
+    result->min_ns = samples[0];
+    result->max_ns = samples[BENCH_SAMPLES - 1];
+    result->ops_per_sec = result->median_ns > 0 ? 1e9 / result->median_ns : 0.0;
+
+    printf("%-28s %9ld | %10.1f ns/op  p90 %10.1f  p99 %10.1f | %12.0f ops/s\n",
+           result->name, result->size, result->median_ns, result->p90_ns, result->p99_ns,
+           result->ops_per_sec);
+    fflush(stdout);
+    return result;
+}
+
+// Results recorded so far
+int bench_result_count(void) {
+    return result_count;
+}
+
+// Get a recorded result
+const BenchResult* bench_result(int index) {
+    if (index < 0 || index >= result_count) {
+        return NULL;
+    }
+    return &results[index];
+}
+
+// Write every recorded result as JSON
+int bench_write_json(const char *path, const char *suite) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return -1;
+    }
+
+    char timestamp[32];
+    time_t now = time(NULL);
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"suite\": \"%s\",\n", suite);
+    fprintf(file, "  \"timestamp\": \"%s\",\n", timestamp);
+    fprintf(file, "  \"compiler\": \"%s\",\n", __VERSION__);
+    fprintf(file, "  \"samples\": %d,\n", BENCH_SAMPLES);
+    fprintf(file, "  \"results\": [\n");
+    for (int i = 0; i < result_count; i++) {
+        const BenchResult *r = &results[i];
+        fprintf(file, "    {\"name\": \"%s\", \"size\": %ld, \"iterations\": %ld, "
+                "\"ns_per_op\": {\"median\": %.2f, \"p90\": %.2f, \"p99\": %.2f, "
+                "\"min\": %.2f, \"max\": %.2f}, \"ops_per_sec\": %.0f}%s\n",
+                r->name, r->size, r->iterations, r->median_ns, r->p90_ns, r->p99_ns,
+                r->min_ns, r->max_ns, r->ops_per_sec, i + 1 < result_count ? "," : "");
+    }
+    fprintf(file, "  ]\n");
+    fprintf(file, "}\n");
+
+    fclose(file);
+    return 0;
+}
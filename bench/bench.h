@@ -0,0 +1,44 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// BENCHMARK HARNESS
+
+// Each benchmark is a function that performs `iterations` operations. The
+// harness doubles the batch size until one batch takes BENCH_MIN_BATCH_NS,
+// runs BENCH_WARMUP_BATCHES more untimed, then times BENCH_SAMPLES batches
+// and reports the distribution of per-operation times across them.
+#define BENCH_MIN_BATCH_NS 200000       // 0.2 ms per timed batch
+#define BENCH_WARMUP_BATCHES 3
+#define BENCH_SAMPLES 31
+#define BENCH_MAX_RESULTS 256
+
+// Operation under test; `context` is the benchmark's own state
+typedef void (*BenchFn)(void *context, long iterations);
+
+// Per-operation timing of one benchmark at one structure size
+typedef struct {
+    char name[48];                  // Operation measured
+    long size;                      // Tasks in the structure (0 = not size-dependent)
+    long iterations;                // Operations per timed batch
+    double median_ns;               // Per-operation time percentiles across batches
+    double p90_ns;
+    double p99_ns;
+    double min_ns;
+    double max_ns;
+    double ops_per_sec;             // 1e9 / median_ns
+} BenchResult;
+
+
+// BENCHMARK FUNCTIONS
+
+// Run and record one benchmark; prints a result line and returns it
+const BenchResult* bench_run(const char *name, long size, BenchFn fn, void *context);
+
+// Results recorded so far
+int bench_result_count(void);
+const BenchResult* bench_result(int index);
+
+// Write every recorded result as JSON; returns 0 on success
+int bench_write_json(const char *path, const char *suite);
+
+#endif // BENCH_H
@@ -0,0 +1,262 @@
+#define _DEFAULT_SOURCE
+#include "bench.h"
+#include "../include/scheduler.h"
+#include "../include/task_manager.h"
+#include "../include/log_ring.h"
+#include "../include/utils.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+
+// BENCHMARK CONFIGURATION
+
+
+#define DEFAULT_JSON_PATH "output/bench_results.json"
+
+static const long structure_sizes[] = {10, 100, 1000, 10000, 100000, 1000000};
+
+// Selection functions measured, with the algorithm whose ready structure each uses
+typedef struct {
+    const char *name;
+    SchedulerAlgorithm algorithm;
+    Task* (*select)(void);
+} SelectionBench;
+
+static const SelectionBench selections[] = {
+    {"schedule_fcfs", SCHEDULER_FCFS, schedule_fcfs},
+    {"schedule_sjf", SCHEDULER_SJF, schedule_sjf},
+    {"schedule_priority", SCHEDULER_PRIORITY, schedule_priority},
+    {"schedule_round_robin", SCHEDULER_ROUND_ROBIN, schedule_round_robin},
+    {"schedule_battery_aware", SCHEDULER_BATTERY_AWARE, schedule_battery_aware},
+    {"schedule_edf", SCHEDULER_EDF, schedule_edf},
+    {"schedule_energy_edf", SCHEDULER_ENERGY_EDF, schedule_energy_edf},
+    {"schedule_cfs", SCHEDULER_CFS, schedule_cfs},
+};
+
+#define NUM_SELECTIONS (int)(sizeof(selections) / sizeof(selections[0]))
+
+
+// BENCHMARK STATE
+
+
+static TaskQueue *queue;            // Queue benchmarks
+static const SelectionBench *selection;
+static Task *probe_task;            // Task passed to can_admit_task()
+static unsigned int lookup_seed;
+static long pool_size;
+
+
+// HELPERS
+
+
+// Create `count` tasks with mixed priority, energy and criticality. Burst
+// times fit one quantum and deadlines are far off, so energy-aware EDF
+// neither drops nor defers them.
+static void create_tasks(long count) {
+    srand(42);
+    for (long i = 0; i < count; i++) {
+        create_task("Bench", 1 + rand() % 3, 1 + rand() % 3, 10 + rand() % 90,
+                    (rand() % 8) == 0, 1000000 + rand() % 1000000);
+    }
+}
+
+// Cheap pseudo-random number for lookups (rand() would dominate get_task)
+static unsigned int next_random(void) {
+    lookup_seed = lookup_seed * 1103515245u + 12345u;
+    return lookup_seed >> 8;
+}
+
+
+// OPERATIONS
+
+
+// Dequeue the head and enqueue it at the tail (queue stays at its size)
+static void op_queue_cycle(void *context, long iterations) {
+    (void)context;
+    for (long i = 0; i < iterations; i++) {
+        enqueue_task(queue, dequeue_task(queue));
+    }
+}
+
+// Create a task and remove it again (pool stays at its size)
+static void op_create_remove(void *context, long iterations) {
+    (void)context;
+    for (long i = 0; i < iterations; i++) {
+        Task *task = create_task("Churn", PRIORITY_MEDIUM, ENERGY_MEDIUM, 100, false, 5000);
+        remove_task(task->task_id);
+    }
+}
+
+// Look up random live task IDs
+static void op_get_task(void *context, long iterations) {
+    (void)context;
+    for (long i = 0; i < iterations; i++) {
+        Task *task = get_task(1 + (int)(next_random() % pool_size));
+        if (task == NULL) {
+            abort();  // IDs 1..pool_size must stay live
+        }
+    }
+}
+
+// Select the next task and re-queue it, as the run loop does on preemption
+static void op_select_requeue(void *context, long iterations) {
+    (void)context;
+    for (long i = 0; i < iterations; i++) {
+        Task *task = selection->select();
+        if (task == NULL) {
+            abort();  // The ready structure must never drain
+        }
+        preempt_task(task);
+    }
+}
+
+// Admission check against a populated scheduler
+static void op_can_admit(void *context, long iterations) {
+    (void)context;
+    volatile bool admitted;
+    for (long i = 0; i < iterations; i++) {
+        admitted = can_admit_task(probe_task);
+    }
+    (void)admitted;
+}
+
+// Log call at an enabled level through the log ring. The ring is drained
+// every half ring so no entry is dropped; the writer's share is included.
+static void op_log_enabled(void *context, long iterations) {
+    (void)context;
+    for (long i = 0; i < iterations; i++) {
+        LOG_INFO("Scheduled task: ID=%ld, Name=%s", i, "Bench");
+        if (i % (LOG_RING_CAPACITY / 2) == LOG_RING_CAPACITY / 2 - 1) {
+            log_ring_flush();
+        }
+    }
+    log_ring_flush();
+}
+
+// Log call above the runtime level (filtered before formatting)
+static void op_log_filtered(void *context, long iterations) {
+    (void)context;
+    for (long i = 0; i < iterations; i++) {
+        LOG_DEBUG("Scheduling decision - Task: %ld, Reason: %s", i, "bench");
+    }
+}
+
+
+// BENCHMARK GROUPS
+
+
+// Task queue enqueue/dequeue at a queue size
+static void bench_queue(long size) {
+    task_manager_init();
+    create_tasks(size);
+    queue = create_task_queue();
+    for (long id = 1; id <= size; id++) {
+        enqueue_task(queue, get_task((int)id));
+    }
+
+    bench_run("enqueue_dequeue", size, op_queue_cycle, NULL);
+
+    destroy_task_queue(queue);
+    task_manager_cleanup();
+}
+
+// Task pool create/remove and lookup at a pool size
+static void bench_task_pool(long size) {
+    task_manager_init();
+    create_tasks(size);
+    pool_size = size;
+    lookup_seed = 1;
+
+    bench_run("get_task", size, op_get_task, NULL);
+    bench_run("create_remove_task", size, op_create_remove, NULL);
+
+    task_manager_cleanup();
+}
+
+// Every selection function, and admission, with `size` ready tasks
+static void bench_scheduler(long size) {
+    for (int i = 0; i < NUM_SELECTIONS; i++) {
+        selection = &selections[i];
+        scheduler_init(selection->algorithm);
+        create_tasks(size);
+        for (long id = 1; id <= size; id++) {
+            admit_task_to_scheduler(get_task((int)id));
+        }
+
+        bench_run(selection->name, size, op_select_requeue, NULL);
+        if (selection->algorithm == SCHEDULER_BATTERY_AWARE) {
+            probe_task = get_task(1);
+            bench_run("can_admit_task", size, op_can_admit, NULL);
+        }
+
+        scheduler_cleanup();
+    }
+}
+
+// Logging calls: queued to the ring and filtered by level
+static void bench_logging(void) {
+    int null_fd = open("/dev/null", O_WRONLY);
+    log_ring_start(-1, null_fd);
+    set_log_level(LOG_LEVEL_INFO);
+
+    bench_run("log_info_written", 0, op_log_enabled, NULL);
+    bench_run("log_debug_filtered", 0, op_log_filtered, NULL);
+
+    log_ring_stop();
+    set_log_level(LOG_LEVEL_ERROR);
+    if (log_ring_dropped() > 0) {
+        printf("(log ring full: %ld entries dropped)\n", log_ring_dropped());
+    }
+    close(null_fd);
+}
+
+
+// MAIN
+
+
+int main(int argc, char *argv[]) {
+    const char *json_path = DEFAULT_JSON_PATH;
+    long max_size = structure_sizes[sizeof(structure_sizes) / sizeof(structure_sizes[0]) - 1];
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--json=", 7) == 0) {
+            json_path = argv[i] + 7;
+        } else if (strncmp(argv[i], "--max-size=", 11) == 0) {
+            max_size = atol(argv[i] + 11);
+        } else {
+            fprintf(stderr, "Usage: %s [--json=FILE] [--max-size=N]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // No per-task log lines while structures are built; simulated time so
+    // task ages (and energy-aware EDF drops) do not depend on run time
+    set_log_level(LOG_LEVEL_ERROR);
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+
+    printf("\n========================================\n");
+    printf("   CORE DATA STRUCTURE BENCHMARK\n");
+    printf("========================================\n");
+    printf("%-28s %9s | median per operation across %d batches\n\n",
+           "Operation", "Size", BENCH_SAMPLES);
+
+    for (size_t i = 0; i < sizeof(structure_sizes) / sizeof(structure_sizes[0]); i++) {
+        long size = structure_sizes[i];
+        if (size > max_size) {
+            break;
+        }
+        bench_queue(size);
+        bench_task_pool(size);
+        bench_scheduler(size);
+        printf("\n");
+    }
+    bench_logging();
+
+    if (bench_write_json(json_path, "core") != 0) {
+        return EXIT_FAILURE;
+    }
+    printf("\n✓ Results saved to %s\n", json_path);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,161 @@
+#define _DEFAULT_SOURCE
+#include "../include/task_manager.h"
+#include "../include/simd_scan.h"
+#include "../include/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+
+// BENCHMARK CONFIGURATION
+
+
+#define REPETITIONS 51
+#define READY_FRACTION 2            // One in READY_FRACTION tasks is ready
+
+static const int pool_sizes[] = {10000, 100000, 1000000};
+
+// Battery-aware style score: critical first, then energy, then priority
+static const TaskScanWeights weights = {
+    .priority = 1, .energy_cost = 4, .remaining_time = 0, .deadline = 0, .non_critical = 16
+};
+
+
+// HELPERS
+
+
+// Monotonic time in nanoseconds
+static long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Sort helper for medians
+static int compare_ll(const void *a, const void *b) {
+    long long x = *(const long long*)a;
+    long long y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+// Score of a task in the array-of-structs baseline
+static inline int32_t task_score(const Task *task) {
+    return weights.priority * task->priority +
+           weights.energy_cost * task->energy_cost +
+           weights.remaining_time * task->remaining_time +
+           weights.deadline * task->deadline +
+           weights.non_critical * (task->is_critical ? 0 : 1);
+}
+
+// Baseline: scan contiguous Task structs the way the old ready queue did
+static const Task* scan_array_of_structs(const Task *tasks, int count) {
+    const Task *best = NULL;
+    int32_t best_score = 0;
+    for (int i = 0; i < count; i++) {
+        if (tasks[i].state != TASK_STATE_READY) {
+            continue;
+        }
+        int32_t score = task_score(&tasks[i]);
+        if (best == NULL || score < best_score) {
+            best = &tasks[i];
+            best_score = score;
+        }
+    }
+    return best;
+}
+
+
+// BENCHMARK
+
+
+// Median time of one selection scan over the pool with the given kernel
+static long long time_pool_scan(ScanKernel kernel, int *best_id) {
+    long long samples[REPETITIONS];
+    set_scan_kernel(kernel);
+
+    for (int r = 0; r < REPETITIONS; r++) {
+        long long start = now_ns();
+        Task *best = scan_best_task(TASK_STATE_READY, &weights);
+        samples[r] = now_ns() - start;
+        *best_id = best ? best->task_id : -1;
+    }
+
+    qsort(samples, REPETITIONS, sizeof(long long), compare_ll);
+    return samples[REPETITIONS / 2];
+}
+
+// Median time of the array-of-structs baseline scan
+static long long time_aos_scan(const Task *tasks, int count, int *best_id) {
+    long long samples[REPETITIONS];
+
+    for (int r = 0; r < REPETITIONS; r++) {
+        long long start = now_ns();
+        const Task *best = scan_array_of_structs(tasks, count);
+        samples[r] = now_ns() - start;
+        *best_id = best ? best->task_id : -1;
+    }
+
+    qsort(samples, REPETITIONS, sizeof(long long), compare_ll);
+    return samples[REPETITIONS / 2];
+}
+
+// Benchmark every kernel on one pool size
+static void run_size(int count) {
+    srand(42);
+    task_manager_init();
+
+    Task *aos = (Task*)safe_malloc((size_t)count * sizeof(Task));
+    for (int i = 0; i < count; i++) {
+        Task *task = create_task("Scan", 1 + rand() % 3, 1 + rand() % 3,
+                                 100 + rand() % 900, (rand() % 8) == 0, 1000 + rand() % 9000);
+        if (rand() % READY_FRACTION != 0) {
+            task->state = TASK_STATE_WAITING;
+            update_task_keys(task);
+        }
+        aos[i] = *task;
+    }
+
+    int baseline_id;
+    long long baseline = time_aos_scan(aos, count, &baseline_id);
+    printf("%9d tasks | %-14s | %10lld ns | %6.2f ns/task |  1.00x\n",
+           count, "AoS scalar", baseline, (double)baseline / count);
+
+    ScanKernel kernels[] = {SCAN_KERNEL_SCALAR, SCAN_KERNEL_SSE41, SCAN_KERNEL_AVX2};
+    for (int k = 0; k < 3; k++) {
+        set_scan_kernel(kernels[k]);
+        if (get_scan_kernel() != kernels[k]) {
+            continue;  // Not supported on this CPU
+        }
+
+        int best_id;
+        long long elapsed = time_pool_scan(kernels[k], &best_id);
+        char label[32];
+        snprintf(label, sizeof(label), "SoA %s", scan_kernel_name(kernels[k]));
+        printf("%9d tasks | %-14s | %10lld ns | %6.2f ns/task | %5.2fx%s\n",
+               count, label, elapsed, (double)elapsed / count,
+               (double)baseline / elapsed, best_id == baseline_id ? "" : "  MISMATCH");
+    }
+    printf("\n");
+
+    set_scan_kernel(SCAN_KERNEL_AUTO);
+    free(aos);
+    task_manager_cleanup();
+}
+
+
+// MAIN
+
+
+int main(void) {
+    set_log_level(LOG_LEVEL_ERROR);  // No per-task log lines while pools are built
+
+    printf("\n========================================\n");
+    printf("   SELECTION SCAN BENCHMARK\n");
+    printf("========================================\n");
+    printf("Best kernel on this CPU: %s\n\n", scan_kernel_name(get_scan_kernel()));
+
+    for (size_t i = 0; i < sizeof(pool_sizes) / sizeof(pool_sizes[0]); i++) {
+        run_size(pool_sizes[i]);
+    }
+
+    return EXIT_SUCCESS;
+}
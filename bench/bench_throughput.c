@@ -0,0 +1,263 @@
+#include "../include/scheduler.h"
+#include "../include/task_manager.h"
+#include "../include/utils.h"
+#include "../include/workload.h"
+#include "../include/replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+// BENCHMARK CONFIGURATION
+
+
+#define DEFAULT_JSON_PATH "output/bench_throughput.json"
+
+// The charger tops the battery up before it reaches the critical level, so
+// long runs keep cycling through the other modes instead of shutting down
+#define RECHARGE_LEVEL (BATTERY_CRITICAL + 5)
+
+// Offered load: mean work arriving per ms of CPU time
+#define DEFAULT_LOAD 0.9
+
+static const struct {
+    const char *name;
+    SchedulerAlgorithm algorithm;
+} algorithms[] = {
+    {"FCFS", SCHEDULER_FCFS},
+    {"SJF", SCHEDULER_SJF},
+    {"PRIORITY", SCHEDULER_PRIORITY},
+    {"ROUND ROBIN", SCHEDULER_ROUND_ROBIN},
+    {"BATTERY-AWARE", SCHEDULER_BATTERY_AWARE},
+    {"EDF", SCHEDULER_EDF},
+    {"ENERGY-AWARE EDF", SCHEDULER_ENERGY_EDF},
+    {"FAIR (CFS)", SCHEDULER_CFS},
+};
+
+#define NUM_ALGORITHMS (int)(sizeof(algorithms) / sizeof(algorithms[0]))
+
+
+// WORKLOAD
+
+
+// Arrival state of one run: the workload stream plus the charger
+typedef struct {
+    WorkloadStream stream;
+    int recharges;                  // Battery top-ups
+} BenchArrivals;
+
+// Arrival source: top the battery up if needed, then admit what has arrived
+static long admit_arrivals(long now_ms, void *context) {
+    BenchArrivals *arrivals = (BenchArrivals*)context;
+
+    if (get_battery_level() <= RECHARGE_LEVEL) {
+        set_battery_level(100);
+        arrivals->recharges++;
+    }
+    return workload_stream_admit(now_ms, &arrivals->stream);
+}
+
+
+// MEASUREMENT
+
+
+// Outcome of one algorithm's run
+typedef struct {
+    const char *name;
+    long decisions;                 // Tasks dispatched by the run loop
+    double wall_sec;                // Real time spent in the run loop
+    double simulated_sec;           // Virtual time covered
+    size_t memory_bytes;            // Scheduler and task manager allocations at the end
+    int peak_live;                  // Most live tasks at once
+    int completed;
+    int dropped;
+    int unfinished;                 // Still held at the end (suspended by energy-aware EDF)
+    long rejected;
+    int recharges;
+} ThroughputResult;
+
+// Run the whole workload through one algorithm: the recorded trace at
+// replay_path, or else the generated one
+static ThroughputResult run_algorithm(int index, const WorkloadConfig *workload,
+                                      const char *replay_path) {
+    ThroughputResult result;
+    WorkloadGenerator gen;
+    WorkloadReplay replay;
+    BenchArrivals arrivals = {.recharges = 0};
+
+    reset_virtual_clock();
+    scheduler_init(algorithms[index].algorithm);
+    if (replay_path != NULL && replay_open(&replay, replay_path) == SUCCESS) {
+        workload_stream_start(&arrivals.stream, replay_next, &replay);
+    } else {
+        replay_path = NULL;
+        workload_init(&gen, workload);
+        workload_stream_start(&arrivals.stream, workload_next, &gen);
+    }
+    set_arrival_source(admit_arrivals, &arrivals);
+
+    long sim_start = get_current_time_ms();
+    int64_t wall_start = get_monotonic_ns();
+    scheduler_start();
+    scheduler_run_loop();
+    scheduler_stop();
+    int64_t wall_ns = get_monotonic_ns() - wall_start;
+
+    SchedulerStats *stats = get_scheduler_statistics();
+    result.name = algorithms[index].name;
+    result.decisions = stats->dispatches;
+    result.wall_sec = (double)wall_ns / NS_PER_SEC;
+    result.simulated_sec = (get_current_time_ms() - sim_start) / 1000.0;
+    result.memory_bytes = get_scheduler_memory_usage();
+    result.peak_live = arrivals.stream.peak_live;
+    result.completed = stats->tasks_completed;
+    result.dropped = stats->tasks_dropped;
+    result.unfinished = get_task_count();
+    result.rejected = arrivals.stream.rejected;
+    result.recharges = arrivals.recharges;
+
+    scheduler_cleanup();
+    if (replay_path != NULL) {
+        replay_close(&replay);
+    }
+    return result;
+}
+
+// Print one result row
+static void print_result(const ThroughputResult *r) {
+    printf("%-17s %9ld %12.0f %9d %9.1f %10.0f %9d %7d %10d %8ld\n",
+           r->name, r->decisions, r->decisions / r->wall_sec, r->peak_live,
+           (double)r->memory_bytes / max(r->peak_live, 1), r->simulated_sec / r->wall_sec,
+           r->completed, r->dropped, r->unfinished, r->rejected);
+}
+
+// Write every result as JSON; returns 0 on success
+static int write_json(const char *path, const WorkloadConfig *w, double load,
+                      const char *replay_path, const ThroughputResult *results, int count) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return -1;
+    }
+
+    char timestamp[32];
+    time_t now = time(NULL);
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"suite\": \"throughput\",\n");
+    fprintf(file, "  \"timestamp\": \"%s\",\n", timestamp);
+    fprintf(file, "  \"compiler\": \"%s\",\n", __VERSION__);
+    fprintf(file, "  \"workload\": {\"tasks\": %ld, \"load\": %.2f, \"pareto_alpha\": %.2f, "
+            "\"min_burst_ms\": %d, \"max_burst_ms\": %d, \"critical_bursts_per_sec\": %.2f, "
+            "\"critical_burst_max\": %d, \"seed\": %u},\n",
+            w->task_count, load, w->pareto_alpha, w->min_burst_ms, w->max_burst_ms,
+            w->critical_bursts_per_sec, w->critical_burst_max, (unsigned)w->seed);
+    if (replay_path != NULL) {
+        fprintf(file, "  \"replay\": \"%s\",\n", replay_path);
+    }
+    fprintf(file, "  \"results\": [\n");
+    for (int i = 0; i < count; i++) {
+        const ThroughputResult *r = &results[i];
+        fprintf(file, "    {\"algorithm\": \"%s\", \"decisions\": %ld, \"decisions_per_sec\": %.0f, "
+                "\"wall_sec\": %.4f, \"simulated_sec\": %.1f, \"sim_wall_ratio\": %.1f, "
+                "\"memory_bytes\": %zu, \"peak_live_tasks\": %d, \"bytes_per_live_task\": %.1f, "
+                "\"completed\": %d, \"dropped\": %d, \"unfinished\": %d, \"rejected\": %ld, "
+                "\"recharges\": %d}%s\n",
+                r->name, r->decisions, r->decisions / r->wall_sec, r->wall_sec,
+                r->simulated_sec, r->simulated_sec / r->wall_sec, r->memory_bytes, r->peak_live,
+                (double)r->memory_bytes / max(r->peak_live, 1), r->completed, r->dropped,
+                r->unfinished, r->rejected, r->recharges, i + 1 < count ? "," : "");
+    }
+    fprintf(file, "  ]\n");
+    fprintf(file, "}\n");
+
+    fclose(file);
+    return 0;
+}
+
+
+// MAIN
+
+
+int main(int argc, char *argv[]) {
+    const char *json_path = DEFAULT_JSON_PATH;
+    const char *replay_path = NULL;
+    double load = DEFAULT_LOAD;
+    WorkloadConfig workload;
+
+    // Pareto bursts and Poisson arrivals, with bursts of critical tasks on top
+    workload_default_config(&workload);
+    workload.task_count = 1000000;
+    workload.critical_fraction = 0.0;
+    workload.critical_bursts_per_sec = 0.2;
+    workload.seed = 42;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--json=", 7) == 0) {
+            json_path = argv[i] + 7;
+        } else if (strncmp(argv[i], "--tasks=", 8) == 0) {
+            workload.task_count = atol(argv[i] + 8);
+        } else if (strncmp(argv[i], "--load=", 7) == 0) {
+            load = atof(argv[i] + 7);
+        } else if (strncmp(argv[i], "--alpha=", 8) == 0) {
+            workload.pareto_alpha = atof(argv[i] + 8);
+        } else if (strncmp(argv[i], "--critical-rate=", 16) == 0) {
+            workload.critical_bursts_per_sec = atof(argv[i] + 16);
+        } else if (strncmp(argv[i], "--seed=", 7) == 0) {
+            workload.seed = strtoull(argv[i] + 7, NULL, 10);
+        } else if (strncmp(argv[i], "--replay=", 9) == 0) {
+            replay_path = argv[i] + 9;
+        } else {
+            fprintf(stderr, "Usage: %s [--json=FILE] [--tasks=N] [--load=RHO] [--alpha=A] "
+                    "[--critical-rate=PER_SEC] [--seed=S] [--replay=TRACE]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (workload.task_count <= 0 || load <= 0 || workload.pareto_alpha <= 1.0 ||
+        workload.critical_bursts_per_sec < 0) {
+        fprintf(stderr, "Tasks and load must be positive and alpha above 1\n");
+        return EXIT_FAILURE;
+    }
+    workload.mean_interarrival_ms = workload_mean_burst_ms(&workload) / load;
+
+    // Check the trace once up front rather than failing every run
+    WorkloadReplay replay;
+    if (replay_path != NULL) {
+        if (replay_open(&replay, replay_path) != SUCCESS) {
+            fprintf(stderr, "Cannot replay %s\n", replay_path);
+            return EXIT_FAILURE;
+        }
+        replay_close(&replay);
+    }
+
+    // Virtual time: the run loop never sleeps, so wall time is scheduler work
+    set_log_level(LOG_LEVEL_ERROR);
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+
+    printf("\n========================================\n");
+    printf("   SCHEDULER THROUGHPUT BENCHMARK\n");
+    printf("========================================\n");
+    if (replay_path != NULL) {
+        printf("Replaying %s\n\n", replay_path);
+    } else {
+        printf("%ld tasks, load %.2f, Pareto alpha %.2f (%d-%d ms), %.2f critical bursts/s\n\n",
+               workload.task_count, load, workload.pareto_alpha, workload.min_burst_ms,
+               workload.max_burst_ms, workload.critical_bursts_per_sec);
+    }
+    printf("%-17s %9s %12s %9s %9s %10s %9s %7s %10s %8s\n", "Algorithm", "Decisions",
+           "Decisions/s", "Peak live", "B/task", "Sim/wall", "Completed", "Dropped",
+           "Unfinished", "Rejected");
+
+    ThroughputResult results[NUM_ALGORITHMS];
+    for (int i = 0; i < NUM_ALGORITHMS; i++) {
+        results[i] = run_algorithm(i, &workload, replay_path);
+        print_result(&results[i]);
+    }
+
+    if (write_json(json_path, &workload, load, replay_path, results, NUM_ALGORITHMS) != 0) {
+        return EXIT_FAILURE;
+    }
+    printf("\n✓ Results saved to %s\n", json_path);
+    return EXIT_SUCCESS;
+}
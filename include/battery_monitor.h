@@ -13,7 +13,7 @@ typedef struct {
     int voltage;                    // Battery voltage in mV
     int current;                    // Current draw in mA
     int temperature;                // Battery temperature in °C
-    long last_update_time;          // Timestamp of last update
+    int64_t last_update_ns;         // Clock at the last update
     int discharge_rate;             // Rate of discharge in %/hour
 } BatteryInfo;
 
@@ -25,6 +25,17 @@ typedef struct {
     int high_threshold;             // High battery level
 } BatteryThresholds;
 
+// Called when the battery changes state or its level crosses a threshold
+typedef void (*BatteryEventCallback)(SchedContext *ctx, int level, BatteryState state);
+
+// Battery model of one scheduler context
+typedef struct {
+    BatteryInfo info;
+    BatteryThresholds thresholds;
+    BatteryEventCallback callback;  // State/threshold change listener
+    bool initialized;
+} BatteryMonitor;
+
 
 // BATTERY MONITOR FUNCTIONS
 // Initialization and cleanup
@@ -40,6 +51,11 @@ int get_discharge_rate(void);
 // Update battery status
 int update_battery_status(void);
 int simulate_battery_drain(int task_energy_cost);
+int set_battery_state(BatteryState state);
+int set_battery_level(int level);
+
+// Battery events
+void set_battery_event_callback(BatteryEventCallback callback);
 
 // Battery threshold management
 void set_battery_thresholds(BatteryThresholds *thresholds);
@@ -54,4 +70,24 @@ bool is_battery_charging(void);
 void print_battery_status(void);
 int estimate_remaining_time(int current_load);
 
+// Per-context variants (the functions above use the default context)
+int battery_monitor_init_ctx(SchedContext *ctx);
+void battery_monitor_cleanup_ctx(SchedContext *ctx);
+BatteryInfo* get_battery_info_ctx(SchedContext *ctx);
+int get_battery_level_ctx(SchedContext *ctx);
+BatteryState get_battery_state_ctx(SchedContext *ctx);
+int get_discharge_rate_ctx(SchedContext *ctx);
+int update_battery_status_ctx(SchedContext *ctx);
+int simulate_battery_drain_ctx(SchedContext *ctx, int task_energy_cost);
+int set_battery_state_ctx(SchedContext *ctx, BatteryState state);
+int set_battery_level_ctx(SchedContext *ctx, int level);
+void set_battery_event_callback_ctx(SchedContext *ctx, BatteryEventCallback callback);
+void set_battery_thresholds_ctx(SchedContext *ctx, BatteryThresholds *thresholds);
+BatteryThresholds* get_battery_thresholds_ctx(SchedContext *ctx);
+bool is_battery_critical_ctx(SchedContext *ctx);
+bool is_battery_low_ctx(SchedContext *ctx);
+bool is_battery_charging_ctx(SchedContext *ctx);
+void print_battery_status_ctx(SchedContext *ctx);
+int estimate_remaining_time_ctx(SchedContext *ctx, int current_load);
+
 #endif // BATTERY_MONITOR_H
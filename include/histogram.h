@@ -0,0 +1,50 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+// HISTOGRAM STRUCTURES
+
+// Log-linear (HDR-style) histogram of non-negative integer values. Each
+// power of two is split into HIST_SUB_BUCKETS equal buckets, so a recorded
+// value is known to within 1/HIST_SUB_BUCKETS (~3%) of itself; values below
+// HIST_SUB_BUCKETS are exact. Recording is O(1) and never allocates, and two
+// histograms are merged by adding their counts.
+#define HIST_SUB_BUCKET_BITS 5
+#define HIST_SUB_BUCKETS (1 << HIST_SUB_BUCKET_BITS)    // 32 buckets per power of two
+#define HIST_MAX_BITS 44                                // Values up to 2^44 (~4.9 h in ns)
+#define HIST_BUCKETS ((HIST_MAX_BITS - HIST_SUB_BUCKET_BITS + 1) * HIST_SUB_BUCKETS)
+
+typedef struct {
+    uint64_t counts[HIST_BUCKETS];  // Values recorded per bucket
+    uint64_t total;                 // Values recorded
+    int64_t sum;                    // Exact sum of recorded values (for the mean)
+    int64_t min;                    // Smallest value recorded (INT64_MAX if none)
+    int64_t max;                    // Largest value recorded (0 if none)
+} Histogram;
+
+
+// HISTOGRAM FUNCTIONS
+
+// Initialization
+void histogram_init(Histogram *hist);
+
+// Record one value; negatives count as 0 and values past the range land in
+// the last bucket (max still holds the exact value)
+void histogram_record(Histogram *hist, int64_t value);
+
+// Add every value of src to dst
+void histogram_merge(Histogram *dst, const Histogram *src);
+
+// Value at or below which `percentile` percent of the values fall (0 if
+// empty); reported as the upper bound of its bucket, kept within [min, max]
+int64_t histogram_percentile(const Histogram *hist, double percentile);
+double histogram_mean(const Histogram *hist);
+
+// Tabulate p50/p90/p99/p99.9/max of histograms of nanosecond values,
+// printed in units of unit_ns nanoseconds (e.g. 1e6 for ms)
+void histogram_print_header(FILE *out, const char *title);
+void histogram_print_row(FILE *out, const char *label, const Histogram *hist, double unit_ns);
+
+#endif // HISTOGRAM_H
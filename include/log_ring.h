@@ -0,0 +1,51 @@
+#ifndef LOG_RING_H
+#define LOG_RING_H
+
+#include <stdbool.h>
+#include <stdarg.h>
+#include "utils.h"
+
+// LOG RING STRUCTURES
+
+// Bounded multi-producer, single-consumer queue of log entries. Producers
+// claim a slot with one atomic compare-and-swap and copy the format pointer
+// and raw argument values into it (%s strings are copied, since they may not
+// outlive the call); a background writer thread formats, timestamps, batches
+// and writes the entries with one write() per batch and output. The format
+// must stay valid until the entry is written; the LOG_* macros pass literals.
+#define LOG_RING_CAPACITY 4096          // Entries (power of two)
+#define LOG_MAX_ARGS 16                 // Argument words per entry (a '*' takes one)
+#define LOG_BATCH_BYTES 65536           // Output buffered per write()
+#define LOG_WRITER_PERIOD_MS 10         // Longest a writer sleeps before draining
+
+
+// Outcome of log_ring_push()
+typedef enum {
+    LOG_PUSH_QUEUED,                // Entry will be written by the writer thread
+    LOG_PUSH_DROPPED,               // Ring full; entry counted as dropped
+    LOG_PUSH_STOPPED                // Ring not running; arguments left unread
+} LogPushResult;
+
+
+// LOG RING FUNCTIONS
+
+// Start the writer thread; entries go to each fd that is not -1
+int log_ring_start(int console_fd, int file_fd);
+
+// Drain every queued entry, then stop the writer thread once no push or
+// flush that saw the ring running is still in progress
+void log_ring_stop(void);
+bool log_ring_active(void);
+
+// Queue an entry at a LOG_LEVEL_* level. When the ring is full, ERROR
+// entries wait for space and other entries are dropped. If the ring is not
+// running the caller must write the entry itself.
+LogPushResult log_ring_push(int level, const char *format, va_list args);
+
+// Block until every entry queued so far has been written
+void log_ring_flush(void);
+
+// Entries dropped because the ring was full
+long log_ring_dropped(void);
+
+#endif // LOG_RING_H
@@ -0,0 +1,52 @@
+#ifndef MONTECARLO_H
+#define MONTECARLO_H
+
+#include <stdbool.h>
+
+// MONTE CARLO STRUCTURES
+
+// Replicas run per algorithm before the first separation check, and per
+// round after it (rounds are fixed so results do not depend on threads)
+#define MC_ROUND_REPLICAS 5
+
+// Metrics aggregated over replicas
+typedef enum {
+    MC_ENERGY,                      // Energy consumed (units)
+    MC_COMPLETED,                   // Tasks completed
+    MC_MISSED,                      // Deadline misses
+    MC_BATTERY,                     // Final battery level (%)
+    NUM_MC_METRICS
+} McMetric;
+
+// Running mean and variance of one metric (Welford's method)
+typedef struct {
+    long count;
+    double mean;
+    double m2;                      // Sum of squared deviations from the mean
+} RunningStat;
+
+// Mean with a confidence interval
+typedef struct {
+    double mean;
+    double half_width;              // Interval is mean +/- half_width
+} Interval;
+
+
+// MONTE CARLO FUNCTIONS
+
+// Running statistics
+void running_stat_init(RunningStat *stat);
+void running_stat_add(RunningStat *stat, double value);
+double running_stat_stddev(const RunningStat *stat);     // Sample standard deviation
+
+// 95% confidence interval of the mean (Student's t; infinite with < 2 values)
+Interval running_stat_ci95(const RunningStat *stat);
+
+// Two-sided 97.5% quantile of Student's t with `df` degrees of freedom
+double student_t_975(long df);
+
+// Index of the lowest mean among `count` stats whose 95% interval is clear of
+// every other one, or -1 while the intervals still overlap
+int mc_separated_minimum(const RunningStat *stats, int count);
+
+#endif // MONTECARLO_H
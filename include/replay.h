@@ -0,0 +1,84 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "workload.h"
+#include <stdio.h>
+
+// WORKLOAD FILE FORMATS
+
+// Task arrival traces come in two formats:
+//
+// CSV, one task per line in arrival order:
+//     arrival_ms,name,priority,energy,burst_ms,critical,deadline_ms
+// Blank lines, lines starting with '#' and a header line are skipped;
+// names cannot contain commas.
+//
+// Binary: a WorkloadFileHeader followed by `count` fixed-size
+// WorkloadRecords, in arrival order. The replayer maps the file and reads
+// records in place, so nothing is parsed and nothing is loaded up front.
+#define WORKLOAD_FILE_MAGIC "BATTASKS"
+#define WORKLOAD_FILE_VERSION 1
+#define WORKLOAD_RECORD_NAME 20         // Bytes of name kept per record
+
+#define WORKLOAD_CSV_HEADER "arrival_ms,name,priority,energy,burst_ms,critical,deadline_ms"
+
+// One task (40 bytes)
+typedef struct {
+    int64_t arrival_ms;             // Arrival time, from the start of the trace
+    int32_t burst_time;             // Execution time (ms)
+    int32_t deadline;               // Relative deadline (ms, 0 = none)
+    uint8_t priority;               // PRIORITY_HIGH .. PRIORITY_LOW
+    uint8_t energy_cost;            // ENERGY_LOW .. ENERGY_HIGH
+    uint8_t is_critical;            // 1 = critical
+    uint8_t reserved;
+    char name[WORKLOAD_RECORD_NAME];    // NUL-padded, not always NUL-terminated
+} WorkloadRecord;
+
+// File header (32 bytes)
+typedef struct {
+    char magic[8];                  // WORKLOAD_FILE_MAGIC, not NUL-terminated
+    uint32_t version;               // WORKLOAD_FILE_VERSION
+    uint32_t record_size;           // sizeof(WorkloadRecord)
+    uint64_t count;                 // Records in the file
+    uint64_t reserved;
+} WorkloadFileHeader;
+
+
+// REPLAY STRUCTURES
+
+// Open workload trace being replayed (a TaskSpecSource)
+typedef struct {
+    FILE *csv;                      // CSV input (NULL for binary)
+    long line;                      // CSV line number, for error messages
+    const WorkloadRecord *records;  // Mapped binary records (NULL for CSV)
+    uint64_t count;                 // Binary records in the file
+    uint64_t next;                  // Next binary record
+    void *map;                      // Whole mapping
+    size_t map_size;
+    int64_t last_arrival_ms;        // Arrival of the previous task
+    long tasks;                     // Tasks read so far
+    long errors;                    // Malformed CSV lines skipped
+    long reordered;                 // Tasks listed before an earlier one (moved up)
+} WorkloadReplay;
+
+// Sequential writer for either format
+typedef struct {
+    FILE *file;
+    bool binary;
+    uint64_t count;                 // Tasks written
+} WorkloadWriter;
+
+
+// REPLAY FUNCTIONS
+
+// Open a trace for replay; the format is detected from the file contents
+int replay_open(WorkloadReplay *replay, const char *path);
+bool replay_next(void *replay, TaskSpec *spec);
+void replay_close(WorkloadReplay *replay);
+
+// Write a trace; binary unless the path ends in ".csv"
+int workload_writer_open(WorkloadWriter *writer, const char *path);
+int workload_writer_write(WorkloadWriter *writer, const TaskSpec *spec);
+int workload_writer_close(WorkloadWriter *writer);
+
+#endif // REPLAY_H
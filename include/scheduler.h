@@ -5,6 +5,7 @@
 #include "utils.h"
 #include "battery_monitor.h"
 #include "task_manager.h"
+#include <pthread.h>
 
 
 // SCHEDULER STRUCTURES
@@ -15,7 +16,10 @@ typedef enum {
     SCHEDULER_SJF,                  // Shortest Job First
     SCHEDULER_PRIORITY,             // Priority-based scheduling
     SCHEDULER_ROUND_ROBIN,          // Round Robin
-    SCHEDULER_BATTERY_AWARE         // Battery-aware custom scheduling
+    SCHEDULER_BATTERY_AWARE,        // Battery-aware custom scheduling
+    SCHEDULER_EDF,                  // Earliest Deadline First
+    SCHEDULER_ENERGY_EDF,           // EDF that sheds hopeless/unaffordable tasks
+    SCHEDULER_CFS                   // Completely fair, energy-weighted vruntime
 } SchedulerAlgorithm;
 
 // Scheduler mode based on battery level
@@ -26,6 +30,71 @@ typedef enum {
     MODE_CRITICAL                   // Critical battery: minimal essential tasks
 } SchedulerMode;
 
+// Battery-aware run queue: one FIFO list per (critical, priority, energy)
+// bucket plus, for each mode, a bitmap of non-empty buckets laid out in
+// that mode's search order, so picking a task is one find-first-set
+#define RUNQUEUE_BUCKETS 18         // 2 criticality x 3 priorities x 3 energy levels
+#define RUNQUEUE_MODES 4            // One search order per SchedulerMode
+
+typedef struct {
+    Task *head;                     // Oldest task in bucket
+    Task *tail;                     // Newest task in bucket
+} TaskList;
+
+typedef struct {
+    TaskList buckets[RUNQUEUE_BUCKETS];         // FIFO per bucket
+    unsigned int mode_bitmap[RUNQUEUE_MODES];   // Bit r set: mode's r-th bucket non-empty
+    int count;                                  // Tasks across all buckets
+} BatteryRunQueue;
+
+// Idle time after which scheduler_run_loop() returns
+#define SCHEDULER_IDLE_TIMEOUT_MS 1000
+
+// Events that wake an idle run loop
+typedef enum {
+    SCHED_EVENT_TASK_READY = 1 << 0,        // Task admitted or resumed
+    SCHED_EVENT_BATTERY = 1 << 1,           // Battery state or threshold change
+    SCHED_EVENT_STOP = 1 << 2               // scheduler_stop() called
+} SchedulerEvent;
+
+// Workload hooks for simulations that feed the run loop. The arrival source
+// is polled at the top of every iteration: it admits the tasks that have
+// arrived by now_ms and returns when the next one is due (-1 = no more).
+// The done hook sees every task that completes or is dropped, after the
+// scheduler has released it, so it may remove the task.
+typedef long (*ArrivalSource)(long now_ms, void *context);
+typedef void (*TaskDoneHook)(Task *task, void *context);
+
+// Run-loop phase timing; built in with make PROFILE=1, otherwise the timing
+// calls compile to nothing
+#ifndef SCHED_PROFILE
+#define SCHED_PROFILE 0
+#endif
+
+// Phases of one scheduler_run_loop() iteration
+typedef enum {
+    SCHED_PHASE_BATTERY,            // update_battery_status()
+    SCHED_PHASE_MODE,               // adjust_scheduler_for_battery()
+    SCHED_PHASE_SELECT,             // select_next_task(), including the dequeue
+    SCHED_PHASE_SWITCH,             // perform_context_switch()
+    SCHED_PHASE_EXECUTE,            // schedule_task() and execute_task()
+    SCHED_PHASE_REQUEUE,            // preempt_task() re-enqueue
+    SCHED_PHASE_DECISION,           // Every phase but EXECUTE, per dispatch
+    NUM_SCHED_PHASES
+} SchedulerPhase;
+
+// Resolution of the aging timer wheel (ms per tick)
+#define AGING_TICK_MS 10
+
+// CFS: every ready task runs once per target latency, in slices of at
+// least min_granularity; vruntime advances by runtime * energy / weight
+#define CFS_TARGET_LATENCY_MS 800
+#define CFS_VRUNTIME_SCALE 1000     // vruntime units per weighted ms
+
+// Configuration defaults
+#define DEFAULT_TIME_QUANTUM_MS 100
+#define DEFAULT_AGING_THRESHOLD_MS 5000
+
 // Scheduler configuration
 typedef struct {
     SchedulerAlgorithm algorithm;   // Current scheduling algorithm
@@ -34,13 +103,21 @@ typedef struct {
     bool enable_preemption;         // Allow task preemption
     bool enable_aging;              // Prevent starvation with aging
     int aging_threshold;            // Time before priority boost (ms)
+    int min_granularity;            // Shortest CFS slice (ms)
 } SchedulerConfig;
 
 // Scheduler state
 typedef struct {
     Task *current_task;             // Currently executing task
-    TaskQueue *ready_queue;         // Queue of ready tasks
+    TaskQueue *ready_queue;         // FIFO ready queue (FCFS, Round Robin)
+    TaskHeap *ready_heap;           // Keyed ready queue (SJF, Priority)
+    BatteryRunQueue runqueue;       // Bucketed run queue (Battery-aware)
     TaskQueue *waiting_queue;       // Queue of waiting/suspended tasks
+    TaskQueue *deferred_queue;      // Tasks energy-aware EDF cannot afford yet
+    int deferred_min_energy;        // Cheapest deferred task's energy estimate (%)
+    long deferred_expiry_ms;        // When the first deferred task misses its deadline
+    TimerWheel aging_wheel;         // Aging timers of ready tasks, by enqueue time
+    long min_vruntime;              // CFS floor for newly queued tasks
     SchedulerConfig config;         // Scheduler configuration
     SchedulerMode mode;             // Current operating mode
     long total_runtime;             // Total scheduler runtime (ms)
@@ -57,11 +134,53 @@ typedef struct {
     double cpu_utilization;         // CPU utilization percentage
     double battery_saved;           // Estimated battery saved (%)
     long total_energy_consumed;     // Total energy consumed
+    int aging_promotions;           // Priority boosts given to waiting tasks
+    int tasks_dropped;              // Tasks dropped for an unmeetable deadline
+    int idle_wakeups;               // Times the idle loop woke up
+    long dispatches;                // Scheduling decisions (tasks dispatched)
+    Histogram phase_ns[NUM_SCHED_PHASES];  // Time per run-loop phase (SCHED_PROFILE only)
 } SchedulerStats;
 
+// One scheduler instance: its clock, battery model, task pool, scheduler
+// state and statistics. Contexts share nothing but the log and the trace,
+// so each can run its own simulation on its own thread. The API without
+// the _ctx suffix works on the default context, which uses the global
+// clock and is the only one that records to the trace.
+struct SchedContext {
+    SimClock *clock;                // Clock every timestamp comes from
+    SimClock own_clock;             // Backs clock for contexts from sched_context_create()
+    BatteryMonitor battery;
+    TaskManager tasks;
+    SchedulerState state;
+    SchedulerStats stats;
+    bool initialized;
+    
+    // Run loop wakeup state; the mutex is held by the loop except while it
+    // waits for an event or for a wall-clock execution slice to pass
+    pthread_mutex_t mutex;
+    pthread_cond_t event_cond;
+    unsigned int pending_events;
+    bool in_run_loop;               // The run loop holds the mutex
+    
+    // Workload hooks
+    ArrivalSource arrival_source;
+    void *arrival_context;
+    TaskDoneHook task_done_hook;
+    void *task_done_context;
+    
+    int64_t phase_mark;             // Monotonic clock at the end of the last phase (SCHED_PROFILE)
+    int64_t decision_ns;            // Non-execute time in the current iteration (SCHED_PROFILE)
+};
+
 
 // SCHEDULER FUNCTIONS
 
+// Scheduler contexts: a new context has its own clock in the given mode
+// (virtual time starts at the same instant in every context)
+SchedContext* sched_default_context(void);
+SchedContext* sched_context_create(ClockMode mode);
+void sched_context_destroy(SchedContext *ctx);
+
 // Initialization and cleanup
 int scheduler_init(SchedulerAlgorithm algorithm);
 void scheduler_cleanup(void);
@@ -72,6 +191,16 @@ int scheduler_stop(void);
 int scheduler_pause(void);
 int scheduler_resume(void);
 
+// Run loop wakeups and locking; threads other than the one in
+// scheduler_run_loop() must hold scheduler_lock() around scheduler calls
+void scheduler_notify(SchedulerEvent event);
+void scheduler_lock(void);
+void scheduler_unlock(void);
+
+// Workload hooks (NULL to remove); cleared by scheduler_cleanup()
+void set_arrival_source(ArrivalSource source, void *context);
+void set_task_done_hook(TaskDoneHook hook, void *context);
+
 // Configuration management
 int set_scheduler_algorithm(SchedulerAlgorithm algorithm);
 int set_scheduler_mode(SchedulerMode mode);
@@ -102,6 +231,9 @@ Task* schedule_sjf(void);
 Task* schedule_priority(void);
 Task* schedule_round_robin(void);
 Task* schedule_battery_aware(void);
+Task* schedule_edf(void);
+Task* schedule_energy_edf(void);
+Task* schedule_cfs(void);
 
 // Context switching
 int perform_context_switch(Task *old_task, Task *new_task);
@@ -111,12 +243,61 @@ void scheduler_run_loop(void);
 
 // Statistics and monitoring
 SchedulerStats* get_scheduler_statistics(void);
+size_t get_scheduler_memory_usage(void);
 void update_scheduler_statistics(void);
 void print_scheduler_status(void);
 void print_scheduler_statistics(void);
+void print_phase_timings(FILE *out);
 
 // Debug and logging
 void log_scheduling_decision(Task *task, const char *reason);
 void print_ready_queue(void);
 
+// Per-context variants (the functions above use the default context)
+int scheduler_init_ctx(SchedContext *ctx, SchedulerAlgorithm algorithm);
+void scheduler_cleanup_ctx(SchedContext *ctx);
+int scheduler_start_ctx(SchedContext *ctx);
+int scheduler_stop_ctx(SchedContext *ctx);
+int scheduler_pause_ctx(SchedContext *ctx);
+int scheduler_resume_ctx(SchedContext *ctx);
+void scheduler_notify_ctx(SchedContext *ctx, SchedulerEvent event);
+void scheduler_lock_ctx(SchedContext *ctx);
+void scheduler_unlock_ctx(SchedContext *ctx);
+void set_arrival_source_ctx(SchedContext *ctx, ArrivalSource source, void *context);
+void set_task_done_hook_ctx(SchedContext *ctx, TaskDoneHook hook, void *context);
+int set_scheduler_algorithm_ctx(SchedContext *ctx, SchedulerAlgorithm algorithm);
+int set_scheduler_mode_ctx(SchedContext *ctx, SchedulerMode mode);
+int set_time_quantum_ctx(SchedContext *ctx, int quantum_ms);
+SchedulerConfig* get_scheduler_config_ctx(SchedContext *ctx);
+void configure_scheduler_ctx(SchedContext *ctx, SchedulerConfig *config);
+Task* select_next_task_ctx(SchedContext *ctx);
+int schedule_task_ctx(SchedContext *ctx, Task *task);
+int execute_task_ctx(SchedContext *ctx, Task *task);
+int preempt_task_ctx(SchedContext *ctx, Task *task);
+int suspend_task_ctx(SchedContext *ctx, Task *task);
+int resume_task_ctx(SchedContext *ctx, Task *task);
+void scheduler_release_task_ctx(SchedContext *ctx, Task *task);
+int adjust_scheduler_for_battery_ctx(SchedContext *ctx);
+SchedulerMode determine_scheduler_mode_ctx(SchedContext *ctx, int battery_level);
+int apply_power_saving_policies_ctx(SchedContext *ctx);
+bool can_admit_task_ctx(SchedContext *ctx, Task *task);
+int admit_task_to_scheduler_ctx(SchedContext *ctx, Task *task);
+Task* schedule_fcfs_ctx(SchedContext *ctx);
+Task* schedule_sjf_ctx(SchedContext *ctx);
+Task* schedule_priority_ctx(SchedContext *ctx);
+Task* schedule_round_robin_ctx(SchedContext *ctx);
+Task* schedule_battery_aware_ctx(SchedContext *ctx);
+Task* schedule_edf_ctx(SchedContext *ctx);
+Task* schedule_energy_edf_ctx(SchedContext *ctx);
+Task* schedule_cfs_ctx(SchedContext *ctx);
+int perform_context_switch_ctx(SchedContext *ctx, Task *old_task, Task *new_task);
+void scheduler_run_loop_ctx(SchedContext *ctx);
+SchedulerStats* get_scheduler_statistics_ctx(SchedContext *ctx);
+size_t get_scheduler_memory_usage_ctx(SchedContext *ctx);
+void update_scheduler_statistics_ctx(SchedContext *ctx);
+void print_scheduler_status_ctx(SchedContext *ctx);
+void print_scheduler_statistics_ctx(SchedContext *ctx);
+void print_phase_timings_ctx(SchedContext *ctx, FILE *out);
+void print_ready_queue_ctx(SchedContext *ctx);
+
 #endif // SCHEDULER_H
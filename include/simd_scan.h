@@ -0,0 +1,53 @@
+#ifndef SIMD_SCAN_H
+#define SIMD_SCAN_H
+
+#include <stdint.h>
+
+// SIMD SCAN STRUCTURES
+
+// Scan kernel implementations (AUTO picks the best one the CPU supports)
+typedef enum {
+    SCAN_KERNEL_AUTO,
+    SCAN_KERNEL_SCALAR,
+    SCAN_KERNEL_SSE41,
+    SCAN_KERNEL_AVX2
+} ScanKernel;
+
+// Packed scheduling keys for a block of tasks (struct-of-arrays)
+typedef struct {
+    const int32_t *priority;        // Task priority (1=high, 3=low)
+    const int32_t *energy_cost;     // Energy consumption level (1-3)
+    const int32_t *remaining_time;  // Remaining execution time (ms)
+    const int32_t *deadline;        // Relative deadline (ms)
+    const int32_t *is_critical;     // 1 if critical, else 0
+    const int32_t *state;           // TaskState, or -1 for an unused slot
+    int count;                      // Number of entries in each array
+} TaskKeyBlock;
+
+// Linear selection score: sum of weight * key, lowest score wins.
+// non_critical adds its weight for every task that is not critical.
+typedef struct {
+    int32_t priority;
+    int32_t energy_cost;
+    int32_t remaining_time;
+    int32_t deadline;
+    int32_t non_critical;
+} TaskScanWeights;
+
+
+// SIMD SCAN FUNCTIONS
+
+// Kernel selection
+void set_scan_kernel(ScanKernel kernel);
+ScanKernel get_scan_kernel(void);
+const char* scan_kernel_name(ScanKernel kernel);
+
+// Index of the lowest-score entry whose state matches (-1 if none);
+// ties go to the lowest index
+int scan_min_score(const TaskKeyBlock *block, int32_t state,
+                   const TaskScanWeights *weights, int32_t *best_score);
+
+// Number of live entries whose value matches
+int scan_count_equal(const TaskKeyBlock *block, const int32_t *values, int32_t value);
+
+#endif // SIMD_SCAN_H
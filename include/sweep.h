@@ -0,0 +1,76 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "scheduler.h"
+
+// SWEEP SPECIFICATION
+
+// A sweep runs one workload under many scheduler configurations. The spec
+// lists values per parameter, separated by ';' or spaces:
+//
+//     "algorithm=battery,cfs; critical=5:15:5; low=20,30; quantum=50:200:50"
+//
+// A value is a number, a range lo:hi (every integer) or lo:hi:step, or for
+// `algorithm` a name (fcfs, sjf, priority, rr, battery, edf, eedf, cfs).
+// Parameters left out keep their defaults. The sweep is the full grid of
+// combinations, or with "samples=N" (and optionally "seed=S") N random
+// combinations. Combinations whose battery thresholds are not strictly
+// increasing (critical < low < medium < high) are skipped.
+typedef enum {
+    SWEEP_ALGORITHM,                // SchedulerAlgorithm
+    SWEEP_CRITICAL,                 // Battery thresholds (%)
+    SWEEP_LOW,
+    SWEEP_MEDIUM,
+    SWEEP_HIGH,
+    SWEEP_QUANTUM,                  // time_quantum (ms)
+    SWEEP_AGING,                    // aging_threshold (ms)
+    SWEEP_PREEMPTION,               // enable_preemption (0 or 1)
+    NUM_SWEEP_PARAMS
+} SweepParam;
+
+#define SWEEP_MAX_VALUES 1024           // Values per parameter
+#define SWEEP_MAX_POINTS 1000000L       // Configurations per sweep
+
+// Parsed spec: the values each parameter takes
+typedef struct {
+    int values[NUM_SWEEP_PARAMS][SWEEP_MAX_VALUES];
+    int counts[NUM_SWEEP_PARAMS];
+    long samples;                   // Random combinations (0 = full grid)
+    uint64_t seed;                  // Random sample seed
+} SweepSpec;
+
+// One configuration and the results of running the workload under it
+typedef struct {
+    int params[NUM_SWEEP_PARAMS];   // Indexed by SweepParam
+    long energy_consumed;
+    int tasks_completed;
+    int missed_deadlines;
+    int context_switches;
+    int final_battery;
+    int tasks_dropped;
+} SweepPoint;
+
+
+// SWEEP FUNCTIONS
+
+// Parse a spec; parameters it leaves out get their default value
+int sweep_parse(SweepSpec *spec, const char *text);
+
+// The configurations of a sweep (free() the array), or NULL on error
+SweepPoint* sweep_expand(const SweepSpec *spec, long *count);
+
+// Configure a context initialized with scheduler_init_ctx(ctx,
+// point->params[SWEEP_ALGORITHM]) before its tasks are admitted
+void sweep_apply(SchedContext *ctx, const SweepPoint *point);
+
+// Copy a finished run's results into its point
+void sweep_record(SchedContext *ctx, SweepPoint *point);
+
+// Write the results table: JSON if the path ends in ".json", else CSV
+int sweep_write(const char *path, const SweepPoint *points, long count);
+
+// Names used in specs and results
+const char* sweep_param_name(SweepParam param);
+const char* sweep_algorithm_name(SchedulerAlgorithm algorithm);
+
+#endif // SWEEP_H
@@ -3,44 +3,128 @@
 #define TASK_MANAGER_H
 
 #include "utils.h"
+#include "simd_scan.h"
+#include "timer_wheel.h"
+#include "histogram.h"
 
 // TASK STRUCTURES
 // Task structure
-typedef struct {
+typedef struct Task {
     int task_id;                    // Unique task identifier
     char task_name[MAX_TASK_NAME];  // Task name/description
     int priority;                   // Task priority (1=high, 2=med, 3=low)
+    int base_priority;              // Priority before any aging boost
     int energy_cost;                // Energy consumption level (1-3)
     int burst_time;                 // CPU burst time in ms
     int remaining_time;             // Remaining execution time in ms
-    int arrival_time;               // Time when task arrived
-    int start_time;                 // Time when task started execution
-    int completion_time;            // Time when task completed
-    int waiting_time;               // Time spent waiting
-    int turnaround_time;            // Total time from arrival to completion
+    int64_t arrival_time_ns;        // Clock when task arrived
+    int64_t start_time_ns;          // Clock when task first ran (0 = never)
+    int64_t completion_time_ns;     // Clock when task completed (0 = not yet)
+    int64_t waiting_time_ns;        // Time spent waiting
+    int64_t turnaround_time_ns;     // Total time from arrival to completion
     TaskState state;                // Current task state
     bool is_critical;               // Is this a critical/urgent task?
     int deadline;                   // Deadline for task completion (ms)
+    int queue_index;                // Heap position, run-queue bucket or 0 in the
+                                    // FIFO ready queue (-1 = not ready-queued)
+    unsigned long queue_seq;        // Enqueue order, breaks key ties FIFO
+    struct Task *queue_prev;        // Links within a run-queue bucket list
+    struct Task *queue_next;
+    TimerEntry aging_timer;         // Fires when the task has waited too long
+    long vruntime;                  // Energy/priority-weighted runtime (CFS)
 } Task;
 
+// Generation-checked reference to a pooled task; goes stale once the
+// task is removed, even if its slot is reused
+typedef struct {
+    int slot;                       // Pool slot index
+    unsigned int generation;        // Slot generation when the handle was taken
+} TaskHandle;
+
 // Task queue structure
 typedef struct {
-    Task tasks[MAX_TASKS];          // Array of tasks
+    Task **tasks;                   // Ring of handles into the task manager's pool
+    int capacity;                   // Allocated ring size (grows on demand)
     int count;                      // Number of tasks in queue
     int front;                      // Front of queue index
     int rear;                       // Rear of queue index
 } TaskQueue;
 
+// Ordering for keyed queues: negative if a should run before b
+typedef int (*TaskCompareFn)(const Task *a, const Task *b);
+
+// Keyed ready queue (binary min-heap of task handles)
+typedef struct {
+    Task **tasks;                   // Heap array of handles into the task pool
+    int capacity;                   // Allocated size (grows on demand)
+    int count;                      // Number of tasks in heap
+    TaskCompareFn compare;          // Ordering key
+    unsigned long next_seq;         // Sequence number for the next push
+} TaskHeap;
+
+// Latency metrics recorded for every completed task (nanoseconds)
+typedef enum {
+    LATENCY_WAITING,                // Turnaround minus burst time
+    LATENCY_RESPONSE,               // Arrival to first dispatch
+    LATENCY_TURNAROUND,             // Arrival to completion
+    NUM_LATENCY_METRICS
+} LatencyMetric;
+
+#define NUM_PRIORITY_CLASSES 3
+#define NUM_ENERGY_CLASSES 3
+
+// Latency histograms, overall and per task class
+typedef struct {
+    Histogram all[NUM_LATENCY_METRICS];
+    Histogram critical[NUM_LATENCY_METRICS];
+    Histogram by_priority[NUM_PRIORITY_CLASSES][NUM_LATENCY_METRICS];  // By base priority - 1
+    Histogram by_energy[NUM_ENERGY_CLASSES][NUM_LATENCY_METRICS];      // By energy cost - 1
+} LatencyStats;
+
 // Task statistics structure
 typedef struct {
     int total_tasks;                // Total number of tasks processed
     int completed_tasks;            // Number of completed tasks
     int suspended_tasks;            // Number of suspended tasks
-    double avg_waiting_time;        // Average waiting time
-    double avg_turnaround_time;     // Average turnaround time
+    double avg_waiting_time;        // Average waiting time (ms)
+    double avg_turnaround_time;     // Average turnaround time (ms)
     int missed_deadlines;           // Number of missed deadlines
+    LatencyStats latency;           // Latency distributions of completed tasks
 } TaskStats;
 
+// Chunked task pool (chunks are private to task_manager.c)
+struct TaskChunk;
+
+typedef struct {
+    struct TaskChunk **chunks;      // Chunk pointers (only this array is resized)
+    int chunk_count;                // Number of allocated chunks
+    int chunk_capacity;             // Length of the chunks array
+    int slot_count;                 // Slots ever handed out (high-water mark)
+    int free_head;                  // First free slot index (-1 = none)
+} TaskPool;
+
+// Open-addressing index from task ID to pool slot
+typedef struct {
+    int task_id;                    // Key (0 = empty)
+    int slot;                       // Pool slot holding the task
+} TaskIndexEntry;
+
+typedef struct {
+    TaskIndexEntry *entries;        // Bucket array (power-of-two length)
+    unsigned int mask;              // capacity - 1
+    int count;                      // Occupied buckets
+} TaskIndex;
+
+// Task manager of one scheduler context
+typedef struct {
+    TaskPool pool;
+    TaskIndex index;
+    int task_count;                 // Live tasks
+    int next_task_id;
+    TaskStats stats;
+    bool initialized;
+} TaskManager;
+
 // ============================================
 // TASK MANAGER FUNCTIONS
 // ============================================
@@ -55,16 +139,35 @@ Task* create_task(const char *name, int priority, int energy_cost,
 int add_task(Task *task);
 int remove_task(int task_id);
 Task* get_task(int task_id);
+int get_task_count(void);
+size_t get_task_memory_usage(void);
+void update_task_keys(Task *task);
+Task* scan_best_task(TaskState state, const TaskScanWeights *weights);
+TaskHandle get_task_handle(Task *task);
+Task* resolve_task_handle(TaskHandle handle);
 
 // Task queue operations
 TaskQueue* create_task_queue(void);
 void destroy_task_queue(TaskQueue *queue);
 int enqueue_task(TaskQueue *queue, Task *task);
 Task* dequeue_task(TaskQueue *queue);
+int remove_queued_task(TaskQueue *queue, Task *task);
 bool is_queue_empty(TaskQueue *queue);
 bool is_queue_full(TaskQueue *queue);
 int get_queue_size(TaskQueue *queue);
 
+// Keyed ready queue operations (O(log n) push/pop/remove/update)
+TaskHeap* create_task_heap(TaskCompareFn compare);
+void destroy_task_heap(TaskHeap *heap);
+void set_heap_order(TaskHeap *heap, TaskCompareFn compare);
+int heap_push_task(TaskHeap *heap, Task *task);
+Task* heap_pop_task(TaskHeap *heap);
+Task* heap_peek_task(TaskHeap *heap);
+int heap_remove_task(TaskHeap *heap, Task *task);
+int heap_update_task(TaskHeap *heap, Task *task);
+bool is_heap_empty(TaskHeap *heap);
+int get_heap_size(TaskHeap *heap);
+
 // Task state management
 int set_task_state(Task *task, TaskState state);
 TaskState get_task_state(Task *task);
@@ -82,9 +185,37 @@ TaskStats* get_task_statistics(void);
 void update_task_statistics(Task *task);
 void print_task_statistics(void);
 
+// Latency histograms (mergeable across runs)
+void reset_latency_stats(LatencyStats *latency);
+void merge_latency_stats(LatencyStats *dst, const LatencyStats *src);
+void print_latency_stats(FILE *out, const LatencyStats *latency);
+
 // Task display
 void print_task(Task *task);
 void print_all_tasks(void);
 void print_task_queue(TaskQueue *queue);
+void print_task_heap(TaskHeap *heap);
+
+// Per-context variants (the functions above use the default context)
+int task_manager_init_ctx(SchedContext *ctx);
+void task_manager_cleanup_ctx(SchedContext *ctx);
+Task* create_task_ctx(SchedContext *ctx, const char *name, int priority, int energy_cost,
+                      int burst_time, bool is_critical, int deadline);
+int add_task_ctx(SchedContext *ctx, Task *task);
+int remove_task_ctx(SchedContext *ctx, int task_id);
+Task* get_task_ctx(SchedContext *ctx, int task_id);
+int get_task_count_ctx(SchedContext *ctx);
+size_t get_task_memory_usage_ctx(SchedContext *ctx);
+void update_task_keys_ctx(SchedContext *ctx, Task *task);
+Task* scan_best_task_ctx(SchedContext *ctx, TaskState state, const TaskScanWeights *weights);
+Task* resolve_task_handle_ctx(SchedContext *ctx, TaskHandle handle);
+int set_task_state_ctx(SchedContext *ctx, Task *task, TaskState state);
+Task** get_tasks_by_priority_ctx(SchedContext *ctx, int priority, int *count);
+Task** get_tasks_by_state_ctx(SchedContext *ctx, TaskState state, int *count);
+Task** get_critical_tasks_ctx(SchedContext *ctx, int *count);
+TaskStats* get_task_statistics_ctx(SchedContext *ctx);
+void update_task_statistics_ctx(SchedContext *ctx, Task *task);
+void print_task_statistics_ctx(SchedContext *ctx);
+void print_all_tasks_ctx(SchedContext *ctx);
 
 #endif // TASK_MANAGER_H
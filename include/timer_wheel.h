@@ -0,0 +1,59 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// TIMER WHEEL STRUCTURES
+
+// Hierarchical timing wheel: level L has TIMER_WHEEL_SLOTS slots, each
+// spanning TIMER_WHEEL_SLOTS^L ticks. Timers are bucketed by expiry tick;
+// when level 0 wraps, the next slot of level 1 is cascaded down (and so
+// on), so each timer is touched at most once per level.
+#define TIMER_WHEEL_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)       // 64 slots per level
+#define TIMER_WHEEL_LEVELS 4                            // Covers 64^4 ticks
+
+// Timer embedded in the object it belongs to (no allocation per timer)
+typedef struct TimerEntry {
+    struct TimerEntry *prev;        // Links within a wheel slot (NULL = not armed)
+    struct TimerEntry *next;
+    long expires_tick;              // Tick at which the timer fires
+    int level;                      // Wheel level holding the timer
+    int slot;                       // Slot within that level
+    void *data;                     // Owner, passed back to the callback
+} TimerEntry;
+
+// Called once for every expired timer; the timer is disarmed first, so the
+// callback may re-arm it
+typedef void (*TimerCallback)(TimerEntry *entry, void *context);
+
+typedef struct {
+    TimerEntry slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];   // Slot list heads
+    uint64_t occupied[TIMER_WHEEL_LEVELS];                     // Bit s set: slot s non-empty
+    long tick_ms;                   // Tick length (ms)
+    long current_tick;              // Next tick to process
+    int count;                      // Armed timers
+} TimerWheel;
+
+
+// TIMER WHEEL FUNCTIONS
+
+// Initialization
+void timer_wheel_init(TimerWheel *wheel, long tick_ms, long now_ms);
+void timer_entry_init(TimerEntry *entry);
+
+// Arming and cancelling (O(1))
+void timer_wheel_add(TimerWheel *wheel, TimerEntry *entry, long expires_ms, void *data);
+void timer_wheel_cancel(TimerWheel *wheel, TimerEntry *entry);
+bool timer_is_armed(const TimerEntry *entry);
+
+// Fire every timer due at or before now_ms; returns the number fired
+int timer_wheel_advance(TimerWheel *wheel, long now_ms, TimerCallback callback, void *context);
+int timer_wheel_count(const TimerWheel *wheel);
+
+// Earliest time the next timer could fire (-1 if none armed); may be early
+// when the next timer still sits on a higher level
+long timer_wheel_next_expiry(const TimerWheel *wheel);
+
+#endif // TIMER_WHEEL_H
@@ -0,0 +1,69 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// TRACE FILE FORMAT
+
+// A trace file is a TraceHeader followed by `count` fixed-size TraceEvents.
+// The file is preallocated and memory-mapped when tracing starts, so
+// recording an event is a store into the mapping with no system call.
+#define TRACE_MAGIC "BATTRACE"
+#define TRACE_VERSION 2
+#define TRACE_DEFAULT_CAPACITY (1 << 18)    // Events per file (8 MB)
+
+// Scheduling event types; payload fields per type are listed alongside
+typedef enum {
+    TRACE_ADMIT = 1,                // priority, energy cost, burst (ms), deadline (ms)
+    TRACE_DISPATCH,                 // algorithm, mode, remaining (ms), battery (%)
+    TRACE_PREEMPT,                  // remaining (ms)
+    TRACE_SUSPEND,                  // remaining (ms)
+    TRACE_RESUME,                   // remaining (ms)
+    TRACE_COMPLETE,                 // waiting (us), turnaround (us), missed deadline
+    TRACE_DROP,                     // remaining (ms), deadline (ms)
+    TRACE_MODE_CHANGE,              // old mode, new mode, battery (%)
+    TRACE_BATTERY,                  // battery (%), battery state, energy drawn
+    TRACE_CONTEXT_SWITCH            // previous task ID, switches so far
+} TraceEventType;
+
+#define TRACE_PAYLOAD_FIELDS 4
+
+// One recorded event (32 bytes)
+typedef struct {
+    uint64_t timestamp_ns;          // Scheduler clock when the event happened
+    int32_t task_id;                // Task concerned (-1 = none)
+    uint16_t type;                  // TraceEventType
+    uint16_t reserved;
+    int32_t payload[TRACE_PAYLOAD_FIELDS];   // Type-specific fields (see above)
+} TraceEvent;
+
+// File header (64 bytes)
+typedef struct {
+    char magic[8];                  // TRACE_MAGIC, not NUL-terminated
+    uint32_t version;               // TRACE_VERSION
+    uint32_t event_size;            // sizeof(TraceEvent)
+    uint64_t capacity;              // Events the file has room for
+    uint64_t count;                 // Events recorded
+    uint64_t dropped;               // Events lost because the file was full
+    uint64_t start_ns;              // Clock when tracing started
+    uint8_t reserved[16];
+} TraceHeader;
+
+
+// TRACE FUNCTIONS
+
+// Start recording into a new file with room for `capacity` events
+int trace_open(const char *path, uint64_t capacity);
+
+// Stop recording; the file is truncated to the events recorded
+int trace_close(void);
+bool trace_enabled(void);
+
+// Record one event (no effect unless a trace is open)
+void trace_record(TraceEventType type, int task_id, int32_t a, int32_t b, int32_t c, int32_t d);
+
+// Name of an event type (for decoders)
+const char* trace_event_name(uint16_t type);
+
+#endif // TRACE_H
@@ -2,6 +2,7 @@
 #define UTILS_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -9,7 +10,7 @@
 #include <stdarg.h>
 
 // CONSTANTS AND MACROS
-#define MAX_TASKS 50
+#define MAX_TASKS 50                // Initial task queue capacity (queues grow)
 #define MAX_TASK_NAME 64
 #define MAX_LOG_MSG 256
 
@@ -29,6 +30,16 @@
 #define ENERGY_MEDIUM 2
 #define ENERGY_LOW 1
 
+// Log levels (a message is logged when its level <= the current level)
+#define LOG_LEVEL_ERROR 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_DEBUG 2
+
+// Log calls above this level compile to nothing (e.g. make LOG_LEVEL=1)
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_DEBUG
+#endif
+
 // Return codes
 #define SUCCESS 0
 #define ERROR -1
@@ -49,17 +60,71 @@ typedef enum {
     TASK_STATE_RUNNING,
     TASK_STATE_WAITING,
     TASK_STATE_COMPLETED,
-    TASK_STATE_SUSPENDED
+    TASK_STATE_SUSPENDED,
+    TASK_STATE_DROPPED              // Abandoned before completion (end state)
 } TaskState;
 
+// Clock source behind get_time_ns(), get_current_time_ms() and sleep_ms()
+typedef enum {
+    CLOCK_MODE_WALL,                // Real time: sleep_ms() blocks the caller
+    CLOCK_MODE_VIRTUAL              // Simulated time: sleep_ms() jumps the clock forward
+} ClockMode;
+
+// One timeline: the real clock, or a virtual clock of its own. Each
+// scheduler context reads one; the global time functions read default_clock.
+typedef struct {
+    ClockMode mode;
+    int64_t virtual_time_ns;        // Current time (CLOCK_MODE_VIRTUAL)
+} SimClock;
+
+// Scheduler instance (see scheduler.h)
+typedef struct SchedContext SchedContext;
+
 // ===== LOGGING FUNCTIONS =====
 void init_logging(void);
 void close_logging(void);
+void log_flush(void);
 void get_timestamp(char *buffer, size_t size);
-void log_info(const char *format, ...);
-void log_debug(const char *format, ...);
-void log_error(const char *format, ...);
+void log_info(const char *format, ...) __attribute__((format(printf, 1, 2)));
+void log_debug(const char *format, ...) __attribute__((format(printf, 1, 2)));
+void log_error(const char *format, ...) __attribute__((format(printf, 1, 2)));
 void log_message(const char *level, const char *message);
+void set_log_level(int level);
+int get_log_level(void);
+
+// Runtime log level; change it with set_log_level()
+extern int log_runtime_level;
+
+// Logging macros: the level is checked before any argument is evaluated, so
+// a disabled message costs one load and no formatting
+#define LOG_AT(level, log_function, ...) \
+    do { \
+        if ((level) <= __atomic_load_n(&log_runtime_level, __ATOMIC_RELAXED)) { \
+            log_function(__VA_ARGS__); \
+        } \
+    } while(0)
+
+// Compiled-out call: arguments are still type-checked but never evaluated
+#define LOG_NONE(log_function, ...) \
+    do { \
+        if (0) { \
+            log_function(__VA_ARGS__); \
+        } \
+    } while(0)
+
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, log_error, __VA_ARGS__)
+
+#if LOG_COMPILE_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) LOG_AT(LOG_LEVEL_INFO, log_info, __VA_ARGS__)
+#else
+#define LOG_INFO(...) LOG_NONE(log_info, __VA_ARGS__)
+#endif
+
+#if LOG_COMPILE_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, log_debug, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) LOG_NONE(log_debug, __VA_ARGS__)
+#endif
 
 // ===== DISPLAY FUNCTIONS =====
 void print_status(void);
@@ -73,10 +138,31 @@ void display_statistics(void);
 
 // UTILITY FUNCTIONS
 
-// Time utilities
+// Time utilities: every timestamp comes from get_time_ns(), which reads
+// CLOCK_MONOTONIC (or the virtual clock) in nanoseconds
+#define NS_PER_US 1000LL
+#define NS_PER_MS 1000000LL
+#define NS_PER_SEC 1000000000LL
+
+int64_t get_time_ns(void);
+int64_t get_monotonic_ns(void);     // Always the real clock, for timing code
 long get_current_time_ms(void);
 void sleep_ms(int milliseconds);
 
+// Virtual clock (discrete-event simulation)
+void set_clock_mode(ClockMode mode);
+ClockMode get_clock_mode(void);
+void reset_virtual_clock(void);
+void advance_virtual_clock(long milliseconds);
+
+// The same operations on one clock
+extern SimClock default_clock;
+void sim_clock_init(SimClock *clock, ClockMode mode);
+int64_t sim_clock_ns(const SimClock *clock);
+long sim_clock_ms(const SimClock *clock);
+void sim_clock_sleep_ms(SimClock *clock, int milliseconds);
+void sim_clock_advance(SimClock *clock, long milliseconds);
+
 // String utilities
 char* trim_whitespace(char *str);
 int string_to_int(const char *str);
@@ -90,4 +176,10 @@ double calculate_percentage(int value, int total);
 void* safe_malloc(size_t size);
 void safe_free(void **ptr);
 
+// Parallel jobs: run job(0..count-1) on up to `threads` threads, each
+// thread taking the next unclaimed index; returns when all have finished
+typedef void (*ParallelJob)(int index, void *context);
+int online_cpu_count(void);
+void run_parallel(ParallelJob job, int count, void *context, int threads);
+
 #endif // UTILS_H
@@ -0,0 +1,120 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "utils.h"
+
+// RANDOM NUMBER GENERATOR
+
+// xoshiro256** generator: fast, 256 bits of state, and reproducible from a
+// 64-bit seed (expanded with splitmix64) on every platform
+typedef struct {
+    uint64_t state[4];
+} Rng;
+
+void rng_seed(Rng *rng, uint64_t seed);
+uint64_t rng_next(Rng *rng);
+double rng_uniform(Rng *rng);                   // [0, 1)
+double rng_exponential(Rng *rng, double mean);  // Poisson process gaps
+
+
+// WORKLOAD STRUCTURES
+
+// One task of a workload, before it is created
+typedef struct {
+    int64_t arrival_ms;             // Arrival time, from the start of the workload
+    char name[MAX_TASK_NAME];       // Task name
+    int priority;                   // PRIORITY_HIGH .. PRIORITY_LOW
+    int energy_cost;                // ENERGY_LOW .. ENERGY_HIGH
+    int burst_time;                 // Execution time (ms)
+    bool is_critical;               // Critical task
+    int deadline;                   // Relative deadline (ms, 0 = none)
+} TaskSpec;
+
+// Produces a workload's tasks in arrival order; returns false when done
+typedef bool (*TaskSpecSource)(void *source, TaskSpec *spec);
+
+// Arrival processes
+typedef enum {
+    ARRIVAL_POISSON,                // Exponential gaps with mean_interarrival_ms
+    ARRIVAL_PERIODIC,               // One task every mean_interarrival_ms
+    ARRIVAL_BATCH                   // Poisson batches of 1..batch_size tasks
+} ArrivalProcess;
+
+// Burst time distributions (clamped to [min_burst_ms, max_burst_ms])
+typedef enum {
+    BURST_EXPONENTIAL,              // Mean burst_mean_ms
+    BURST_PARETO,                   // Heavy tail: scale min_burst_ms, index pareto_alpha
+    BURST_BIMODAL                   // short_burst_ms or, with long_fraction, long_burst_ms
+} BurstDistribution;
+
+// Synthetic workload description
+typedef struct {
+    long task_count;                // Tasks generated
+    uint64_t seed;                  // Same seed, same workload
+
+    ArrivalProcess arrival;
+    double mean_interarrival_ms;    // Mean gap between arrivals (or batches)
+    int batch_size;                 // ARRIVAL_BATCH: most tasks per batch
+
+    BurstDistribution burst;
+    double burst_mean_ms;           // BURST_EXPONENTIAL mean
+    double pareto_alpha;            // BURST_PARETO tail index (> 1)
+    int short_burst_ms;             // BURST_BIMODAL modes
+    int long_burst_ms;
+    double long_fraction;
+    int min_burst_ms;               // Burst time bounds for every distribution
+    int max_burst_ms;
+
+    int priority_mix[3];            // Relative weights of HIGH, MEDIUM, LOW
+    int energy_mix[3];              // Relative weights of LOW, MEDIUM, HIGH
+    double critical_fraction;       // Share of tasks that are critical (run at HIGH)
+    double critical_bursts_per_sec; // Extra Poisson bursts of critical tasks (0 = none)
+    int critical_burst_max;         // Up to this many tasks per critical burst
+
+    double deadline_slack_min;      // Deadline = burst x slack, slack uniform in
+    double deadline_slack_max;      // [min, max]; 0 = no deadlines
+} WorkloadConfig;
+
+// Synthetic workload generator (a TaskSpecSource); O(1) state
+typedef struct {
+    WorkloadConfig config;
+    Rng rng;
+    long generated;                 // Tasks produced so far
+    double next_arrival_ms;         // Next regular arrival (or batch)
+    int batch_remaining;            // Tasks left in the current batch
+    double next_critical_ms;        // Next critical burst
+    int critical_remaining;         // Tasks left in the current critical burst
+} WorkloadGenerator;
+
+// Feeds a TaskSpecSource into the scheduler at the tasks' arrival times
+typedef struct {
+    SchedContext *ctx;              // Scheduler the tasks are admitted to
+    TaskSpecSource next;            // Spec source and its state
+    void *source;
+    TaskSpec pending;               // Next task to arrive
+    bool has_pending;
+    long start_ms;                  // Clock at arrival time 0
+    long admitted;                  // Tasks admitted to the scheduler
+    long rejected;                  // Tasks refused by admission control
+    int peak_live;                  // Most tasks held by the task manager at once
+} WorkloadStream;
+
+
+// WORKLOAD FUNCTIONS
+
+// Generator: defaults describe a mixed interactive workload
+void workload_default_config(WorkloadConfig *config);
+int workload_init(WorkloadGenerator *gen, const WorkloadConfig *config);
+bool workload_next(void *generator, TaskSpec *spec);
+double workload_mean_burst_ms(const WorkloadConfig *config);
+
+// Streaming admission: registers the scheduler's arrival source and done
+// hook, so each task is created when the clock reaches its arrival time and
+// removed once it completes or is dropped. Memory stays proportional to the
+// live tasks however long the workload is.
+int workload_stream_start(WorkloadStream *stream, TaskSpecSource next, void *source);
+int workload_stream_start_ctx(SchedContext *ctx, WorkloadStream *stream, TaskSpecSource next,
+                              void *source);
+long workload_stream_admit(long now_ms, void *stream);
+
+#endif // WORKLOAD_H
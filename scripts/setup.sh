@@ -171,9 +171,18 @@ else
     gcc -c src/battery_monitor.c -o obj/battery_monitor.o -Iinclude
     gcc -c src/task_manager.c -o obj/task_manager.o -Iinclude
     gcc -c src/scheduler.c -o obj/scheduler.o -Iinclude
+    gcc -c src/simd_scan.c -o obj/simd_scan.o -Iinclude
+    gcc -c src/timer_wheel.c -o obj/timer_wheel.o -Iinclude
+    gcc -c src/log_ring.c -o obj/log_ring.o -Iinclude
+    gcc -c src/trace.c -o obj/trace.o -Iinclude
+    gcc -c src/histogram.c -o obj/histogram.o -Iinclude
+    gcc -c src/workload.c -o obj/workload.o -Iinclude
+    gcc -c src/replay.c -o obj/replay.o -Iinclude
+    gcc -c src/sweep.c -o obj/sweep.o -Iinclude
+    gcc -c src/montecarlo.c -o obj/montecarlo.o -Iinclude
     gcc -c src/main.c -o obj/main.o -Iinclude
     
-    gcc obj/utils.o obj/battery_monitor.o obj/task_manager.o obj/scheduler.o obj/main.o -o bin/scheduler -lm
+    gcc obj/utils.o obj/battery_monitor.o obj/task_manager.o obj/scheduler.o obj/simd_scan.o obj/timer_wheel.o obj/log_ring.o obj/trace.o obj/histogram.o obj/workload.o obj/replay.o obj/sweep.o obj/montecarlo.o obj/main.o -o bin/scheduler -lm -lpthread
     
     if [ $? -eq 0 ]; then
         echo -e "${GREEN}✓ Manual compilation successful!${NC}"
@@ -191,20 +200,60 @@ echo ""
 echo "Building test suites..."
 
 if [ -f "tests/test_scheduler.c" ]; then
-    gcc tests/test_scheduler.c src/scheduler.c src/battery_monitor.c src/task_manager.c src/utils.c -o bin/test_scheduler -Iinclude -lm
+    gcc tests/test_scheduler.c src/scheduler.c src/battery_monitor.c src/task_manager.c src/simd_scan.c src/timer_wheel.c src/log_ring.c src/histogram.c src/trace.c src/workload.c src/replay.c src/sweep.c src/montecarlo.c src/utils.c -o bin/test_scheduler -Iinclude -lm -lpthread
     echo -e "${GREEN}✓ test_scheduler built${NC}"
 fi
 
 if [ -f "tests/test_battery_monitor.c" ]; then
-    gcc tests/test_battery_monitor.c src/battery_monitor.c src/utils.c -o bin/test_battery_monitor -Iinclude -lm
+    gcc tests/test_battery_monitor.c src/scheduler.c src/battery_monitor.c src/task_manager.c src/simd_scan.c src/timer_wheel.c src/log_ring.c src/histogram.c src/trace.c src/workload.c src/replay.c src/sweep.c src/montecarlo.c src/utils.c -o bin/test_battery_monitor -Iinclude -lm -lpthread
     echo -e "${GREEN}✓ test_battery_monitor built${NC}"
 fi
 
 if [ -f "tests/test_task_manager.c" ]; then
-    gcc tests/test_task_manager.c src/task_manager.c src/utils.c -o bin/test_task_manager -Iinclude -lm
+    gcc tests/test_task_manager.c src/scheduler.c src/battery_monitor.c src/task_manager.c src/simd_scan.c src/timer_wheel.c src/log_ring.c src/histogram.c src/trace.c src/workload.c src/replay.c src/sweep.c src/montecarlo.c src/utils.c -o bin/test_task_manager -Iinclude -lm -lpthread
     echo -e "${GREEN}✓ test_task_manager built${NC}"
 fi
 
+if [ -f "tests/test_timer_wheel.c" ]; then
+    gcc tests/test_timer_wheel.c src/timer_wheel.c src/log_ring.c src/utils.c -o bin/test_timer_wheel -Iinclude -lm -lpthread
+    echo -e "${GREEN}✓ test_timer_wheel built${NC}"
+fi
+
+if [ -f "tests/test_log_ring.c" ]; then
+    gcc tests/test_log_ring.c src/log_ring.c src/utils.c -o bin/test_log_ring -Iinclude -lm -lpthread
+    echo -e "${GREEN}✓ test_log_ring built${NC}"
+fi
+
+if [ -f "tests/test_trace.c" ]; then
+    gcc tests/test_trace.c src/scheduler.c src/battery_monitor.c src/task_manager.c src/simd_scan.c src/timer_wheel.c src/log_ring.c src/histogram.c src/trace.c src/workload.c src/replay.c src/sweep.c src/montecarlo.c src/utils.c -o bin/test_trace -Iinclude -lm -lpthread
+    echo -e "${GREEN}✓ test_trace built${NC}"
+fi
+
+if [ -f "tests/test_histogram.c" ]; then
+    gcc tests/test_histogram.c src/histogram.c -o bin/test_histogram -Iinclude -lm
+    echo -e "${GREEN}✓ test_histogram built${NC}"
+fi
+
+if [ -f "tests/test_workload.c" ]; then
+    gcc tests/test_workload.c src/scheduler.c src/battery_monitor.c src/task_manager.c src/simd_scan.c src/timer_wheel.c src/log_ring.c src/histogram.c src/trace.c src/workload.c src/replay.c src/sweep.c src/montecarlo.c src/utils.c -o bin/test_workload -Iinclude -lm -lpthread
+    echo -e "${GREEN}✓ test_workload built${NC}"
+fi
+
+if [ -f "tests/test_replay.c" ]; then
+    gcc tests/test_replay.c src/scheduler.c src/battery_monitor.c src/task_manager.c src/simd_scan.c src/timer_wheel.c src/log_ring.c src/histogram.c src/trace.c src/workload.c src/replay.c src/sweep.c src/montecarlo.c src/utils.c -o bin/test_replay -Iinclude -lm -lpthread
+    echo -e "${GREEN}✓ test_replay built${NC}"
+fi
+
+if [ -f "tests/test_sweep.c" ]; then
+    gcc tests/test_sweep.c src/scheduler.c src/battery_monitor.c src/task_manager.c src/simd_scan.c src/timer_wheel.c src/log_ring.c src/histogram.c src/trace.c src/workload.c src/replay.c src/sweep.c src/montecarlo.c src/utils.c -o bin/test_sweep -Iinclude -lm -lpthread
+    echo -e "${GREEN}✓ test_sweep built${NC}"
+fi
+
+if [ -f "tests/test_montecarlo.c" ]; then
+    gcc tests/test_montecarlo.c src/scheduler.c src/battery_monitor.c src/task_manager.c src/simd_scan.c src/timer_wheel.c src/log_ring.c src/histogram.c src/trace.c src/workload.c src/replay.c src/sweep.c src/montecarlo.c src/utils.c -o bin/test_montecarlo -Iinclude -lm -lpthread
+    echo -e "${GREEN}✓ test_montecarlo built${NC}"
+fi
+
 echo ""
 
 
@@ -213,10 +262,20 @@ echo ""
 echo "Building examples..."
 
 if [ -f "examples/example_tasks.c" ]; then
-    gcc examples/example_tasks.c src/scheduler.c src/battery_monitor.c src/task_manager.c src/utils.c -o bin/example_tasks -Iinclude -lm
+    gcc examples/example_tasks.c src/scheduler.c src/battery_monitor.c src/task_manager.c src/simd_scan.c src/timer_wheel.c src/log_ring.c src/histogram.c src/trace.c src/workload.c src/replay.c src/sweep.c src/montecarlo.c src/utils.c -o bin/example_tasks -Iinclude -lm -lpthread
     echo -e "${GREEN}✓ example_tasks built${NC}"
 fi
 
+if [ -f "tools/trace_decode.c" ]; then
+    gcc tools/trace_decode.c src/trace.c src/log_ring.c src/utils.c -o bin/trace_decode -Iinclude -lm -lpthread
+    echo -e "${GREEN}✓ trace_decode built${NC}"
+fi
+
+if [ -f "tools/workload_convert.c" ]; then
+    gcc tools/workload_convert.c src/scheduler.c src/battery_monitor.c src/task_manager.c src/simd_scan.c src/timer_wheel.c src/log_ring.c src/histogram.c src/trace.c src/workload.c src/replay.c src/sweep.c src/montecarlo.c src/utils.c -o bin/workload_convert -Iinclude -lm -lpthread
+    echo -e "${GREEN}✓ workload_convert built${NC}"
+fi
+
 echo ""
 
 
@@ -1,56 +1,53 @@
 // /home/nishit/Desktop/OS/nishit/osproject/include/scheduler.h
 #include "../include/battery_monitor.h"
+#include "../include/scheduler.h"
 #include <stdio.h>
 #include <stdlib.h>
 
 
-// GLOBAL VARIABLES
-
-
-static BatteryInfo battery_info;
-static BatteryThresholds battery_thresholds;
-static bool is_initialized = false;
-
-
 // INITIALIZATION AND CLEANUP
 
 
 // Initialize battery monitor
-int battery_monitor_init(void) {
-    if (is_initialized) {
-        log_error("Battery monitor already initialized");
+int battery_monitor_init_ctx(SchedContext *ctx) {
+    BatteryMonitor *battery = &ctx->battery;
+    
+    if (battery->initialized) {
+        LOG_ERROR("Battery monitor already initialized");
         return ERROR;
     }
     
     // Initialize battery info with default values
-    battery_info.current_level = 100;  // Start at full battery
-    battery_info.state = BATTERY_STATE_DISCHARGING;
-    battery_info.voltage = 4200;  // 4.2V in mV (typical Li-ion full charge)
-    battery_info.current = 0;
-    battery_info.temperature = 25;  // 25°C room temperature
-    battery_info.last_update_time = get_current_time_ms();
-    battery_info.discharge_rate = 5;  // 5% per hour default
+    battery->info.current_level = 100;  // Start at full battery
+    battery->info.state = BATTERY_STATE_DISCHARGING;
+    battery->info.voltage = 4200;  // 4.2V in mV (typical Li-ion full charge)
+    battery->info.current = 0;
+    battery->info.temperature = 25;  // 25°C room temperature
+    battery->info.last_update_ns = sim_clock_ns(ctx->clock);
+    battery->info.discharge_rate = 5;  // 5% per hour default
     
     // Initialize thresholds with default values
-    battery_thresholds.critical_threshold = BATTERY_CRITICAL;
-    battery_thresholds.low_threshold = BATTERY_LOW;
-    battery_thresholds.medium_threshold = BATTERY_MEDIUM;
-    battery_thresholds.high_threshold = BATTERY_HIGH;
+    battery->thresholds.critical_threshold = BATTERY_CRITICAL;
+    battery->thresholds.low_threshold = BATTERY_LOW;
+    battery->thresholds.medium_threshold = BATTERY_MEDIUM;
+    battery->thresholds.high_threshold = BATTERY_HIGH;
     
-    is_initialized = true;
-    log_info("Battery monitor initialized successfully");
+    battery->initialized = true;
+    LOG_INFO("Battery monitor initialized successfully");
     
     return SUCCESS;
 }
 
 // Cleanup battery monitor
-void battery_monitor_cleanup(void) {
-    if (!is_initialized) {
+void battery_monitor_cleanup_ctx(SchedContext *ctx) {
+    BatteryMonitor *battery = &ctx->battery;
+    
+    if (!battery->initialized) {
         return;
     }
     
-    is_initialized = false;
-    log_info("Battery monitor cleaned up");
+    battery->initialized = false;
+    LOG_INFO("Battery monitor cleaned up");
 }
 
 
@@ -58,39 +55,84 @@ void battery_monitor_cleanup(void) {
 
 
 // Get battery information structure
-BatteryInfo* get_battery_info(void) {
-    if (!is_initialized) {
-        log_error("Battery monitor not initialized");
+BatteryInfo* get_battery_info_ctx(SchedContext *ctx) {
+    BatteryMonitor *battery = &ctx->battery;
+    
+    if (!battery->initialized) {
+        LOG_ERROR("Battery monitor not initialized");
         return NULL;
     }
-    return &battery_info;
+    return &battery->info;
 }
 
 // Get current battery level
-int get_battery_level(void) {
-    if (!is_initialized) {
-        log_error("Battery monitor not initialized");
+int get_battery_level_ctx(SchedContext *ctx) {
+    BatteryMonitor *battery = &ctx->battery;
+    
+    if (!battery->initialized) {
+        LOG_ERROR("Battery monitor not initialized");
         return ERROR;
     }
-    return battery_info.current_level;
+    return battery->info.current_level;
 }
 
 // Get battery state
-BatteryState get_battery_state(void) {
-    if (!is_initialized) {
-        log_error("Battery monitor not initialized");
+BatteryState get_battery_state_ctx(SchedContext *ctx) {
+    BatteryMonitor *battery = &ctx->battery;
+    
+    if (!battery->initialized) {
+        LOG_ERROR("Battery monitor not initialized");
         return BATTERY_STATE_UNKNOWN;
     }
-    return battery_info.state;
+    return battery->info.state;
 }
 
 // Get discharge rate
-int get_discharge_rate(void) {
-    if (!is_initialized) {
-        log_error("Battery monitor not initialized");
+int get_discharge_rate_ctx(SchedContext *ctx) {
+    BatteryMonitor *battery = &ctx->battery;
+    
+    if (!battery->initialized) {
+        LOG_ERROR("Battery monitor not initialized");
         return ERROR;
     }
-    return battery_info.discharge_rate;
+    return battery->info.discharge_rate;
+}
+
+
+// BATTERY EVENTS
+
+
+// Threshold band a level falls in (0 = critical ... 4 = above high)
+static int threshold_band(BatteryMonitor *battery, int level) {
+    if (level <= battery->thresholds.critical_threshold) {
+        return 0;
+    } else if (level <= battery->thresholds.low_threshold) {
+        return 1;
+    } else if (level <= battery->thresholds.medium_threshold) {
+        return 2;
+    } else if (level <= battery->thresholds.high_threshold) {
+        return 3;
+    }
+    return 4;
+}
+
+// Notify the listener if the battery changed state or threshold band
+static void check_battery_event(SchedContext *ctx, int old_level, BatteryState old_state) {
+    BatteryMonitor *battery = &ctx->battery;
+    
+    if (battery->callback == NULL) {
+        return;
+    }
+    
+    if (battery->info.state != old_state || 
+        threshold_band(battery, battery->info.current_level) != threshold_band(battery, old_level)) {
+        battery->callback(ctx, battery->info.current_level, battery->info.state);
+    }
+}
+
+// Register the battery event listener (NULL to remove it)
+void set_battery_event_callback_ctx(SchedContext *ctx, BatteryEventCallback callback) {
+    ctx->battery.callback = callback;
 }
 
 
@@ -98,48 +140,58 @@ int get_discharge_rate(void) {
 
 
 // Update battery status (simulated for now)
-int update_battery_status(void) {
-    if (!is_initialized) {
-        log_error("Battery monitor not initialized");
+int update_battery_status_ctx(SchedContext *ctx) {
+    BatteryMonitor *battery = &ctx->battery;
+    
+    if (!battery->initialized) {
+        LOG_ERROR("Battery monitor not initialized");
         return ERROR;
     }
     
-    long current_time = get_current_time_ms();
-    long time_elapsed = current_time - battery_info.last_update_time;
+    int old_level = battery->info.current_level;
+    BatteryState old_state = battery->info.state;
+    int64_t current_time = sim_clock_ns(ctx->clock);
+    int64_t time_elapsed = current_time - battery->info.last_update_ns;
+    if (time_elapsed < 0) {
+        time_elapsed = 0;  // Clock source changed since the last update
+    }
     
     // Only update if charging or discharging
-    if (battery_info.state == BATTERY_STATE_DISCHARGING) {
+    if (battery->info.state == BATTERY_STATE_DISCHARGING) {
         // Simulate natural discharge (small amount over time)
-        double hours_elapsed = time_elapsed / (1000.0 * 60.0 * 60.0);
-        int drain = (int)(battery_info.discharge_rate * hours_elapsed);
+        double hours_elapsed = (double)time_elapsed / (NS_PER_SEC * 60.0 * 60.0);
+        int drain = (int)(battery->info.discharge_rate * hours_elapsed);
         
-        battery_info.current_level = max(0, battery_info.current_level - drain);
+        battery->info.current_level = max(0, battery->info.current_level - drain);
         
         // Update voltage based on level (linear approximation)
-        battery_info.voltage = 3300 + (battery_info.current_level * 9);  // 3.3V to 4.2V
+        battery->info.voltage = 3300 + (battery->info.current_level * 9);  // 3.3V to 4.2V
         
-    } else if (battery_info.state == BATTERY_STATE_CHARGING) {
+    } else if (battery->info.state == BATTERY_STATE_CHARGING) {
         // Simulate charging
-        double hours_elapsed = time_elapsed / (1000.0 * 60.0 * 60.0);
+        double hours_elapsed = (double)time_elapsed / (NS_PER_SEC * 60.0 * 60.0);
         int charge = (int)(20 * hours_elapsed);  // 20% per hour charge rate
         
-        battery_info.current_level = min(100, battery_info.current_level + charge);
-        battery_info.voltage = 3300 + (battery_info.current_level * 9);
+        battery->info.current_level = min(100, battery->info.current_level + charge);
+        battery->info.voltage = 3300 + (battery->info.current_level * 9);
         
-        if (battery_info.current_level >= 100) {
-            battery_info.state = BATTERY_STATE_FULL;
+        if (battery->info.current_level >= 100) {
+            battery->info.state = BATTERY_STATE_FULL;
         }
     }
     
-    battery_info.last_update_time = current_time;
+    battery->info.last_update_ns = current_time;
+    check_battery_event(ctx, old_level, old_state);
     
     return SUCCESS;
 }
 
 // Simulate battery drain from task execution
-int simulate_battery_drain(int task_energy_cost) {
-    if (!is_initialized) {
-        log_error("Battery monitor not initialized");
+int simulate_battery_drain_ctx(SchedContext *ctx, int task_energy_cost) {
+    BatteryMonitor *battery = &ctx->battery;
+    
+    if (!battery->initialized) {
+        LOG_ERROR("Battery monitor not initialized");
         return ERROR;
     }
     
@@ -161,14 +213,58 @@ int simulate_battery_drain(int task_energy_cost) {
             break;
     }
     
-    battery_info.current_level = max(0, battery_info.current_level - drain_amount);
-    battery_info.voltage = 3300 + (battery_info.current_level * 9);
-    battery_info.last_update_time = get_current_time_ms();
+    int old_level = battery->info.current_level;
+    battery->info.current_level = max(0, battery->info.current_level - drain_amount);
+    battery->info.voltage = 3300 + (battery->info.current_level * 9);
+    battery->info.last_update_ns = sim_clock_ns(ctx->clock);
+    
+    LOG_DEBUG("Battery drained by %d%%. Current level: %d%%", 
+              drain_amount, battery->info.current_level);
+    
+    check_battery_event(ctx, old_level, battery->info.state);
+    
+    return SUCCESS;
+}
+
+// Change the charging state (e.g. charger plugged in or removed)
+int set_battery_state_ctx(SchedContext *ctx, BatteryState state) {
+    BatteryMonitor *battery = &ctx->battery;
+    
+    if (!battery->initialized) {
+        LOG_ERROR("Battery monitor not initialized");
+        return ERROR;
+    }
+    
+    // Settle time spent in the old state before switching
+    update_battery_status_ctx(ctx);
+    
+    BatteryState old_state = battery->info.state;
+    battery->info.state = state;
+    
+    LOG_INFO("Battery state changed: %d -> %d", old_state, state);
+    
+    check_battery_event(ctx, battery->info.current_level, old_state);
+    
+    return SUCCESS;
+}
+
+// Set the charge level directly (simulated charger top-up or battery swap)
+int set_battery_level_ctx(SchedContext *ctx, int level) {
+    BatteryMonitor *battery = &ctx->battery;
+    
+    if (!battery->initialized) {
+        LOG_ERROR("Battery monitor not initialized");
+        return ERROR;
+    }
+    
+    int old_level = battery->info.current_level;
+    battery->info.current_level = max(0, min(100, level));
+    battery->info.voltage = 3300 + (battery->info.current_level * 9);
+    battery->info.last_update_ns = sim_clock_ns(ctx->clock);
     
-    char log_msg[MAX_LOG_MSG];
-    snprintf(log_msg, MAX_LOG_MSG, "Battery drained by %d%%. Current level: %d%%", 
-             drain_amount, battery_info.current_level);
-    log_debug(log_msg);
+    LOG_DEBUG("Battery level set: %d%% -> %d%%", old_level, battery->info.current_level);
+    
+    check_battery_event(ctx, old_level, battery->info.state);
     
     return SUCCESS;
 }
@@ -178,19 +274,21 @@ int simulate_battery_drain(int task_energy_cost) {
 
 
 // Set battery thresholds
-void set_battery_thresholds(BatteryThresholds *thresholds) {
+void set_battery_thresholds_ctx(SchedContext *ctx, BatteryThresholds *thresholds) {
+    BatteryMonitor *battery = &ctx->battery;
+    
     if (thresholds == NULL) {
-        log_error("Invalid thresholds pointer");
+        LOG_ERROR("Invalid thresholds pointer");
         return;
     }
     
-    battery_thresholds = *thresholds;
-    log_info("Battery thresholds updated");
+    battery->thresholds = *thresholds;
+    LOG_INFO("Battery thresholds updated");
 }
 
 // Get battery thresholds
-BatteryThresholds* get_battery_thresholds(void) {
-    return &battery_thresholds;
+BatteryThresholds* get_battery_thresholds_ctx(SchedContext *ctx) {
+    return &ctx->battery.thresholds;
 }
 
 
@@ -198,21 +296,27 @@ BatteryThresholds* get_battery_thresholds(void) {
 
 
 // Check if battery is critical
-bool is_battery_critical(void) {
-    if (!is_initialized) return false;
-    return (battery_info.current_level <= battery_thresholds.critical_threshold);
+bool is_battery_critical_ctx(SchedContext *ctx) {
+    BatteryMonitor *battery = &ctx->battery;
+    
+    if (!battery->initialized) return false;
+    return (battery->info.current_level <= battery->thresholds.critical_threshold);
 }
 
 // Check if battery is low
-bool is_battery_low(void) {
-    if (!is_initialized) return false;
-    return (battery_info.current_level <= battery_thresholds.low_threshold);
+bool is_battery_low_ctx(SchedContext *ctx) {
+    BatteryMonitor *battery = &ctx->battery;
+    
+    if (!battery->initialized) return false;
+    return (battery->info.current_level <= battery->thresholds.low_threshold);
 }
 
 // Check if battery is charging
-bool is_battery_charging(void) {
-    if (!is_initialized) return false;
-    return (battery_info.state == BATTERY_STATE_CHARGING);
+bool is_battery_charging_ctx(SchedContext *ctx) {
+    BatteryMonitor *battery = &ctx->battery;
+    
+    if (!battery->initialized) return false;
+    return (battery->info.state == BATTERY_STATE_CHARGING);
 }
 
 
@@ -220,16 +324,18 @@ bool is_battery_charging(void) {
 
 
 // Print battery status
-void print_battery_status(void) {
-    if (!is_initialized) {
+void print_battery_status_ctx(SchedContext *ctx) {
+    BatteryMonitor *battery = &ctx->battery;
+    
+    if (!battery->initialized) {
         printf("Battery monitor not initialized\n");
         return;
     }
     
     printf("\n=== Battery Status ===\n");
-    printf("Level: %d%%\n", battery_info.current_level);
+    printf("Level: %d%%\n", battery->info.current_level);
     printf("State: ");
-    switch(battery_info.state) {
+    switch(battery->info.state) {
         case BATTERY_STATE_CHARGING:
             printf("Charging\n");
             break;
@@ -243,34 +349,130 @@ void print_battery_status(void) {
             printf("Unknown\n");
             break;
     }
-    printf("Voltage: %d mV\n", battery_info.voltage);
-    printf("Current: %d mA\n", battery_info.current);
-    printf("Temperature: %d°C\n", battery_info.temperature);
-    printf("Discharge Rate: %d%%/hour\n", battery_info.discharge_rate);
+    printf("Voltage: %d mV\n", battery->info.voltage);
+    printf("Current: %d mA\n", battery->info.current);
+    printf("Temperature: %d°C\n", battery->info.temperature);
+    printf("Discharge Rate: %d%%/hour\n", battery->info.discharge_rate);
     printf("=====================\n\n");
 }
 
 // Estimate remaining battery time
-int estimate_remaining_time(int current_load) {
-    if (!is_initialized) {
-        log_error("Battery monitor not initialized");
+int estimate_remaining_time_ctx(SchedContext *ctx, int current_load) {
+    BatteryMonitor *battery = &ctx->battery;
+    
+    if (!battery->initialized) {
+        LOG_ERROR("Battery monitor not initialized");
         return ERROR;
     }
     
-    if (battery_info.state == BATTERY_STATE_CHARGING || 
-        battery_info.state == BATTERY_STATE_FULL) {
+    if (battery->info.state == BATTERY_STATE_CHARGING || 
+        battery->info.state == BATTERY_STATE_FULL) {
         return -1;  // Unlimited when charging
     }
     
     // Calculate based on current level and discharge rate
-    int effective_discharge_rate = battery_info.discharge_rate + current_load;
+    int effective_discharge_rate = battery->info.discharge_rate + current_load;
     
     if (effective_discharge_rate <= 0) {
         return -1;  // Unlimited
     }
     
     // Time in minutes
-    int remaining_minutes = (battery_info.current_level * 60) / effective_discharge_rate;
+    int remaining_minutes = (battery->info.current_level * 60) / effective_discharge_rate;
     
     return remaining_minutes;
 }
+
+
+// DEFAULT CONTEXT
+
+
+// Initialize the default context's battery monitor
+int battery_monitor_init(void) {
+    return battery_monitor_init_ctx(sched_default_context());
+}
+
+// Cleanup the default context's battery monitor
+void battery_monitor_cleanup(void) {
+    battery_monitor_cleanup_ctx(sched_default_context());
+}
+
+// Get battery information structure
+BatteryInfo* get_battery_info(void) {
+    return get_battery_info_ctx(sched_default_context());
+}
+
+// Get current battery level
+int get_battery_level(void) {
+    return get_battery_level_ctx(sched_default_context());
+}
+
+// Get battery state
+BatteryState get_battery_state(void) {
+    return get_battery_state_ctx(sched_default_context());
+}
+
+// Get discharge rate
+int get_discharge_rate(void) {
+    return get_discharge_rate_ctx(sched_default_context());
+}
+
+// Register the battery event listener (NULL to remove it)
+void set_battery_event_callback(BatteryEventCallback callback) {
+    set_battery_event_callback_ctx(sched_default_context(), callback);
+}
+
+// Update battery status
+int update_battery_status(void) {
+    return update_battery_status_ctx(sched_default_context());
+}
+
+// Simulate battery drain from task execution
+int simulate_battery_drain(int task_energy_cost) {
+    return simulate_battery_drain_ctx(sched_default_context(), task_energy_cost);
+}
+
+// Change the charging state
+int set_battery_state(BatteryState state) {
+    return set_battery_state_ctx(sched_default_context(), state);
+}
+
+// Set the charge level directly
+int set_battery_level(int level) {
+    return set_battery_level_ctx(sched_default_context(), level);
+}
+
+// Set battery thresholds
+void set_battery_thresholds(BatteryThresholds *thresholds) {
+    set_battery_thresholds_ctx(sched_default_context(), thresholds);
+}
+
+// Get battery thresholds
+BatteryThresholds* get_battery_thresholds(void) {
+    return get_battery_thresholds_ctx(sched_default_context());
+}
+
+// Check if battery is critical
+bool is_battery_critical(void) {
+    return is_battery_critical_ctx(sched_default_context());
+}
+
+// Check if battery is low
+bool is_battery_low(void) {
+    return is_battery_low_ctx(sched_default_context());
+}
+
+// Check if battery is charging
+bool is_battery_charging(void) {
+    return is_battery_charging_ctx(sched_default_context());
+}
+
+// Print battery status
+void print_battery_status(void) {
+    print_battery_status_ctx(sched_default_context());
+}
+
+// Estimate remaining battery time
+int estimate_remaining_time(int current_load) {
+    return estimate_remaining_time_ctx(sched_default_context(), current_load);
+}
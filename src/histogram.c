@@ -0,0 +1,136 @@
+#include "../include/histogram.h"
+#include <string.h>
+
+
+// BUCKET INDEXING
+
+
+// Bucket holding a value: values below HIST_SUB_BUCKETS map to themselves;
+// above that, the top HIST_SUB_BUCKET_BITS + 1 bits select the bucket
+static int bucket_index(uint64_t value) {
+    if (value < HIST_SUB_BUCKETS) {
+        return (int)value;
+    }
+    
+    int shift = 63 - __builtin_clzll(value) - HIST_SUB_BUCKET_BITS;
+    int index = (shift << HIST_SUB_BUCKET_BITS) + (int)(value >> shift);
+    return index < HIST_BUCKETS ? index : HIST_BUCKETS - 1;
+}
+
+// Largest value that falls in a bucket
+static int64_t bucket_upper_bound(int index) {
+    if (index < 2 * HIST_SUB_BUCKETS) {
+        return index;
+    }
+    
+    int shift = (index >> HIST_SUB_BUCKET_BITS) - 1;
+    int64_t base = (int64_t)(index - (shift << HIST_SUB_BUCKET_BITS)) << shift;
+    return base + ((int64_t)1 << shift) - 1;
+}
+
+
+// HISTOGRAM API
+
+
+// Initialize an empty histogram
+void histogram_init(Histogram *hist) {
+    memset(hist, 0, sizeof(*hist));
+    hist->min = INT64_MAX;
+}
+
+// Record one value (O(1), no allocation)
+void histogram_record(Histogram *hist, int64_t value) {
+    if (value < 0) {
+        value = 0;
+    }
+    
+    hist->counts[bucket_index((uint64_t)value)]++;
+    hist->total++;
+    hist->sum += value;
+    if (value < hist->min) {
+        hist->min = value;
+    }
+    if (value > hist->max) {
+        hist->max = value;
+    }
+}
+
+// Add every value of src to dst
+void histogram_merge(Histogram *dst, const Histogram *src) {
+    if (src->total == 0) {
+        return;
+    }
+    
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        dst->counts[i] += src->counts[i];
+    }
+    dst->total += src->total;
+    dst->sum += src->sum;
+    if (src->min < dst->min) {
+        dst->min = src->min;
+    }
+    if (src->max > dst->max) {
+        dst->max = src->max;
+    }
+}
+
+// Value at or below which `percentile` percent of the values fall
+int64_t histogram_percentile(const Histogram *hist, double percentile) {
+    if (hist->total == 0) {
+        return 0;
+    }
+    if (percentile >= 100.0) {
+        return hist->max;
+    }
+    
+    // Rank of the value wanted, counting from 1 (rounded up)
+    double exact_rank = percentile / 100.0 * hist->total;
+    uint64_t rank = (uint64_t)exact_rank;
+    if (rank < exact_rank || rank == 0) {
+        rank++;
+    }
+    
+    uint64_t seen = 0;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        seen += hist->counts[i];
+        if (seen >= rank) {
+            int64_t value = bucket_upper_bound(i);
+            if (value > hist->max) {
+                return hist->max;
+            }
+            return value > hist->min ? value : hist->min;
+        }
+    }
+    return hist->max;
+}
+
+// Mean of the recorded values (0 if empty)
+double histogram_mean(const Histogram *hist) {
+    return hist->total > 0 ? (double)hist->sum / hist->total : 0.0;
+}
+
+
+// DISPLAY
+
+
+// Print the column headings for histogram rows
+void histogram_print_header(FILE *out, const char *title) {
+    fprintf(out, "%-22s %6s %9s %9s %9s %9s %9s\n",
+            title, "count", "p50", "p90", "p99", "p99.9", "max");
+}
+
+// Print one histogram of nanosecond values as a row of percentiles
+void histogram_print_row(FILE *out, const char *label, const Histogram *hist, double unit_ns) {
+    if (hist->total == 0) {
+        fprintf(out, "%-22s %6d %9s %9s %9s %9s %9s\n", label, 0, "-", "-", "-", "-", "-");
+        return;
+    }
+    
+    fprintf(out, "%-22s %6llu %9.3f %9.3f %9.3f %9.3f %9.3f\n", label,
+            (unsigned long long)hist->total,
+            histogram_percentile(hist, 50.0) / unit_ns,
+            histogram_percentile(hist, 90.0) / unit_ns,
+            histogram_percentile(hist, 99.0) / unit_ns,
+            histogram_percentile(hist, 99.9) / unit_ns,
+            hist->max / unit_ns);
+}
@@ -0,0 +1,557 @@
+#define _DEFAULT_SOURCE
+#include "../include/log_ring.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#define LOG_RING_MASK (LOG_RING_CAPACITY - 1)
+
+// Producers wake the writer early once this many entries are waiting
+#define LOG_WAKE_THRESHOLD (LOG_RING_CAPACITY / 2)
+
+
+// LOG RING STATE
+
+
+// One argument captured for the writer to format
+typedef union {
+    long long integer;              // Integer types, '*' widths, %s offsets
+    double real;                    // Floating-point types
+    const void *pointer;            // %p
+} LogArg;
+
+// One queued entry. sequence == position: free for the producer claiming
+// that position; sequence == position + 1: filled, ready for the writer.
+typedef struct {
+    size_t sequence;                // Turn counter (see above)
+    time_t timestamp;               // Wall-clock second the entry was queued
+    int level;                      // LOG_LEVEL_* severity
+    const char *format;             // printf format (NULL = text is preformatted)
+    LogArg args[LOG_MAX_ARGS];      // Arguments in the order the format uses them
+    char text[MAX_LOG_MSG];         // Copied %s arguments, or the whole message
+} LogSlot;
+
+typedef struct {
+    LogSlot slots[LOG_RING_CAPACITY];
+    size_t head;                    // Next position to claim (producers, atomic)
+    size_t tail;                    // Next position to write (writer only)
+    size_t written;                 // Positions below this are on disk
+    long dropped;                   // Entries dropped on overflow (atomic)
+    int callers;                    // Pushes and flushes in progress (atomic)
+    int console_fd;                 // Console output (-1 = none)
+    int file_fd;                    // Log file output (-1 = none)
+    bool writer_idle;               // Writer is waiting for entries (atomic)
+    bool stopping;                  // log_ring_stop() requested
+    pthread_t writer;
+    pthread_mutex_t mutex;          // Guards the condition variables below
+    pthread_cond_t wake;            // Producers -> writer
+    pthread_cond_t flushed;         // Writer -> log_ring_flush()
+} LogRing;
+
+static LogRing ring;
+static bool is_active = false;
+
+static const char *level_names[] = {"ERROR", "INFO", "DEBUG"};
+
+
+// DEFERRED FORMATTING
+
+
+// C type a conversion reads from the argument list
+typedef enum {
+    ARG_NONE,                       // "%%"
+    ARG_INT,
+    ARG_LONG,
+    ARG_LONG_LONG,
+    ARG_SIZE,
+    ARG_INTMAX,
+    ARG_PTRDIFF,
+    ARG_DOUBLE,
+    ARG_STRING,
+    ARG_POINTER,
+    ARG_UNSUPPORTED                 // %n, %Lf, wide strings, malformed specs
+} LogArgType;
+
+// One parsed conversion specification
+typedef struct {
+    const char *end;                // One past the conversion character
+    int stars;                      // '*' width/precision arguments before it
+    LogArgType type;
+} LogSpec;
+
+// Parse the conversion that starts at a '%'
+static LogSpec parse_spec(const char *p) {
+    LogSpec spec = {NULL, 0, ARG_UNSUPPORTED};
+    
+    p++;
+    while (*p != '\0' && strchr("-+ #0'", *p) != NULL) {
+        p++;
+    }
+    for (int field = 0; field < 2; field++) {
+        // Width, then precision
+        if (field == 1) {
+            if (*p != '.') {
+                break;
+            }
+            p++;
+        }
+        if (*p == '*') {
+            spec.stars++;
+            p++;
+        }
+        while (*p >= '0' && *p <= '9') {
+            p++;
+        }
+    }
+    
+    int longs = 0;
+    char size = 0;
+    for (; *p != '\0' && strchr("hlzjtL", *p) != NULL; p++) {
+        longs += *p == 'l';
+        size = *p;
+    }
+    
+    spec.end = *p != '\0' ? p + 1 : p;
+    switch (*p) {
+        case '%':
+            spec.type = ARG_NONE;
+            break;
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+            spec.type = longs >= 2 ? ARG_LONG_LONG : longs == 1 ? ARG_LONG :
+                        size == 'z' ? ARG_SIZE : size == 'j' ? ARG_INTMAX :
+                        size == 't' ? ARG_PTRDIFF : size == 'L' ? ARG_UNSUPPORTED : ARG_INT;
+            if (*p == 'c' && longs > 0) {
+                spec.type = ARG_UNSUPPORTED;
+            }
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            spec.type = size == 'L' ? ARG_UNSUPPORTED : ARG_DOUBLE;
+            break;
+        case 's':
+            spec.type = longs > 0 ? ARG_UNSUPPORTED : ARG_STRING;
+            break;
+        case 'p':
+            spec.type = ARG_POINTER;
+            break;
+        default:
+            break;
+    }
+    return spec;
+}
+
+// Copy the arguments a format reads into a slot; false if the format uses a
+// conversion the writer cannot replay or more than LOG_MAX_ARGS words
+static bool capture_args(LogSlot *slot, const char *format, va_list *args) {
+    int count = 0;
+    size_t used = 0;
+    
+    for (const char *p = strchr(format, '%'); p != NULL; ) {
+        LogSpec spec = parse_spec(p);
+        p = strchr(spec.end, '%');
+        if (spec.type == ARG_NONE) {
+            continue;
+        }
+        if (spec.type == ARG_UNSUPPORTED || count + spec.stars + 1 > LOG_MAX_ARGS) {
+            return false;
+        }
+        
+        for (int i = 0; i < spec.stars; i++) {
+            slot->args[count++].integer = va_arg(*args, int);
+        }
+        LogArg *arg = &slot->args[count++];
+        switch (spec.type) {
+            case ARG_INT:       arg->integer = va_arg(*args, int); break;
+            case ARG_LONG:      arg->integer = va_arg(*args, long); break;
+            case ARG_LONG_LONG: arg->integer = va_arg(*args, long long); break;
+            case ARG_SIZE:      arg->integer = (long long)va_arg(*args, size_t); break;
+            case ARG_INTMAX:    arg->integer = va_arg(*args, intmax_t); break;
+            case ARG_PTRDIFF:   arg->integer = va_arg(*args, ptrdiff_t); break;
+            case ARG_DOUBLE:    arg->real = va_arg(*args, double); break;
+            case ARG_POINTER:   arg->pointer = va_arg(*args, void*); break;
+            case ARG_STRING:
+            default: {
+                // Strings are copied NUL-terminated into text, truncated to fit
+                const char *string = va_arg(*args, const char*);
+                size_t length = string != NULL ? strlen(string) : 0;
+                size_t room = sizeof(slot->text) - used;
+                if (length >= room) {
+                    length = room > 0 ? room - 1 : 0;
+                }
+                arg->integer = room > 0 ? (long long)used : -1;
+                if (room > 0) {
+                    memcpy(slot->text + used, string != NULL ? string : "", length);
+                    slot->text[used + length] = '\0';
+                    used += length + 1;
+                }
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+// Format one conversion with its captured argument
+static int format_arg(char *out, size_t size, const char *conversion, 
+                      LogArgType type, const LogArg *arg, const char *strings) {
+    switch (type) {
+        case ARG_INT:       return snprintf(out, size, conversion, (int)arg->integer);
+        case ARG_LONG:      return snprintf(out, size, conversion, (long)arg->integer);
+        case ARG_LONG_LONG: return snprintf(out, size, conversion, arg->integer);
+        case ARG_SIZE:      return snprintf(out, size, conversion, (size_t)arg->integer);
+        case ARG_INTMAX:    return snprintf(out, size, conversion, (intmax_t)arg->integer);
+        case ARG_PTRDIFF:   return snprintf(out, size, conversion, (ptrdiff_t)arg->integer);
+        case ARG_DOUBLE:    return snprintf(out, size, conversion, arg->real);
+        case ARG_POINTER:   return snprintf(out, size, conversion, arg->pointer);
+        case ARG_STRING:
+        default:
+            return snprintf(out, size, conversion, 
+                            arg->integer >= 0 ? strings + arg->integer : "");
+    }
+}
+
+// Format an entry's message into out (at most size - 1 characters)
+static size_t format_entry(const LogSlot *slot, char *out, size_t size) {
+    if (slot->format == NULL) {
+        size_t length = strnlen(slot->text, size - 1);
+        memcpy(out, slot->text, length);
+        out[length] = '\0';
+        return length;
+    }
+    
+    size_t length = 0;
+    int count = 0;
+    const char *p = slot->format;
+    while (*p != '\0' && length < size - 1) {
+        const char *percent = strchr(p, '%');
+        size_t literal = percent != NULL ? (size_t)(percent - p) : strlen(p);
+        if (literal > size - 1 - length) {
+            literal = size - 1 - length;
+        }
+        memcpy(out + length, p, literal);
+        length += literal;
+        if (percent == NULL || length >= size - 1) {
+            break;
+        }
+        
+        LogSpec spec = parse_spec(percent);
+        p = spec.end;
+        if (spec.type == ARG_NONE) {
+            out[length++] = '%';
+            continue;
+        }
+        
+        // Rebuild the conversion with each '*' replaced by its captured value
+        char conversion[64];
+        size_t n = 0;
+        for (const char *c = percent; c < spec.end && n < sizeof(conversion) - 16; c++) {
+            if (*c == '*') {
+                n += (size_t)snprintf(conversion + n, sizeof(conversion) - n, "%d",
+                                      (int)slot->args[count++].integer);
+            } else {
+                conversion[n++] = *c;
+            }
+        }
+        conversion[n] = '\0';
+        
+        int written = format_arg(out + length, size - length, conversion, spec.type,
+                                 &slot->args[count++], slot->text);
+        if (written > 0) {
+            length += (size_t)written < size - length ? (size_t)written : size - 1 - length;
+        }
+    }
+    out[length] = '\0';
+    return length;
+}
+
+
+// WRITER THREAD
+
+
+// Write a whole buffer, retrying short writes
+static void write_all(int fd, const char *buffer, size_t length) {
+    while (fd >= 0 && length > 0) {
+        ssize_t n = write(fd, buffer, length);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        buffer += n;
+        length -= (size_t)n;
+    }
+}
+
+// Send a batch to every output
+static void write_batch(const char *buffer, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    
+    if (ring.console_fd == STDOUT_FILENO) {
+        fflush(stdout);  // Keep earlier printf output ahead of the batch
+    }
+    write_all(ring.console_fd, buffer, length);
+    write_all(ring.file_fd, buffer, length);
+}
+
+// Format and write every filled entry; returns the number written
+static size_t drain_ring(void) {
+    static char batch[LOG_BATCH_BYTES];
+    static char timestamp[64];
+    static time_t timestamp_second = (time_t)-1;
+    size_t length = 0;
+    size_t count = 0;
+    
+    for (;;) {
+        LogSlot *slot = &ring.slots[ring.tail & LOG_RING_MASK];
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_SEQ_CST) != ring.tail + 1) {
+            break;
+        }
+    
+        // Format the timestamp once per second rather than once per entry
+        if (slot->timestamp != timestamp_second) {
+            struct tm tm_info;
+            localtime_r(&slot->timestamp, &tm_info);
+            strftime(timestamp, sizeof(timestamp), "[%a %b %d %H:%M:%S %Y]", &tm_info);
+            timestamp_second = slot->timestamp;
+        }
+    
+        if (sizeof(batch) - length < sizeof(timestamp) + MAX_LOG_MSG + 16) {
+            write_batch(batch, length);
+            length = 0;
+        }
+        length += (size_t)snprintf(batch + length, sizeof(batch) - length, "%s [%s] ",
+                                   timestamp, level_names[slot->level]);
+        length += format_entry(slot, batch + length, MAX_LOG_MSG);
+        batch[length++] = '\n';
+    
+        // Hand the slot back to the producer that will claim it next lap
+        __atomic_store_n(&slot->sequence, ring.tail + LOG_RING_CAPACITY, __ATOMIC_RELEASE);
+        ring.tail++;
+        count++;
+    }
+    
+    write_batch(batch, length);
+    return count;
+}
+
+// Writer thread: drain, then sleep until woken or the period elapses
+static void* writer_main(void *arg) {
+    (void)arg;
+    
+    for (;;) {
+        size_t count = drain_ring();
+    
+        pthread_mutex_lock(&ring.mutex);
+        if (count > 0) {
+            __atomic_store_n(&ring.written, ring.tail, __ATOMIC_RELEASE);
+            pthread_cond_broadcast(&ring.flushed);
+            pthread_mutex_unlock(&ring.mutex);
+            continue;
+        }
+        if (ring.stopping) {
+            pthread_mutex_unlock(&ring.mutex);
+            break;
+        }
+    
+        // Re-check after announcing the sleep so a producer that missed the
+        // flag has its entry seen here
+        __atomic_store_n(&ring.writer_idle, true, __ATOMIC_SEQ_CST);
+        LogSlot *next = &ring.slots[ring.tail & LOG_RING_MASK];
+        if (__atomic_load_n(&next->sequence, __ATOMIC_SEQ_CST) != ring.tail + 1) {
+            struct timespec until;
+            clock_gettime(CLOCK_MONOTONIC, &until);
+            until.tv_nsec += LOG_WRITER_PERIOD_MS * 1000000L;
+            if (until.tv_nsec >= 1000000000L) {
+                until.tv_sec++;
+                until.tv_nsec -= 1000000000L;
+            }
+            pthread_cond_timedwait(&ring.wake, &ring.mutex, &until);
+        }
+        __atomic_store_n(&ring.writer_idle, false, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&ring.mutex);
+    }
+    
+    return NULL;
+}
+
+// Wake the writer if it is sleeping
+static void wake_writer(void) {
+    if (__atomic_load_n(&ring.writer_idle, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&ring.mutex);
+        pthread_cond_signal(&ring.wake);
+        pthread_mutex_unlock(&ring.mutex);
+    }
+}
+
+
+// LOG RING API
+
+
+// Start the writer thread; entries go to each fd that is not -1
+int log_ring_start(int console_fd, int file_fd) {
+    if (is_active) {
+        return SUCCESS;
+    }
+    
+    for (size_t i = 0; i < LOG_RING_CAPACITY; i++) {
+        ring.slots[i].sequence = i;
+    }
+    ring.head = 0;
+    ring.tail = 0;
+    ring.written = 0;
+    ring.dropped = 0;
+    ring.callers = 0;
+    ring.console_fd = console_fd;
+    ring.file_fd = file_fd;
+    ring.writer_idle = false;
+    ring.stopping = false;
+    
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_mutex_init(&ring.mutex, NULL);
+    pthread_cond_init(&ring.wake, &cond_attr);
+    pthread_cond_init(&ring.flushed, NULL);
+    pthread_condattr_destroy(&cond_attr);
+    
+    if (pthread_create(&ring.writer, NULL, writer_main, NULL) != 0) {
+        pthread_cond_destroy(&ring.wake);
+        pthread_cond_destroy(&ring.flushed);
+        pthread_mutex_destroy(&ring.mutex);
+        return ERROR;
+    }
+    
+    __atomic_store_n(&is_active, true, __ATOMIC_RELEASE);
+    return SUCCESS;
+}
+
+// Drain every queued entry, then stop the writer thread
+void log_ring_stop(void) {
+    if (!is_active) {
+        return;
+    }
+    
+    // New entries take the synchronous path from here on; callers that saw
+    // the ring running still finish their entry and may touch the mutex
+    __atomic_store_n(&is_active, false, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&ring.callers, __ATOMIC_SEQ_CST) > 0) {
+        sched_yield();
+    }
+    
+    pthread_mutex_lock(&ring.mutex);
+    ring.stopping = true;
+    pthread_cond_signal(&ring.wake);
+    pthread_mutex_unlock(&ring.mutex);
+    pthread_join(ring.writer, NULL);
+    
+    pthread_cond_destroy(&ring.wake);
+    pthread_cond_destroy(&ring.flushed);
+    pthread_mutex_destroy(&ring.mutex);
+}
+
+// Check whether entries are being queued for the writer thread
+bool log_ring_active(void) {
+    return __atomic_load_n(&is_active, __ATOMIC_ACQUIRE);
+}
+
+// Register a push or flush; false if the ring is not running. A caller that
+// gets true keeps log_ring_stop() waiting until it calls leave_ring().
+static bool enter_ring(void) {
+    __atomic_fetch_add(&ring.callers, 1, __ATOMIC_SEQ_CST);
+    if (!__atomic_load_n(&is_active, __ATOMIC_SEQ_CST)) {
+        __atomic_fetch_sub(&ring.callers, 1, __ATOMIC_SEQ_CST);
+        return false;
+    }
+    return true;
+}
+
+// Finish a push or flush started with enter_ring()
+static void leave_ring(void) {
+    __atomic_fetch_sub(&ring.callers, 1, __ATOMIC_RELEASE);
+}
+
+// Queue an entry, unless the ring is full or not running
+LogPushResult log_ring_push(int level, const char *format, va_list args) {
+    if (!enter_ring()) {
+        return LOG_PUSH_STOPPED;
+    }
+    
+    size_t position = __atomic_load_n(&ring.head, __ATOMIC_RELAXED);
+    LogSlot *slot;
+    
+    for (;;) {
+        slot = &ring.slots[position & LOG_RING_MASK];
+        size_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        intptr_t diff = (intptr_t)sequence - (intptr_t)position;
+    
+        if (diff == 0) {
+            // Slot free for this position: claim it
+            if (__atomic_compare_exchange_n(&ring.head, &position, position + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Full: the writer has not yet freed this slot from the last lap
+            if (level != LOG_LEVEL_ERROR) {
+                __atomic_fetch_add(&ring.dropped, 1, __ATOMIC_RELAXED);
+                leave_ring();
+                return LOG_PUSH_DROPPED;
+            }
+            wake_writer();
+            sched_yield();
+            position = __atomic_load_n(&ring.head, __ATOMIC_RELAXED);
+        } else {
+            // Another producer claimed this position first
+            position = __atomic_load_n(&ring.head, __ATOMIC_RELAXED);
+        }
+    }
+    
+    slot->timestamp = time(NULL);
+    slot->level = level;
+    slot->format = format;
+    
+    // Formats the writer cannot replay are formatted here instead
+    va_list captured;
+    va_copy(captured, args);
+    if (!capture_args(slot, format, &captured)) {
+        slot->format = NULL;
+        vsnprintf(slot->text, sizeof(slot->text), format, args);
+    }
+    va_end(captured);
+    __atomic_store_n(&slot->sequence, position + 1, __ATOMIC_SEQ_CST);
+    
+    // The writer drains on a timer; only errors and a filling ring wake it now
+    if (level == LOG_LEVEL_ERROR ||
+        position - __atomic_load_n(&ring.written, __ATOMIC_RELAXED) >= LOG_WAKE_THRESHOLD) {
+        wake_writer();
+    }
+    leave_ring();
+    return LOG_PUSH_QUEUED;
+}
+
+// Block until every entry queued so far has been written
+void log_ring_flush(void) {
+    if (!enter_ring()) {
+        return;
+    }
+    
+    size_t target = __atomic_load_n(&ring.head, __ATOMIC_ACQUIRE);
+    pthread_mutex_lock(&ring.mutex);
+    while (__atomic_load_n(&ring.written, __ATOMIC_ACQUIRE) < target) {
+        pthread_cond_signal(&ring.wake);
+        pthread_cond_wait(&ring.flushed, &ring.mutex);
+    }
+    pthread_mutex_unlock(&ring.mutex);
+    leave_ring();
+}
+
+// Entries dropped because the ring was full
+long log_ring_dropped(void) {
+    return __atomic_load_n(&ring.dropped, __ATOMIC_RELAXED);
+}
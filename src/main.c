@@ -3,17 +3,92 @@
 #include "../include/battery_monitor.h"
 #include "../include/task_manager.h"
 #include "../include/utils.h"
+#include "../include/trace.h"
+#include "../include/workload.h"
+#include "../include/replay.h"
+#include "../include/sweep.h"
+#include "../include/montecarlo.h"
 #include <stdio.h>
 #include <stdlib.h>
 
+// Algorithms compared by run_simulation()
+#define NUM_ALGORITHMS 8
+
 // FUNCTION DECLARATIONS
 
 
 void print_banner(void);
 void print_menu(void);
 void create_sample_tasks(void);
+void admit_sample_tasks(SchedContext *ctx);
 void run_simulation(void);
+int run_sweep(const char *spec_text);
+int run_monte_carlo(long max_replicas);
 void interactive_mode(void);
+int parse_log_level(const char *name);
+
+// Algorithms compared by run_simulation() and run_monte_carlo(), in order
+static const char *algo_names[NUM_ALGORITHMS] = {
+    "BATTERY-AWARE",
+    "FCFS",
+    "SJF",
+    "PRIORITY",
+    "ROUND ROBIN",
+    "EDF",
+    "ENERGY-AWARE EDF",
+    "FAIR (CFS)"
+};
+static const SchedulerAlgorithm algorithms[NUM_ALGORITHMS] = {
+    SCHEDULER_BATTERY_AWARE,
+    SCHEDULER_FCFS,
+    SCHEDULER_SJF,
+    SCHEDULER_PRIORITY,
+    SCHEDULER_ROUND_ROBIN,
+    SCHEDULER_EDF,
+    SCHEDULER_ENERGY_EDF,
+    SCHEDULER_CFS
+};
+
+// Clock used by run_simulation(); --wall-clock restores real-time sleeping
+static ClockMode simulation_clock = CLOCK_MODE_VIRTUAL;
+
+// --trace: record a binary event trace (one file per simulation run)
+static bool trace_runs = false;
+
+// --workload=N: stream N generated tasks instead of the sample tasks;
+// --seed=S picks the workload
+static long workload_tasks = 0;
+static uint64_t workload_seed = 1;
+
+// --replay=FILE: stream a recorded workload (CSV or binary) instead
+static const char *replay_path = NULL;
+
+// --jobs=N: simulation runs at a time (0 = one per processor)
+static int simulation_jobs = 0;
+
+// --sweep-out=FILE: sweep results table (JSON if it ends in .json)
+static const char *sweep_output = "output/sweep_results.csv";
+
+// --replicas=N: Monte Carlo comparison over up to N workload seeds per
+// algorithm (generated workloads of --workload tasks, default below)
+#define MC_DEFAULT_TASKS 200
+static long monte_carlo_replicas = 0;
+
+// One run of the comparison and what it measured
+typedef struct {
+    const char *name;
+    SchedulerAlgorithm algorithm;
+    int number;                     // Run number (1-based; names the trace file)
+    int final_battery;
+    int tasks_completed;
+    int context_switches;
+    long energy_consumed;
+    float cpu_utilization;
+    int missed_deadlines;
+    int tasks_dropped;
+    LatencyStats latency;           // Latency distributions of the run
+    char *profile;                  // Phase timings (PROFILE builds), or NULL
+} SimulationRun;
 
 
 // MAIN FUNCTION
@@ -21,36 +96,87 @@ void interactive_mode(void);
 
 int main(int argc, char *argv[]) {
     print_banner();
+    
+    // Check command line arguments
+    bool simulate = false;
+    const char *sweep_spec = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--simulate") == 0) {
+            simulate = true;
+        } else if (strncmp(argv[i], "--sweep=", 8) == 0) {
+            sweep_spec = argv[i] + 8;
+        } else if (strncmp(argv[i], "--sweep-out=", 12) == 0) {
+            sweep_output = argv[i] + 12;
+        } else if (strcmp(argv[i], "--wall-clock") == 0) {
+            simulation_clock = CLOCK_MODE_WALL;
+        } else if (strcmp(argv[i], "--trace") == 0) {
+            trace_runs = true;
+        } else if (strncmp(argv[i], "--workload=", 11) == 0) {
+            workload_tasks = atol(argv[i] + 11);
+        } else if (strncmp(argv[i], "--seed=", 7) == 0) {
+            workload_seed = strtoull(argv[i] + 7, NULL, 10);
+        } else if (strncmp(argv[i], "--replay=", 9) == 0) {
+            replay_path = argv[i] + 9;
+        } else if (strncmp(argv[i], "--replicas=", 11) == 0) {
+            monte_carlo_replicas = atol(argv[i] + 11);
+        } else if (strncmp(argv[i], "--jobs=", 7) == 0) {
+            simulation_jobs = atoi(argv[i] + 7);
+        } else if (strncmp(argv[i], "--log-level=", 12) == 0) {
+            set_log_level(parse_log_level(argv[i] + 12));
+        }
+    }
+    
     init_logging(); 
-
+    
     // Initialize scheduler with battery-aware algorithm
     if (scheduler_init(SCHEDULER_BATTERY_AWARE) != SUCCESS) {
-        log_error("Failed to initialize scheduler");
+        LOG_ERROR("Failed to initialize scheduler");
+        close_logging();
         return EXIT_FAILURE;
     }
     
-    log_info("Battery-Aware Scheduler System Started");
+    LOG_INFO("Battery-Aware Scheduler System Started");
     
-    // Check command line arguments
-    if (argc > 1 && strcmp(argv[1], "--simulate") == 0) {
+    int status = EXIT_SUCCESS;
+    if (sweep_spec != NULL) {
+        // Run the workload under every configuration of the sweep
+        status = run_sweep(sweep_spec) == SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+    } else if (simulate && monte_carlo_replicas > 0) {
+        // Compare the algorithms over many workload seeds
+        status = run_monte_carlo(monte_carlo_replicas) == SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE;
+    } else if (simulate) {
         // Run automatic simulation
         run_simulation();
     } else {
         // Run interactive mode
+        if (trace_runs) {
+            trace_open("output/trace.bin", TRACE_DEFAULT_CAPACITY);
+        }
         interactive_mode();
+        trace_close();
     }
     
     // Cleanup
     scheduler_cleanup();
     close_logging();  // ADD THIS LINE
-    log_info("Battery-Aware Scheduler System Shutdown");
-    return EXIT_SUCCESS;
+    LOG_INFO("Battery-Aware Scheduler System Shutdown");
+    return status;
 }
 
 
 // HELPER FUNCTIONS
 
 
+// Log level from its name ("error", "info" or "debug"; default debug)
+int parse_log_level(const char *name) {
+    if (strcmp(name, "error") == 0) {
+        return LOG_LEVEL_ERROR;
+    } else if (strcmp(name, "info") == 0) {
+        return LOG_LEVEL_INFO;
+    }
+    return LOG_LEVEL_DEBUG;
+}
+
 // Print banner
 void print_banner(void) {
     printf("\n");
@@ -63,6 +189,7 @@ void print_banner(void) {
 
 // Print menu
 void print_menu(void) {
+    log_flush();  // Let queued log lines finish before the prompt
     printf("\n=== MENU ===\n");
     printf("1. Create Sample Tasks\n");
     printf("2. Add Custom Task\n");
@@ -80,52 +207,135 @@ void print_menu(void) {
     printf("Enter choice: ");
 }
 
-// Create sample tasks for testing
-void create_sample_tasks(void) {
-    log_info("Creating sample tasks...");
+// Admit the sample tasks to a scheduler context
+void admit_sample_tasks(SchedContext *ctx) {
+    LOG_INFO("Creating sample tasks...");
     
     // Critical low-energy task
-    Task *task1 = create_task("System Monitor", PRIORITY_HIGH, ENERGY_LOW, 
-                              500, true, 5000);
-    admit_task_to_scheduler(task1);
+    Task *task1 = create_task_ctx(ctx, "System Monitor", PRIORITY_HIGH, ENERGY_LOW, 
+                                   500, true, 5000);
+    admit_task_to_scheduler_ctx(ctx, task1);
     
     // High priority medium energy task
-    Task *task2 = create_task("File Sync", PRIORITY_HIGH, ENERGY_MEDIUM, 
-                              800, false, 10000);
-    admit_task_to_scheduler(task2);
+    Task *task2 = create_task_ctx(ctx, "File Sync", PRIORITY_HIGH, ENERGY_MEDIUM, 
+                                   800, false, 10000);
+    admit_task_to_scheduler_ctx(ctx, task2);
     
     // Medium priority low energy task
-    Task *task3 = create_task("Log Writer", PRIORITY_MEDIUM, ENERGY_LOW, 
-                              300, false, 8000);
-    admit_task_to_scheduler(task3);
+    Task *task3 = create_task_ctx(ctx, "Log Writer", PRIORITY_MEDIUM, ENERGY_LOW, 
+                                   300, false, 8000);
+    admit_task_to_scheduler_ctx(ctx, task3);
     
     // Low priority high energy task
-    Task *task4 = create_task("Video Processing", PRIORITY_LOW, ENERGY_HIGH, 
-                              1200, false, 20000);
-    admit_task_to_scheduler(task4);
+    Task *task4 = create_task_ctx(ctx, "Video Processing", PRIORITY_LOW, ENERGY_HIGH, 
+                                   1200, false, 20000);
+    admit_task_to_scheduler_ctx(ctx, task4);
     
     // Medium priority medium energy task
-    Task *task5 = create_task("Network Sync", PRIORITY_MEDIUM, ENERGY_MEDIUM, 
-                              600, false, 12000);
-    admit_task_to_scheduler(task5);
+    Task *task5 = create_task_ctx(ctx, "Network Sync", PRIORITY_MEDIUM, ENERGY_MEDIUM, 
+                                   600, false, 12000);
+    admit_task_to_scheduler_ctx(ctx, task5);
     
     // Critical high energy task
-    Task *task6 = create_task("Emergency Backup", PRIORITY_HIGH, ENERGY_HIGH, 
-                              1000, true, 15000);
-    admit_task_to_scheduler(task6);
+    Task *task6 = create_task_ctx(ctx, "Emergency Backup", PRIORITY_HIGH, ENERGY_HIGH, 
+                                   1000, true, 15000);
+    admit_task_to_scheduler_ctx(ctx, task6);
     
     // Low priority low energy task
-    Task *task7 = create_task("Cache Cleanup", PRIORITY_LOW, ENERGY_LOW, 
-                              400, false, 30000);
-    admit_task_to_scheduler(task7);
+    Task *task7 = create_task_ctx(ctx, "Cache Cleanup", PRIORITY_LOW, ENERGY_LOW, 
+                                   400, false, 30000);
+    admit_task_to_scheduler_ctx(ctx, task7);
     
     // Medium priority task
-    Task *task8 = create_task("Data Analysis", PRIORITY_MEDIUM, ENERGY_MEDIUM, 
-                              700, false, 18000);
-    admit_task_to_scheduler(task8);
+    Task *task8 = create_task_ctx(ctx, "Data Analysis", PRIORITY_MEDIUM, ENERGY_MEDIUM, 
+                                   700, false, 18000);
+    admit_task_to_scheduler_ctx(ctx, task8);
     
+    LOG_INFO("Sample tasks created successfully");
+}
+
+// Create sample tasks for testing
+void create_sample_tasks(void) {
+    admit_sample_tasks(sched_default_context());
     printf("Created 8 sample tasks with varying priorities and energy costs\n");
-    log_info("Sample tasks created successfully");
+}
+
+// Run the simulation workload to the end on an initialized context: the
+// sample tasks, or a recorded or generated workload admitted as its tasks
+// arrive (every run with the same seed sees the same tasks)
+static void run_workload(SchedContext *ctx, long task_count, uint64_t seed) {
+    WorkloadGenerator generator;
+    WorkloadStream stream;
+    WorkloadReplay replay;
+    bool replaying = replay_path != NULL && replay_open(&replay, replay_path) == SUCCESS;
+    if (replaying) {
+        workload_stream_start_ctx(ctx, &stream, replay_next, &replay);
+    } else if (task_count > 0) {
+        WorkloadConfig config;
+        workload_default_config(&config);
+        config.task_count = task_count;
+        config.seed = seed;
+        workload_init(&generator, &config);
+        workload_stream_start_ctx(ctx, &stream, workload_next, &generator);
+    } else {
+        admit_sample_tasks(ctx);
+    }
+    
+    scheduler_start_ctx(ctx);
+    scheduler_run_loop_ctx(ctx);
+    scheduler_stop_ctx(ctx);
+    if (replaying) {
+        replay_close(&replay);
+    }
+}
+
+// Run one simulation on a scheduler context of its own
+static void simulate_run(int index, void *context) {
+    SimulationRun *run = &((SimulationRun*)context)[index];
+    
+    // The trace records the default context, so traced runs use it (one
+    // at a time); other runs are isolated and can run side by side
+    SchedContext *ctx;
+    if (trace_runs) {
+        ctx = sched_default_context();
+        scheduler_cleanup();
+        reset_virtual_clock();
+        char trace_path[64];
+        snprintf(trace_path, sizeof(trace_path), "output/trace_run%d.bin", run->number);
+        trace_open(trace_path, TRACE_DEFAULT_CAPACITY);
+    } else {
+        ctx = sched_context_create(simulation_clock);
+    }
+    scheduler_init_ctx(ctx, run->algorithm);
+    
+    run_workload(ctx, workload_tasks, workload_seed);
+    trace_close();
+    
+    // Collect results
+    SchedulerStats *stats_ptr = get_scheduler_statistics_ctx(ctx);
+    TaskStats *task_stats = get_task_statistics_ctx(ctx);
+    run->final_battery = get_battery_level_ctx(ctx);
+    run->tasks_completed = stats_ptr->tasks_completed;
+    run->context_switches = stats_ptr->context_switches;
+    run->energy_consumed = stats_ptr->total_energy_consumed;
+    run->cpu_utilization = stats_ptr->cpu_utilization;
+    run->missed_deadlines = task_stats->missed_deadlines;
+    run->tasks_dropped = stats_ptr->tasks_dropped;
+    run->latency = task_stats->latency;
+    
+    run->profile = NULL;
+    if (SCHED_PROFILE) {
+        size_t length;
+        FILE *profile = open_memstream(&run->profile, &length);
+        if (profile != NULL) {
+            print_phase_timings_ctx(ctx, profile);
+            fclose(profile);
+        }
+    }
+    
+    if (ctx != sched_default_context()) {
+        sched_context_destroy(ctx);
+    }
 }
 
 // Run comparison between battery-aware and standard scheduling
@@ -143,66 +353,54 @@ void run_simulation(void) {
     fprintf(comparison_file, "BATTERY-AWARE SCHEDULER - COMPARISON RESULTS\n");
     fprintf(comparison_file, "=============================================\n\n");
     
-    // Store results for all algorithms
-    typedef struct {
-        int final_battery;
-        int tasks_completed;
-        int context_switches;
-        long energy_consumed;
-        float cpu_utilization;
-    } AlgorithmResults;
-    
-    AlgorithmResults results[4];  // 4 algorithms
-    const char *algo_names[] = {
-        "BATTERY-AWARE",
-        "FCFS",
-        "SJF",
-        "ROUND ROBIN"
-    };
-    SchedulerAlgorithm algorithms[] = {
-        SCHEDULER_BATTERY_AWARE,
-        SCHEDULER_FCFS,
-        SCHEDULER_SJF,
-        SCHEDULER_ROUND_ROBIN
-    };
-    
-    // Run all 4 algorithms
-    for (int i = 0; i < 4; i++) {
+    // Run every algorithm on the same timeline; virtual time skips the sleeps
+    ClockMode previous_clock = get_clock_mode();
+    set_clock_mode(simulation_clock);
+    
+    // Runs are independent, so they share out over the processors (latency
+    // histograms make each run large, hence the heap)
+    SimulationRun *results = (SimulationRun*)safe_malloc(sizeof(SimulationRun) * NUM_ALGORITHMS);
+    for (int i = 0; i < NUM_ALGORITHMS; i++) {
+        results[i].name = algo_names[i];
+        results[i].algorithm = algorithms[i];
+        results[i].number = i + 1;
+    }
+    int jobs = trace_runs ? 1 : simulation_jobs > 0 ? simulation_jobs : online_cpu_count();
+    
+    log_flush();
+    printf("--- Running %d simulations on %d thread%s ---\n", NUM_ALGORITHMS, jobs, jobs == 1 ? "" : "s");
+    int64_t started_ns = get_monotonic_ns();
+    run_parallel(simulate_run, NUM_ALGORITHMS, results, jobs);
+    double elapsed_ms = (double)(get_monotonic_ns() - started_ns) / NS_PER_MS;
+    
+    // Report the runs in order
+    for (int i = 0; i < NUM_ALGORITHMS; i++) {
+        // Log lines are written by a background thread; keep them in order
+        // with the report printed here
+        log_flush();
         printf("\n[RUN %d] %s SCHEDULING\n", i+1, algo_names[i]);
         printf("================================\n");
         fprintf(comparison_file, "[RUN %d] %s SCHEDULING\n", i+1, algo_names[i]);
         fprintf(comparison_file, "================================\n");
         
-        // Initialize with current algorithm
-        if (i > 0) scheduler_cleanup();  // Clean up previous run
-        scheduler_init(algorithms[i]);
-        
-        // Create same tasks for fair comparison
-        create_sample_tasks();
-        
-        printf("--- Running Scheduler ---\n");
-        scheduler_start();
-        scheduler_run_loop();
-        scheduler_stop();
-        
-        // Collect results
-        results[i].final_battery = get_battery_level();
-        SchedulerStats *stats_ptr = get_scheduler_statistics();
-
-        results[i].tasks_completed = stats_ptr->tasks_completed;
-        results[i].context_switches = stats_ptr->context_switches;
-        results[i].energy_consumed = stats_ptr->total_energy_consumed;
-        results[i].cpu_utilization = stats_ptr->cpu_utilization;
-        
         // Save to file
         fprintf(comparison_file, "Final Battery Level: %d%%\n", results[i].final_battery);
         fprintf(comparison_file, "Tasks Completed: %d\n", results[i].tasks_completed);
         fprintf(comparison_file, "Context Switches: %d\n", results[i].context_switches);
         fprintf(comparison_file, "Energy Consumed: %ld units\n", results[i].energy_consumed);
+        fprintf(comparison_file, "Missed Deadlines: %d\n", results[i].missed_deadlines);
+        fprintf(comparison_file, "Tasks Dropped: %d\n", results[i].tasks_dropped);
         fprintf(comparison_file, "CPU Utilization: %.2f%%\n\n", results[i].cpu_utilization);
+        print_latency_stats(comparison_file, &results[i].latency);
+        fprintf(comparison_file, "\n");
+        if (results[i].profile != NULL) {
+            fprintf(comparison_file, "%s\n", results[i].profile);
+            free(results[i].profile);
+        }
         
         printf("✓ %s completed\n", algo_names[i]);
     }
+    printf("\nAll %d runs finished in %.1f ms of wall time\n", NUM_ALGORITHMS, elapsed_ms);
     
     // ===== COMPARISON TABLE =====
     printf("\n========================================\n");
@@ -214,40 +412,68 @@ void run_simulation(void) {
     fprintf(comparison_file, "========================================\n\n");
     
     // Table header
-    printf("┌────────────────────┬──────────┬──────┬─────┬──────────┐\n");
-    printf("│ Algorithm          │ Battery  │ Energy│ Tasks│ Switches │\n");
-    printf("├────────────────────┼──────────┼──────┼─────┼──────────┤\n");
+    printf("┌────────────────────┬──────────┬──────┬─────┬──────────┬────────┬─────────┐\n");
+    printf("│ Algorithm          │ Battery  │ Energy│ Tasks│ Switches │ Missed │ Dropped │\n");
+    printf("├────────────────────┼──────────┼──────┼─────┼──────────┼────────┼─────────┤\n");
     
     fprintf(comparison_file, "Algorithm Comparison:\n");
     fprintf(comparison_file, "---------------------\n");
     
     // Print each algorithm's results
-    for (int i = 0; i < 4; i++) {
-        printf("│ %-18s │ %3d%%     │ %4ld │ %3d │ %8d │\n",
+    for (int i = 0; i < NUM_ALGORITHMS; i++) {
+        printf("│ %-18s │ %3d%%     │ %4ld │ %3d │ %8d │ %6d │ %7d │\n",
                algo_names[i],
                results[i].final_battery,
                results[i].energy_consumed,
                results[i].tasks_completed,
-               results[i].context_switches);
+               results[i].context_switches,
+               results[i].missed_deadlines,
+               results[i].tasks_dropped);
         
-        fprintf(comparison_file, "%s: Battery=%d%%, Energy=%ld, Tasks=%d, Switches=%d\n",
+        fprintf(comparison_file, 
+                "%s: Battery=%d%%, Energy=%ld, Tasks=%d, Switches=%d, Missed=%d, Dropped=%d\n",
                 algo_names[i],
                 results[i].final_battery,
                 results[i].energy_consumed,
                 results[i].tasks_completed,
-                results[i].context_switches);
+                results[i].context_switches,
+                results[i].missed_deadlines,
+                results[i].tasks_dropped);
     }
     
-    printf("└────────────────────┴──────────┴──────┴─────┴──────────┘\n");
+    printf("└────────────────────┴──────────┴──────┴─────┴──────────┴────────┴─────────┘\n");
+    
+    // ===== RESPONSE TIME PERCENTILES =====
+    const char *latency_titles[] = {"Response (ms)", "Critical response (ms)"};
+    for (int table = 0; table < 2; table++) {
+        Histogram all_runs;
+        histogram_init(&all_runs);
+        
+        printf("\n");
+        fprintf(comparison_file, "\n");
+        histogram_print_header(stdout, latency_titles[table]);
+        histogram_print_header(comparison_file, latency_titles[table]);
+        for (int i = 0; i < NUM_ALGORITHMS; i++) {
+            LatencyStats *latency = &results[i].latency;
+            Histogram *row = table == 0 ? &latency->all[LATENCY_RESPONSE] :
+                             &latency->critical[LATENCY_RESPONSE];
+            histogram_print_row(stdout, algo_names[i], row, NS_PER_MS);
+            histogram_print_row(comparison_file, algo_names[i], row, NS_PER_MS);
+            histogram_merge(&all_runs, row);
+        }
+        histogram_print_row(stdout, "ALL RUNS", &all_runs, NS_PER_MS);
+        histogram_print_row(comparison_file, "ALL RUNS", &all_runs, NS_PER_MS);
+    }
     
     // ===== ENERGY SAVINGS ANALYSIS =====
     printf("\n--- Energy Savings vs FCFS ---\n");
     fprintf(comparison_file, "\nEnergy Savings vs FCFS:\n");
     
-    long fcfs_energy = results[1].energy_consumed;
+    int fcfs = 1;
+    long fcfs_energy = results[fcfs].energy_consumed;
     
-    for (int i = 0; i < 4; i++) {
-        if (i == 1) continue;  // Skip FCFS itself
+    for (int i = 0; i < NUM_ALGORITHMS; i++) {
+        if (i == fcfs) continue;  // Skip FCFS itself
         
         long energy_saved = fcfs_energy - results[i].energy_consumed;
         float savings_percent = (float)energy_saved / fcfs_energy * 100.0f;
@@ -265,7 +491,7 @@ void run_simulation(void) {
     
     // Find best algorithm (lowest energy)
     int best_idx = 0;
-    for (int i = 1; i < 4; i++) {
+    for (int i = 1; i < NUM_ALGORITHMS; i++) {
         if (results[i].energy_consumed < results[best_idx].energy_consumed) {
             best_idx = i;
         }
@@ -281,9 +507,211 @@ void run_simulation(void) {
             results[best_idx].energy_consumed,
             results[best_idx].tasks_completed);
     
+    fclose(comparison_file);
+    free(results);
+    set_clock_mode(previous_clock);
+    printf("\n✓ Results saved to output/comparison_results.txt\n");
+    LOG_INFO("Simulation completed");
+}
+
+
+
+// Run the workload under one sweep configuration, in virtual time
+static void sweep_run(int index, void *context) {
+    SweepPoint *point = &((SweepPoint*)context)[index];
+    SchedContext *ctx = sched_context_create(CLOCK_MODE_VIRTUAL);
+    
+    scheduler_init_ctx(ctx, (SchedulerAlgorithm)point->params[SWEEP_ALGORITHM]);
+    sweep_apply(ctx, point);
+    run_workload(ctx, workload_tasks, workload_seed);
+    sweep_record(ctx, point);
+    sched_context_destroy(ctx);
+}
+
+// Run every configuration of a sweep in parallel and write the results table
+int run_sweep(const char *spec_text) {
+    SweepSpec *spec = (SweepSpec*)safe_malloc(sizeof(SweepSpec));
+    long count = 0;
+    SweepPoint *points = NULL;
+    if (sweep_parse(spec, spec_text) == SUCCESS) {
+        points = sweep_expand(spec, &count);
+    }
+    free(spec);
+    if (points == NULL) {
+        printf("Error: Invalid sweep '%s'\n", spec_text);
+        return ERROR;
+    }
+    
+    int jobs = simulation_jobs > 0 ? simulation_jobs : online_cpu_count();
+    printf("\n========================================\n");
+    printf("PARAMETER SWEEP: %ld CONFIGURATIONS\n", count);
+    printf("========================================\n\n");
+    log_flush();
+    printf("--- Running on %d thread%s ---\n", jobs, jobs == 1 ? "" : "s");
+    
+    int64_t started_ns = get_monotonic_ns();
+    run_parallel(sweep_run, (int)count, points, jobs);
+    double elapsed_ms = (double)(get_monotonic_ns() - started_ns) / NS_PER_MS;
+    log_flush();
+    printf("%ld configurations finished in %.1f ms of wall time\n", count, elapsed_ms);
+    
+    // Lowest energy among the configurations that completed the most tasks
+    long best = 0;
+    for (long i = 1; i < count; i++) {
+        if (points[i].tasks_completed > points[best].tasks_completed ||
+            (points[i].tasks_completed == points[best].tasks_completed &&
+             points[i].energy_consumed < points[best].energy_consumed)) {
+            best = i;
+        }
+    }
+    const int *p = points[best].params;
+    printf("\nBest: %s critical=%d low=%d medium=%d high=%d quantum=%d aging=%d preemption=%d\n",
+           sweep_algorithm_name((SchedulerAlgorithm)p[SWEEP_ALGORITHM]), p[SWEEP_CRITICAL],
+           p[SWEEP_LOW], p[SWEEP_MEDIUM], p[SWEEP_HIGH], p[SWEEP_QUANTUM], p[SWEEP_AGING],
+           p[SWEEP_PREEMPTION]);
+    printf("   Energy: %ld units | Tasks: %d | Missed: %d | Battery: %d%%\n",
+           points[best].energy_consumed, points[best].tasks_completed,
+           points[best].missed_deadlines, points[best].final_battery);
+    
+    int result = sweep_write(sweep_output, points, count);
+    free(points);
+    if (result != SUCCESS) {
+        printf("Error: Cannot write %s\n", sweep_output);
+        return ERROR;
+    }
+    printf("\n✓ Results saved to %s\n", sweep_output);
+    LOG_INFO("Sweep completed");
+    return SUCCESS;
+}
+
+
+
+// One Monte Carlo run: an algorithm on one workload seed
+typedef struct {
+    int algorithm;                  // Index into algorithms[]
+    long replica;                   // Workload seed offset
+    double metrics[NUM_MC_METRICS];
+} MonteCarloRun;
+
+// Run one replica of one algorithm on a context of its own, in virtual time
+static void monte_carlo_run(int index, void *context) {
+    MonteCarloRun *run = &((MonteCarloRun*)context)[index];
+    SchedContext *ctx = sched_context_create(CLOCK_MODE_VIRTUAL);
+    
+    scheduler_init_ctx(ctx, algorithms[run->algorithm]);
+    run_workload(ctx, workload_tasks > 0 ? workload_tasks : MC_DEFAULT_TASKS,
+                 workload_seed + run->replica);
+    
+    SchedulerStats *stats = get_scheduler_statistics_ctx(ctx);
+    run->metrics[MC_ENERGY] = stats->total_energy_consumed;
+    run->metrics[MC_COMPLETED] = stats->tasks_completed;
+    run->metrics[MC_MISSED] = get_task_statistics_ctx(ctx)->missed_deadlines;
+    run->metrics[MC_BATTERY] = get_battery_level_ctx(ctx);
+    sched_context_destroy(ctx);
+}
+
+// Print one "mean +/- 95% CI" row per algorithm
+static void print_monte_carlo_table(FILE *out, RunningStat stats[NUM_MC_METRICS][NUM_ALGORITHMS]) {
+    fprintf(out, "%-18s %8s%9s %8s%9s %8s%9s %8s\n",
+            "Algorithm", "Energy", "", "Tasks", "", "Missed", "", "Battery%");
+    for (int i = 0; i < NUM_ALGORITHMS; i++) {
+        fprintf(out, "%-18s", algo_names[i]);
+        for (int metric = 0; metric < NUM_MC_METRICS; metric++) {
+            Interval interval = running_stat_ci95(&stats[metric][i]);
+            fprintf(out, " %8.1f ± %-6.1f", interval.mean, interval.half_width);
+        }
+        fprintf(out, "\n");
+    }
+}
+
+// Compare the algorithms over seeded workload replicas until the lowest
+// energy is clear of the others at 95% confidence, or max_replicas
+int run_monte_carlo(long max_replicas) {
+    if (replay_path != NULL) {
+        printf("Error: --replicas varies generated workloads; it cannot be used with --replay\n");
+        return ERROR;
+    }
+    
+    FILE *comparison_file = fopen("output/comparison_results.txt", "w");
+    if (!comparison_file) {
+        printf("Error: Cannot create output file\n");
+        return ERROR;
+    }
+    
+    long task_count = workload_tasks > 0 ? workload_tasks : MC_DEFAULT_TASKS;
+    int jobs = simulation_jobs > 0 ? simulation_jobs : online_cpu_count();
+    printf("\n========================================\n");
+    printf("MONTE CARLO COMPARISON: ALL ALGORITHMS\n");
+    printf("========================================\n\n");
+    log_flush();
+    printf("--- Up to %ld replicas of %ld tasks per algorithm on %d thread%s ---\n",
+           max_replicas, task_count, jobs, jobs == 1 ? "" : "s");
+    
+    RunningStat stats[NUM_MC_METRICS][NUM_ALGORITHMS];
+    for (int metric = 0; metric < NUM_MC_METRICS; metric++) {
+        for (int i = 0; i < NUM_ALGORITHMS; i++) {
+            running_stat_init(&stats[metric][i]);
+        }
+    }
+    
+    // Every algorithm runs the same seeds, a round at a time; the intervals
+    // are checked after each round
+    MonteCarloRun *runs = (MonteCarloRun*)safe_malloc(sizeof(MonteCarloRun) * NUM_ALGORITHMS *
+                                                      MC_ROUND_REPLICAS);
+    long replicas = 0;
+    int winner = -1;
+    int64_t started_ns = get_monotonic_ns();
+    while (replicas < max_replicas && winner < 0) {
+        long round = max_replicas - replicas < MC_ROUND_REPLICAS ? max_replicas - replicas :
+                     MC_ROUND_REPLICAS;
+        int count = (int)round * NUM_ALGORITHMS;
+        for (int i = 0; i < count; i++) {
+            runs[i].algorithm = i % NUM_ALGORITHMS;
+            runs[i].replica = replicas + i / NUM_ALGORITHMS;
+        }
+        run_parallel(monte_carlo_run, count, runs, jobs);
+        
+        for (int i = 0; i < count; i++) {
+            for (int metric = 0; metric < NUM_MC_METRICS; metric++) {
+                running_stat_add(&stats[metric][runs[i].algorithm], runs[i].metrics[metric]);
+            }
+        }
+        replicas += round;
+        winner = mc_separated_minimum(stats[MC_ENERGY], NUM_ALGORITHMS);
+    }
+    double elapsed_ms = (double)(get_monotonic_ns() - started_ns) / NS_PER_MS;
+    free(runs);
+    
+    log_flush();
+    printf("%ld replicas per algorithm finished in %.1f ms of wall time%s\n\n", replicas, elapsed_ms,
+           replicas < max_replicas ? " (stopped early)" : "");
+    fprintf(comparison_file, "BATTERY-AWARE SCHEDULER - MONTE CARLO COMPARISON\n");
+    fprintf(comparison_file, "=================================================\n\n");
+    fprintf(comparison_file, "%ld replicas of %ld generated tasks per algorithm, seeds %llu-%llu\n",
+            replicas, task_count, (unsigned long long)workload_seed,
+            (unsigned long long)(workload_seed + replicas - 1));
+    fprintf(comparison_file, "Mean ± 95%% confidence interval\n\n");
+    
+    printf("Mean ± 95%% confidence interval:\n");
+    print_monte_carlo_table(stdout, stats);
+    print_monte_carlo_table(comparison_file, stats);
+    
+    // ===== CONCLUSION =====
+    printf("\n--- CONCLUSION ---\n");
+    fprintf(comparison_file, "\nCONCLUSION:\n");
+    if (winner >= 0) {
+        printf(" %s uses the least energy (95%% confidence)\n", algo_names[winner]);
+        fprintf(comparison_file, "WINNER: %s (least energy at 95%% confidence)\n", algo_names[winner]);
+    } else {
+        printf(" No algorithm's energy is clear of the others after %ld replicas\n", replicas);
+        fprintf(comparison_file, "NO WINNER: energy intervals still overlap after %ld replicas\n",
+                replicas);
+    }
+    
     fclose(comparison_file);
     printf("\n✓ Results saved to output/comparison_results.txt\n");
-    log_info("Simulation completed");
+    LOG_INFO("Monte Carlo comparison completed");
+    return SUCCESS;
 }
 
 
@@ -294,7 +722,7 @@ void interactive_mode(void) {
     int choice;
     bool running = true;
     
-    log_info("Starting interactive mode");
+    LOG_INFO("Starting interactive mode");
     
     while (running) {
         print_menu();
@@ -336,7 +764,7 @@ void interactive_mode(void) {
                 scanf("%d", &deadline);
                 
                 Task *task = create_task(name, priority, energy, burst_time, 
-                                        is_critical, deadline);
+                                             is_critical, deadline);
                 if (admit_task_to_scheduler(task) == SUCCESS) {
                     printf("Task added successfully!\n");
                 } else {
@@ -402,10 +830,13 @@ void interactive_mode(void) {
                 printf("2. Priority\n");
                 printf("3. Round Robin\n");
                 printf("4. Battery Aware\n");
+                printf("5. Earliest Deadline First\n");
+                printf("6. Energy-Aware EDF\n");
+                printf("7. Completely Fair (CFS)\n");
                 printf("Enter choice: ");
                 scanf("%d", &algo);
                 
-                if (algo >= 0 && algo <= 4) {
+                if (algo >= 0 && algo <= 7) {
                     set_scheduler_algorithm((SchedulerAlgorithm)algo);
                     printf("Algorithm changed successfully\n");
                 } else {
@@ -0,0 +1,81 @@
+#include "../include/montecarlo.h"
+#include <math.h>
+
+
+// RUNNING STATISTICS
+
+
+// Start with no values
+void running_stat_init(RunningStat *stat) {
+    stat->count = 0;
+    stat->mean = 0.0;
+    stat->m2 = 0.0;
+}
+
+// Add one value; numerically stable however many values are added
+void running_stat_add(RunningStat *stat, double value) {
+    stat->count++;
+    double delta = value - stat->mean;
+    stat->mean += delta / stat->count;
+    stat->m2 += delta * (value - stat->mean);
+}
+
+// Sample standard deviation (0 with fewer than two values)
+double running_stat_stddev(const RunningStat *stat) {
+    return stat->count > 1 ? sqrt(stat->m2 / (stat->count - 1)) : 0.0;
+}
+
+
+// CONFIDENCE INTERVALS
+
+
+// Two-sided 97.5% quantile of Student's t distribution
+double student_t_975(long df) {
+    static const double table[] = {
+        0.0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    const long table_size = (long)(sizeof(table) / sizeof(table[0]));
+    
+    if (df < 1) {
+        return INFINITY;
+    }
+    if (df < table_size) {
+        return table[df];
+    }
+    // Past 30 degrees of freedom, 1.96 plus a 1/df correction is within 0.1%
+    return 1.95996 + 2.4 / df;
+}
+
+// 95% confidence interval of the mean
+Interval running_stat_ci95(const RunningStat *stat) {
+    Interval interval = {stat->mean, INFINITY};
+    if (stat->count > 1) {
+        interval.half_width = student_t_975(stat->count - 1) * running_stat_stddev(stat) /
+                              sqrt((double)stat->count);
+    }
+    return interval;
+}
+
+// Lowest mean whose interval is clear of every other interval, or -1
+int mc_separated_minimum(const RunningStat *stats, int count) {
+    int lowest = 0;
+    for (int i = 1; i < count; i++) {
+        if (stats[i].mean < stats[lowest].mean) {
+            lowest = i;
+        }
+    }
+    
+    Interval best = running_stat_ci95(&stats[lowest]);
+    for (int i = 0; i < count; i++) {
+        if (i == lowest) {
+            continue;
+        }
+        Interval other = running_stat_ci95(&stats[i]);
+        if (!(best.mean + best.half_width < other.mean - other.half_width)) {
+            return -1;
+        }
+    }
+    return lowest;
+}
@@ -0,0 +1,306 @@
+#define _DEFAULT_SOURCE
+#include "../include/replay.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define CSV_FIELDS 7
+#define CSV_LINE_MAX 512
+
+
+// CSV PARSING
+
+
+// Parse a whole field as an integer in [low, high]
+static bool parse_field(const char *text, long low, long high, long *value) {
+    char *end;
+    errno = 0;
+    long parsed = strtol(text, &end, 10);
+    while (*end == ' ') {
+        end++;
+    }
+    if (end == text || *end != '\0' || errno != 0 || parsed < low || parsed > high) {
+        return false;
+    }
+    *value = parsed;
+    return true;
+}
+
+// Split a line at commas into exactly CSV_FIELDS fields (modifies the line)
+static bool split_fields(char *line, char *fields[CSV_FIELDS]) {
+    int count = 0;
+    char *cursor = line;
+    
+    while (count < CSV_FIELDS) {
+        fields[count++] = cursor;
+        char *comma = strchr(cursor, ',');
+        if (comma == NULL) {
+            break;
+        }
+        *comma = '\0';
+        cursor = comma + 1;
+    }
+    return count == CSV_FIELDS && strchr(fields[CSV_FIELDS - 1], ',') == NULL;
+}
+
+// Parse one task line
+static bool parse_task_line(char *line, TaskSpec *spec) {
+    char *fields[CSV_FIELDS];
+    long arrival, priority, energy, burst, critical, deadline;
+    
+    if (!split_fields(line, fields) ||
+        !parse_field(fields[0], 0, INT64_MAX / NS_PER_MS, &arrival) ||
+        !parse_field(fields[2], PRIORITY_HIGH, PRIORITY_LOW, &priority) ||
+        !parse_field(fields[3], ENERGY_LOW, ENERGY_HIGH, &energy) ||
+        !parse_field(fields[4], 1, INT32_MAX, &burst) ||
+        !parse_field(fields[5], 0, 1, &critical) ||
+        !parse_field(fields[6], 0, INT32_MAX, &deadline)) {
+        return false;
+    }
+    
+    spec->arrival_ms = arrival;
+    snprintf(spec->name, sizeof(spec->name), "%s", fields[1]);
+    spec->priority = (int)priority;
+    spec->energy_cost = (int)energy;
+    spec->burst_time = (int)burst;
+    spec->is_critical = critical != 0;
+    spec->deadline = (int)deadline;
+    return true;
+}
+
+// Read the next task from a CSV trace, skipping comments, the header and
+// malformed lines (which are logged and counted)
+static bool next_csv_task(WorkloadReplay *replay, TaskSpec *spec) {
+    char line[CSV_LINE_MAX];
+    
+    while (fgets(line, sizeof(line), replay->csv) != NULL) {
+        replay->line++;
+    
+        size_t length = strcspn(line, "\r\n");
+        bool complete = line[length] != '\0' || feof(replay->csv);
+        line[length] = '\0';
+        if (!complete) {
+            // Overlong line: discard the rest of it
+            int c;
+            while ((c = fgetc(replay->csv)) != EOF && c != '\n') {
+            }
+            LOG_ERROR("Workload line %ld: too long", replay->line);
+            replay->errors++;
+            continue;
+        }
+    
+        if (line[0] == '\0' || line[0] == '#' || strncmp(line, "arrival", 7) == 0) {
+            continue;
+        }
+        if (parse_task_line(line, spec)) {
+            return true;
+        }
+    
+        LOG_ERROR("Workload line %ld: expected %s", replay->line, WORKLOAD_CSV_HEADER);
+        replay->errors++;
+    }
+    return false;
+}
+
+
+// BINARY FORMAT
+
+
+// Map a binary trace and check its header
+static int open_binary(WorkloadReplay *replay, int fd, size_t size, const char *path) {
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        LOG_ERROR("Cannot map workload %s", path);
+        return ERROR;
+    }
+    
+    const WorkloadFileHeader *header = (const WorkloadFileHeader*)map;
+    uint64_t room = (size - sizeof(WorkloadFileHeader)) / sizeof(WorkloadRecord);
+    if (header->version != WORKLOAD_FILE_VERSION || header->record_size != sizeof(WorkloadRecord) ||
+        header->count > room) {
+        LOG_ERROR("Workload %s: unsupported version or truncated file", path);
+        munmap(map, size);
+        return ERROR;
+    }
+    
+    // Records are read once, front to back
+    madvise(map, size, MADV_SEQUENTIAL);
+    replay->map = map;
+    replay->map_size = size;
+    replay->records = (const WorkloadRecord*)(header + 1);
+    replay->count = header->count;
+    return SUCCESS;
+}
+
+// Read the next record of a mapped trace
+static bool next_record(WorkloadReplay *replay, TaskSpec *spec) {
+    if (replay->next >= replay->count) {
+        return false;
+    }
+    
+    const WorkloadRecord *record = &replay->records[replay->next++];
+    spec->arrival_ms = record->arrival_ms;
+    memcpy(spec->name, record->name, WORKLOAD_RECORD_NAME);
+    spec->name[WORKLOAD_RECORD_NAME] = '\0';
+    spec->priority = record->priority;
+    spec->energy_cost = record->energy_cost;
+    spec->burst_time = record->burst_time;
+    spec->is_critical = record->is_critical != 0;
+    spec->deadline = record->deadline;
+    return true;
+}
+
+
+// REPLAY API
+
+
+// Open a trace for replay: binary if it starts with the magic, else CSV
+int replay_open(WorkloadReplay *replay, const char *path) {
+    memset(replay, 0, sizeof(*replay));
+    
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR("Cannot open workload %s", path);
+        return ERROR;
+    }
+    
+    struct stat info;
+    char magic[sizeof(((WorkloadFileHeader*)0)->magic)];
+    if (fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(WorkloadFileHeader) &&
+        pread(fd, magic, sizeof(magic), 0) == (ssize_t)sizeof(magic) &&
+        memcmp(magic, WORKLOAD_FILE_MAGIC, sizeof(magic)) == 0) {
+        int result = open_binary(replay, fd, (size_t)info.st_size, path);
+        close(fd);
+        return result;
+    }
+    close(fd);
+    
+    replay->csv = fopen(path, "r");
+    if (replay->csv == NULL) {
+        LOG_ERROR("Cannot open workload %s", path);
+        return ERROR;
+    }
+    return SUCCESS;
+}
+
+// Next task of the trace (false at the end). Arrival times never go
+// backwards: a task listed after a later one arrives with it.
+bool replay_next(void *source, TaskSpec *spec) {
+    WorkloadReplay *replay = (WorkloadReplay*)source;
+    
+    bool found = replay->records != NULL ? next_record(replay, spec) :
+                 replay->csv != NULL && next_csv_task(replay, spec);
+    if (!found) {
+        return false;
+    }
+    
+    if (spec->arrival_ms < replay->last_arrival_ms) {
+        spec->arrival_ms = replay->last_arrival_ms;
+        replay->reordered++;
+    }
+    replay->last_arrival_ms = spec->arrival_ms;
+    replay->tasks++;
+    return true;
+}
+
+// Close a trace
+void replay_close(WorkloadReplay *replay) {
+    if (replay->csv != NULL) {
+        fclose(replay->csv);
+    }
+    if (replay->map != NULL) {
+        munmap(replay->map, replay->map_size);
+    }
+    replay->csv = NULL;
+    replay->map = NULL;
+    replay->records = NULL;
+}
+
+
+// WRITER
+
+
+// Write a binary header for `count` records at the start of the file
+static bool write_header(FILE *file, uint64_t count) {
+    WorkloadFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, WORKLOAD_FILE_MAGIC, sizeof(header.magic));
+    header.version = WORKLOAD_FILE_VERSION;
+    header.record_size = sizeof(WorkloadRecord);
+    header.count = count;
+    return fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, file) == 1;
+}
+
+// Start writing a trace; binary unless the path ends in ".csv"
+int workload_writer_open(WorkloadWriter *writer, const char *path) {
+    size_t length = strlen(path);
+    writer->binary = !(length >= 4 && strcmp(path + length - 4, ".csv") == 0);
+    writer->count = 0;
+    writer->file = fopen(path, writer->binary ? "wb" : "w");
+    if (writer->file == NULL) {
+        LOG_ERROR("Cannot create workload %s", path);
+        return ERROR;
+    }
+    
+    // Binary: placeholder header, completed with the count on close
+    bool written = writer->binary ? write_header(writer->file, 0) :
+                   fprintf(writer->file, "%s\n", WORKLOAD_CSV_HEADER) > 0;
+    if (!written) {
+        LOG_ERROR("Cannot write workload %s", path);
+        fclose(writer->file);
+        writer->file = NULL;
+        return ERROR;
+    }
+    return SUCCESS;
+}
+
+// Append one task
+int workload_writer_write(WorkloadWriter *writer, const TaskSpec *spec) {
+    if (writer->binary) {
+        WorkloadRecord record;
+        memset(&record, 0, sizeof(record));
+        record.arrival_ms = spec->arrival_ms;
+        record.burst_time = spec->burst_time;
+        record.deadline = spec->deadline;
+        record.priority = (uint8_t)spec->priority;
+        record.energy_cost = (uint8_t)spec->energy_cost;
+        record.is_critical = spec->is_critical;
+        memcpy(record.name, spec->name, strnlen(spec->name, WORKLOAD_RECORD_NAME));
+        if (fwrite(&record, sizeof(record), 1, writer->file) != 1) {
+            return ERROR;
+        }
+    } else {
+        // Commas would split the name field
+        char name[MAX_TASK_NAME];
+        snprintf(name, sizeof(name), "%s", spec->name);
+        for (char *comma = strchr(name, ','); comma != NULL; comma = strchr(comma, ',')) {
+            *comma = ' ';
+        }
+        if (fprintf(writer->file, "%lld,%s,%d,%d,%d,%d,%d\n", (long long)spec->arrival_ms, name,
+                    spec->priority, spec->energy_cost, spec->burst_time, spec->is_critical,
+                    spec->deadline) < 0) {
+            return ERROR;
+        }
+    }
+    
+    writer->count++;
+    return SUCCESS;
+}
+
+// Finish the file (the binary header gets the record count)
+int workload_writer_close(WorkloadWriter *writer) {
+    if (writer->file == NULL) {
+        return ERROR;
+    }
+    
+    bool ok = !ferror(writer->file) && (!writer->binary || write_header(writer->file, writer->count));
+    ok = fclose(writer->file) == 0 && ok;
+    writer->file = NULL;
+    if (!ok) {
+        LOG_ERROR("Error writing workload file");
+        return ERROR;
+    }
+    return SUCCESS;
+}
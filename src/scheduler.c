@@ -1,86 +1,703 @@
 // /home/nishit/Desktop/OS/nishit/osproject/include/scheduler.h
 #include "../include/scheduler.h"
+#include "../include/trace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include <limits.h>
 
 
-// GLOBAL VARIABLES
+// SCHEDULER CONTEXTS
 
 
-static SchedulerState scheduler_state;
-static SchedulerStats scheduler_stats;
-static bool is_initialized = false;
+// Context behind the API without the _ctx suffix
+static SchedContext default_context = {
+    .clock = &default_clock,
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+};
+
+// The trace is process-wide and stamped by the global clock, so only the
+// default context records to it
+#define SCHED_TRACE(ctx, ...) \
+    do { \
+        if ((ctx) == &default_context) { \
+            trace_record(__VA_ARGS__); \
+        } \
+    } while(0)
+
+// Get the default context
+SchedContext* sched_default_context(void) {
+    return &default_context;
+}
+
+// Create an independent, uninitialized scheduler context with its own clock
+SchedContext* sched_context_create(ClockMode mode) {
+    SchedContext *ctx = (SchedContext*)safe_malloc(sizeof(SchedContext));
+    sim_clock_init(&ctx->own_clock, mode);
+    ctx->clock = &ctx->own_clock;
+    pthread_mutex_init(&ctx->mutex, NULL);
+    return ctx;
+}
+
+// Clean up and free a context from sched_context_create()
+void sched_context_destroy(SchedContext *ctx) {
+    if (ctx == NULL || ctx == &default_context) {
+        return;
+    }
+    
+    scheduler_cleanup_ctx(ctx);
+    pthread_mutex_destroy(&ctx->mutex);
+    free(ctx);
+}
+
+
+// READY QUEUE MANAGEMENT
+
+
+// SJF key: least remaining work first
+static int compare_remaining_time(const Task *a, const Task *b) {
+    return a->remaining_time - b->remaining_time;
+}
+
+// Priority key: lowest number (highest priority) first
+static int compare_priority(const Task *a, const Task *b) {
+    return a->priority - b->priority;
+}
+
+// EDF key: earliest absolute deadline (arrival + deadline) first; tasks
+// without a deadline go last
+static int compare_deadline(const Task *a, const Task *b) {
+    if (a->deadline <= 0 || b->deadline <= 0) {
+        return (a->deadline <= 0) - (b->deadline <= 0);
+    }
+    
+    int64_t due_a = a->arrival_time_ns + (int64_t)a->deadline * NS_PER_MS;
+    int64_t due_b = b->arrival_time_ns + (int64_t)b->deadline * NS_PER_MS;
+    return (due_a > due_b) - (due_a < due_b);
+}
+
+// CFS key: least weighted virtual runtime first
+static int compare_vruntime(const Task *a, const Task *b) {
+    return (a->vruntime > b->vruntime) - (a->vruntime < b->vruntime);
+}
+
+// Ordering key for algorithms that dispatch from the keyed ready queue
+// (NULL for algorithms that use another ready structure)
+static TaskCompareFn ready_heap_order(SchedulerAlgorithm algorithm) {
+    switch (algorithm) {
+        case SCHEDULER_SJF:
+            return compare_remaining_time;
+        case SCHEDULER_PRIORITY:
+            return compare_priority;
+        case SCHEDULER_EDF:
+        case SCHEDULER_ENERGY_EDF:
+            return compare_deadline;
+        case SCHEDULER_CFS:
+            return compare_vruntime;
+        default:
+            return NULL;
+    }
+}
+
+
+// BATTERY-AWARE RUN QUEUE
+
+
+// Per-mode search order: rank -> bucket, and bucket -> rank (-1 = never picked)
+static int mode_order[RUNQUEUE_MODES][RUNQUEUE_BUCKETS];
+static int mode_order_length[RUNQUEUE_MODES];
+static int bucket_rank[RUNQUEUE_MODES][RUNQUEUE_BUCKETS];
+static pthread_once_t mode_order_once = PTHREAD_ONCE_INIT;
+
+// Bucket for a (critical, priority, energy) triple
+static int runqueue_bucket(bool is_critical, int priority, int energy_cost) {
+    priority = max(PRIORITY_HIGH, min(PRIORITY_LOW, priority));
+    energy_cost = max(ENERGY_LOW, min(ENERGY_HIGH, energy_cost));
+    return (is_critical ? 9 : 0) + (priority - 1) * 3 + (energy_cost - 1);
+}
+
+// Sort key of a bucket in a mode's search order (smaller runs first, -1 = excluded)
+static int bucket_sort_key(SchedulerMode mode, bool is_critical, int priority, int energy) {
+    int not_critical = is_critical ? 0 : 1;
+    
+    switch (mode) {
+        case MODE_CRITICAL:
+            // Only critical tasks, cheapest first
+            return is_critical ? (energy * 4 + priority) : -1;
+        case MODE_POWER_SAVE:
+            // Critical > low energy > high priority
+            return (not_critical * 4 + energy) * 4 + priority;
+        case MODE_BALANCED:
+            // Critical first, then the best combined priority/energy score
+            return (not_critical * 8 + priority + energy) * 4 + priority;
+        case MODE_PERFORMANCE:
+        default:
+            // Normal priority-based scheduling, critical breaking ties
+            return (priority * 2 + not_critical) * 4 + energy;
+    }
+}
+
+// Precompute every mode's bucket search order (once, shared by all contexts)
+static void build_mode_orders(void) {
+    for (int mode = 0; mode < RUNQUEUE_MODES; mode++) {
+        int keys[RUNQUEUE_BUCKETS];
+        int length = 0;
+        
+        for (int bucket = 0; bucket < RUNQUEUE_BUCKETS; bucket++) {
+            bool is_critical = bucket >= 9;
+            int priority = (bucket % 9) / 3 + 1;
+            int energy = bucket % 3 + 1;
+            int key = bucket_sort_key((SchedulerMode)mode, is_critical, priority, energy);
+            
+            bucket_rank[mode][bucket] = -1;
+            if (key < 0) {
+                continue;
+            }
+            
+            // Insertion sort by key (bucket index breaks ties)
+            int pos = length++;
+            while (pos > 0 && keys[pos - 1] > key) {
+                keys[pos] = keys[pos - 1];
+                mode_order[mode][pos] = mode_order[mode][pos - 1];
+                pos--;
+            }
+            keys[pos] = key;
+            mode_order[mode][pos] = bucket;
+        }
+        
+        mode_order_length[mode] = length;
+        for (int rank = 0; rank < length; rank++) {
+            bucket_rank[mode][mode_order[mode][rank]] = rank;
+        }
+    }
+}
+
+// Empty the run queue
+static void runqueue_init(BatteryRunQueue *rq) {
+    pthread_once(&mode_order_once, build_mode_orders);
+    memset(rq, 0, sizeof(BatteryRunQueue));
+}
+
+// Set or clear a bucket's bit in every mode bitmap that includes it
+static void runqueue_mark(BatteryRunQueue *rq, int bucket, bool non_empty) {
+    for (int mode = 0; mode < RUNQUEUE_MODES; mode++) {
+        int rank = bucket_rank[mode][bucket];
+        if (rank < 0) {
+            continue;
+        }
+        if (non_empty) {
+            rq->mode_bitmap[mode] |= (1u << rank);
+        } else {
+            rq->mode_bitmap[mode] &= ~(1u << rank);
+        }
+    }
+}
+
+// Append a task to the tail of its bucket
+static void runqueue_enqueue(BatteryRunQueue *rq, Task *task) {
+    int bucket = runqueue_bucket(task->is_critical, task->priority, task->energy_cost);
+    TaskList *list = &rq->buckets[bucket];
+    
+    task->queue_index = bucket;
+    task->queue_next = NULL;
+    task->queue_prev = list->tail;
+    if (list->tail != NULL) {
+        list->tail->queue_next = task;
+    } else {
+        list->head = task;
+        runqueue_mark(rq, bucket, true);
+    }
+    list->tail = task;
+    rq->count++;
+}
+
+// Unlink a task from its bucket in O(1)
+static void runqueue_remove(BatteryRunQueue *rq, Task *task) {
+    int bucket = task->queue_index;
+    TaskList *list = &rq->buckets[bucket];
+    
+    if (task->queue_prev != NULL) {
+        task->queue_prev->queue_next = task->queue_next;
+    } else {
+        list->head = task->queue_next;
+    }
+    if (task->queue_next != NULL) {
+        task->queue_next->queue_prev = task->queue_prev;
+    } else {
+        list->tail = task->queue_prev;
+    }
+    if (list->head == NULL) {
+        runqueue_mark(rq, bucket, false);
+    }
+    
+    task->queue_index = -1;
+    task->queue_prev = NULL;
+    task->queue_next = NULL;
+    rq->count--;
+}
+
+// Remove and return the first task in the mode's search order (NULL if none eligible)
+static Task* runqueue_pick(BatteryRunQueue *rq, SchedulerMode mode) {
+    unsigned int bits = rq->mode_bitmap[mode];
+    if (bits == 0) {
+        return NULL;
+    }
+    
+    int bucket = mode_order[mode][__builtin_ctz(bits)];
+    Task *task = rq->buckets[bucket].head;
+    runqueue_remove(rq, task);
+    return task;
+}
+
+
+// AGING
+
+
+// Algorithms whose dispatch order depends on task priority
+static bool aging_applies(SchedulerAlgorithm algorithm) {
+    return algorithm == SCHEDULER_PRIORITY || algorithm == SCHEDULER_BATTERY_AWARE;
+}
+
+// Start the aging timer of a task that has just become ready
+static void arm_aging_timer(SchedContext *ctx, Task *task) {
+    if (!ctx->state.config.enable_aging || 
+        !aging_applies(ctx->state.config.algorithm) ||
+        task->priority <= PRIORITY_HIGH) {
+        return;
+    }
+    
+    timer_wheel_add(&ctx->state.aging_wheel, &task->aging_timer,
+                    sim_clock_ms(ctx->clock) + ctx->state.config.aging_threshold, task);
+}
+
+
+// READY STRUCTURE DISPATCH
+
+
+// Ready structures an algorithm can dispatch from
+typedef enum {
+    READY_FIFO,                     // ready_queue
+    READY_HEAP,                     // ready_heap
+    READY_BUCKETS                   // runqueue
+} ReadyStructure;
+
+// Ready structure used by an algorithm
+static ReadyStructure ready_structure_for(SchedulerAlgorithm algorithm) {
+    if (algorithm == SCHEDULER_BATTERY_AWARE) {
+        return READY_BUCKETS;
+    }
+    if (ready_heap_order(algorithm) != NULL) {
+        return READY_HEAP;
+    }
+    return READY_FIFO;
+}
+
+// Add a task to a specific ready structure
+static int push_ready_task(SchedContext *ctx, ReadyStructure structure, Task *task) {
+    switch (structure) {
+        case READY_HEAP:
+            return heap_push_task(ctx->state.ready_heap, task);
+        case READY_BUCKETS:
+            runqueue_enqueue(&ctx->state.runqueue, task);
+            return SUCCESS;
+        case READY_FIFO:
+        default:
+            if (enqueue_task(ctx->state.ready_queue, task) != SUCCESS) {
+                return ERROR;
+            }
+            task->queue_index = 0;
+            return SUCCESS;
+    }
+}
+
+// Take the task at the front of the FIFO ready queue
+static Task* pop_ready_fifo(SchedContext *ctx) {
+    Task *task = dequeue_task(ctx->state.ready_queue);
+    if (task != NULL) {
+        task->queue_index = -1;
+    }
+    return task;
+}
+
+// Add a task to the ready structure used by the current algorithm
+static int enqueue_ready_task(SchedContext *ctx, Task *task) {
+    // A task joining the CFS queue starts no further behind than the
+    // queue itself, so long sleepers cannot monopolize the CPU
+    if (ctx->state.config.algorithm == SCHEDULER_CFS) {
+        task->vruntime = task->vruntime > ctx->state.min_vruntime ? 
+                         task->vruntime : ctx->state.min_vruntime;
+    }
+    
+    if (push_ready_task(ctx, ready_structure_for(ctx->state.config.algorithm), task) != SUCCESS) {
+        return ERROR;
+    }
+    arm_aging_timer(ctx, task);
+    return SUCCESS;
+}
+
+// Number of ready tasks across all structures
+static int get_ready_count(SchedContext *ctx) {
+    return get_queue_size(ctx->state.ready_queue) + 
+           get_heap_size(ctx->state.ready_heap) +
+           ctx->state.runqueue.count;
+}
+
+// Aging timer expiry: boost the task one priority level and reorder it
+static void on_aging_timer(TimerEntry *entry, void *context) {
+    SchedContext *ctx = (SchedContext*)context;
+    Task *task = (Task*)entry->data;
+    
+    if (!ctx->state.config.enable_aging || 
+        task->state != TASK_STATE_READY || task->priority <= PRIORITY_HIGH) {
+        return;
+    }
+    
+    ReadyStructure structure = ready_structure_for(ctx->state.config.algorithm);
+    if (structure == READY_BUCKETS) {
+        runqueue_remove(&ctx->state.runqueue, task);
+    }
+    
+    task->priority--;
+    update_task_keys_ctx(ctx, task);
+    
+    if (structure == READY_BUCKETS) {
+        runqueue_enqueue(&ctx->state.runqueue, task);
+    } else if (structure == READY_HEAP) {
+        heap_update_task(ctx->state.ready_heap, task);
+    }
+    ctx->stats.aging_promotions++;
+    
+    LOG_DEBUG("Task aged: ID=%d, Priority %d -> %d", 
+              task->task_id, task->priority + 1, task->priority);
+    
+    // Keep aging until the task reaches the highest priority
+    arm_aging_timer(ctx, task);
+}
+
+// Fire the aging timers of every task that has waited past the threshold
+static void process_aging_timers(SchedContext *ctx) {
+    timer_wheel_advance(&ctx->state.aging_wheel, sim_clock_ms(ctx->clock),
+                        on_aging_timer, ctx);
+}
+
+// A task leaving the ready structures stops aging and drops its boost
+static Task* dispatch_ready_task(SchedContext *ctx, Task *task) {
+    if (task == NULL) {
+        return NULL;
+    }
+    
+    timer_wheel_cancel(&ctx->state.aging_wheel, &task->aging_timer);
+    if (task->priority != task->base_priority) {
+        task->priority = task->base_priority;
+        update_task_keys_ctx(ctx, task);
+    }
+    return task;
+}
+
+// Keep a ready task aging only if the configuration still ages it
+static void sync_aging_timer(SchedContext *ctx, Task *task) {
+    if (!timer_is_armed(&task->aging_timer)) {
+        arm_aging_timer(ctx, task);
+    } else if (!ctx->state.config.enable_aging || 
+               !aging_applies(ctx->state.config.algorithm)) {
+        timer_wheel_cancel(&ctx->state.aging_wheel, &task->aging_timer);
+    }
+}
+
+// Move ready tasks into the structure the configured algorithm dispatches
+// from, and arm or cancel their aging timers to match it
+static void migrate_ready_tasks(SchedContext *ctx) {
+    SchedulerAlgorithm algorithm = ctx->state.config.algorithm;
+    ReadyStructure target = ready_structure_for(algorithm);
+    
+    if (target == READY_HEAP) {
+        set_heap_order(ctx->state.ready_heap, ready_heap_order(algorithm));
+    }
+    
+    // Only energy-aware EDF defers tasks; any other algorithm gets them back
+    if (algorithm != SCHEDULER_ENERGY_EDF) {
+        while (!is_queue_empty(ctx->state.deferred_queue)) {
+            Task *task = dequeue_task(ctx->state.deferred_queue);
+            set_task_state_ctx(ctx, task, TASK_STATE_READY);
+            push_ready_task(ctx, target, task);
+        }
+        ctx->state.deferred_min_energy = INT_MAX;
+        ctx->state.deferred_expiry_ms = LONG_MAX;
+    }
+    
+    if (target != READY_FIFO) {
+        while (!is_queue_empty(ctx->state.ready_queue)) {
+            push_ready_task(ctx, target, pop_ready_fifo(ctx));
+        }
+    }
+    if (target != READY_HEAP) {
+        while (!is_heap_empty(ctx->state.ready_heap)) {
+            push_ready_task(ctx, target, heap_pop_task(ctx->state.ready_heap));
+        }
+    }
+    if (target != READY_BUCKETS) {
+        // PERFORMANCE order covers every bucket
+        while (ctx->state.runqueue.count > 0) {
+            push_ready_task(ctx, target, runqueue_pick(&ctx->state.runqueue, MODE_PERFORMANCE));
+        }
+    }
+    
+    switch (target) {
+        case READY_HEAP:
+            for (int i = 0; i < ctx->state.ready_heap->count; i++) {
+                sync_aging_timer(ctx, ctx->state.ready_heap->tasks[i]);
+            }
+            break;
+        case READY_BUCKETS:
+            for (int bucket = 0; bucket < RUNQUEUE_BUCKETS; bucket++) {
+                for (Task *task = ctx->state.runqueue.buckets[bucket].head; task != NULL;
+                     task = task->queue_next) {
+                    sync_aging_timer(ctx, task);
+                }
+            }
+            break;
+        case READY_FIFO:
+        default: {
+            TaskQueue *queue = ctx->state.ready_queue;
+            for (int i = 0; i < queue->count; i++) {
+                sync_aging_timer(ctx, queue->tasks[(queue->front + i) % queue->capacity]);
+            }
+            break;
+        }
+    }
+}
+
+// Unlink a task from every ready structure, the waiting queue and the aging
+// wheel (the task manager calls this before recycling its slot)
+void scheduler_release_task_ctx(SchedContext *ctx, Task *task) {
+    if (!ctx->initialized || task == NULL) {
+        return;
+    }
+    
+    timer_wheel_cancel(&ctx->state.aging_wheel, &task->aging_timer);
+    if (task->queue_index >= 0) {
+        switch (ready_structure_for(ctx->state.config.algorithm)) {
+            case READY_HEAP:
+                heap_remove_task(ctx->state.ready_heap, task);
+                break;
+            case READY_BUCKETS:
+                runqueue_remove(&ctx->state.runqueue, task);
+                break;
+            case READY_FIFO:
+            default:
+                remove_queued_task(ctx->state.ready_queue, task);
+                task->queue_index = -1;
+                break;
+        }
+    }
+    if (task->state == TASK_STATE_SUSPENDED &&
+        remove_queued_task(ctx->state.waiting_queue, task) != SUCCESS) {
+        remove_queued_task(ctx->state.deferred_queue, task);
+    }
+    if (ctx->state.current_task == task) {
+        ctx->state.current_task = NULL;
+    }
+}
+
+
+// EVENTS AND IDLE WAITING
+
+
+// Lock the scheduler against the run loop
+void scheduler_lock_ctx(SchedContext *ctx) {
+    pthread_mutex_lock(&ctx->mutex);
+}
+
+// Release the scheduler lock
+void scheduler_unlock_ctx(SchedContext *ctx) {
+    pthread_mutex_unlock(&ctx->mutex);
+}
+
+// Record an event and wake the run loop if it is idle
+void scheduler_notify_ctx(SchedContext *ctx, SchedulerEvent event) {
+    if (!ctx->initialized) {
+        return;
+    }
+    
+    ctx->pending_events |= event;
+    pthread_cond_signal(&ctx->event_cond);
+}
+
+// Battery monitor hook: a state or threshold change may make tasks eligible
+static void on_battery_event(SchedContext *ctx, int level, BatteryState state) {
+    (void)level;
+    (void)state;
+    scheduler_notify_ctx(ctx, SCHED_EVENT_BATTERY);
+}
+
+// Register the source polled for newly arrived tasks
+void set_arrival_source_ctx(SchedContext *ctx, ArrivalSource source, void *context) {
+    ctx->arrival_source = source;
+    ctx->arrival_context = context;
+}
+
+// Register the hook called for each completed or dropped task
+void set_task_done_hook_ctx(SchedContext *ctx, TaskDoneHook hook, void *context) {
+    ctx->task_done_hook = hook;
+    ctx->task_done_context = context;
+}
+
+// Admit the tasks that have arrived; returns when the next one is due
+// (-1 = no arrival source or no arrivals left)
+static long poll_arrivals(SchedContext *ctx) {
+    if (ctx->arrival_source == NULL) {
+        return -1;
+    }
+    return ctx->arrival_source(sim_clock_ms(ctx->clock), ctx->arrival_context);
+}
+
+// Hand a task the scheduler is finished with to the done hook
+static void task_done(SchedContext *ctx, Task *task) {
+    if (ctx->task_done_hook != NULL) {
+        ctx->task_done_hook(task, ctx->task_done_context);
+    }
+}
+
+// Block until an event arrives or deadline_ms passes; returns the events seen.
+// Called with ctx->mutex held.
+// Monotonic time `milliseconds` from now, for timed condition waits
+static struct timespec monotonic_deadline(long milliseconds) {
+    struct timespec until;
+    clock_gettime(CLOCK_MONOTONIC, &until);
+    until.tv_sec += milliseconds / 1000;
+    until.tv_nsec += (milliseconds % 1000) * 1000000L;
+    if (until.tv_nsec >= 1000000000L) {
+        until.tv_sec++;
+        until.tv_nsec -= 1000000000L;
+    }
+    return until;
+}
+
+static unsigned int wait_for_event(SchedContext *ctx, long deadline_ms) {
+    long wait_ms = deadline_ms - sim_clock_ms(ctx->clock);
+    
+    if (ctx->pending_events == 0 && wait_ms > 0) {
+        if (ctx->clock->mode == CLOCK_MODE_VIRTUAL) {
+            // Nothing else can happen on the virtual timeline: jump to the deadline
+            sim_clock_advance(ctx->clock, wait_ms);
+        } else {
+            struct timespec until = monotonic_deadline(wait_ms);
+            while (ctx->pending_events == 0 && 
+                   pthread_cond_timedwait(&ctx->event_cond, &ctx->mutex, &until) != ETIMEDOUT) {
+            }
+        }
+    }
+    
+    ctx->stats.idle_wakeups++;
+    unsigned int events = ctx->pending_events;
+    ctx->pending_events = 0;
+    return events;
+}
 
 
 // INITIALIZATION AND CLEANUP
 
 
 // Initialize scheduler
-int scheduler_init(SchedulerAlgorithm algorithm) {
-    if (is_initialized) {
-        log_error("Scheduler already initialized");
+int scheduler_init_ctx(SchedContext *ctx, SchedulerAlgorithm algorithm) {
+    if (ctx->initialized) {
+        LOG_ERROR("Scheduler already initialized");
         return ERROR;
     }
     
     // Initialize dependencies
-    if (battery_monitor_init() != SUCCESS) {
-        log_error("Failed to initialize battery monitor");
+    if (battery_monitor_init_ctx(ctx) != SUCCESS) {
+        LOG_ERROR("Failed to initialize battery monitor");
         return ERROR;
     }
     
-    if (task_manager_init() != SUCCESS) {
-        log_error("Failed to initialize task manager");
-        battery_monitor_cleanup();
+    if (task_manager_init_ctx(ctx) != SUCCESS) {
+        LOG_ERROR("Failed to initialize task manager");
+        battery_monitor_cleanup_ctx(ctx);
         return ERROR;
     }
     
     // Initialize scheduler state
-    scheduler_state.current_task = NULL;
-    scheduler_state.ready_queue = create_task_queue();
-    scheduler_state.waiting_queue = create_task_queue();
-    scheduler_state.config.algorithm = algorithm;
-    scheduler_state.config.mode = MODE_PERFORMANCE;
-    scheduler_state.config.time_quantum = 100;  // 100ms default
-    scheduler_state.config.enable_preemption = true;
-    scheduler_state.config.enable_aging = true;
-    scheduler_state.config.aging_threshold = 5000;  // 5 seconds
-    scheduler_state.mode = MODE_PERFORMANCE;
-    scheduler_state.total_runtime = 0;
-    scheduler_state.context_switches = 0;
-    scheduler_state.is_running = false;
+    ctx->state.current_task = NULL;
+    ctx->state.ready_queue = create_task_queue();
+    ctx->state.ready_heap = create_task_heap(
+        ready_heap_order(algorithm) ? ready_heap_order(algorithm) : compare_priority);
+    runqueue_init(&ctx->state.runqueue);
+    ctx->state.waiting_queue = create_task_queue();
+    ctx->state.deferred_queue = create_task_queue();
+    ctx->state.deferred_min_energy = INT_MAX;
+    ctx->state.deferred_expiry_ms = LONG_MAX;
+    timer_wheel_init(&ctx->state.aging_wheel, AGING_TICK_MS, sim_clock_ms(ctx->clock));
+    ctx->state.config.algorithm = algorithm;
+    ctx->state.config.mode = MODE_PERFORMANCE;
+    ctx->state.config.time_quantum = DEFAULT_TIME_QUANTUM_MS;
+    ctx->state.config.enable_preemption = true;
+    ctx->state.config.enable_aging = true;
+    ctx->state.config.aging_threshold = DEFAULT_AGING_THRESHOLD_MS;
+    ctx->state.config.min_granularity = 100;
+    ctx->state.min_vruntime = 0;
+    ctx->state.mode = MODE_PERFORMANCE;
+    ctx->state.total_runtime = 0;
+    ctx->state.context_switches = 0;
+    ctx->state.is_running = false;
     
     // Initialize statistics
-    scheduler_stats.total_tasks_scheduled = 0;
-    scheduler_stats.tasks_completed = 0;
-    scheduler_stats.tasks_suspended = 0;
-    scheduler_stats.context_switches = 0;
-    scheduler_stats.cpu_utilization = 0.0;
-    scheduler_stats.battery_saved = 0.0;
-    scheduler_stats.total_energy_consumed = 0;
+    ctx->stats.total_tasks_scheduled = 0;
+    ctx->stats.tasks_completed = 0;
+    ctx->stats.tasks_suspended = 0;
+    ctx->stats.context_switches = 0;
+    ctx->stats.cpu_utilization = 0.0;
+    ctx->stats.battery_saved = 0.0;
+    ctx->stats.total_energy_consumed = 0;
+    ctx->stats.aging_promotions = 0;
+    ctx->stats.tasks_dropped = 0;
+    ctx->stats.idle_wakeups = 0;
+    ctx->stats.dispatches = 0;
+    for (int phase = 0; phase < NUM_SCHED_PHASES; phase++) {
+        histogram_init(&ctx->stats.phase_ns[phase]);
+    }
     
-    is_initialized = true;
-    log_info("Scheduler initialized successfully");
+    // Idle waits use the monotonic clock so wall-clock jumps cannot stall them
+    pthread_condattr_t cond_attr;
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&ctx->event_cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+    ctx->pending_events = 0;
+    ctx->in_run_loop = false;
+    set_battery_event_callback_ctx(ctx, on_battery_event);
+    
+    ctx->initialized = true;
+    LOG_INFO("Scheduler initialized successfully");
     
     return SUCCESS;
 }
 
 // Cleanup scheduler
-void scheduler_cleanup(void) {
-    if (!is_initialized) {
+void scheduler_cleanup_ctx(SchedContext *ctx) {
+    if (!ctx->initialized) {
         return;
     }
     
-    scheduler_state.is_running = false;
+    ctx->state.is_running = false;
     
-    destroy_task_queue(scheduler_state.ready_queue);
-    destroy_task_queue(scheduler_state.waiting_queue);
+    destroy_task_queue(ctx->state.ready_queue);
+    destroy_task_heap(ctx->state.ready_heap);
+    destroy_task_queue(ctx->state.waiting_queue);
+    destroy_task_queue(ctx->state.deferred_queue);
+    set_battery_event_callback_ctx(ctx, NULL);
+    set_arrival_source_ctx(ctx, NULL, NULL);
+    set_task_done_hook_ctx(ctx, NULL, NULL);
+    pthread_cond_destroy(&ctx->event_cond);
     
-    task_manager_cleanup();
-    battery_monitor_cleanup();
+    task_manager_cleanup_ctx(ctx);
+    battery_monitor_cleanup_ctx(ctx);
     
-    is_initialized = false;
-    log_info("Scheduler cleaned up");
+    ctx->initialized = false;
+    LOG_INFO("Scheduler cleaned up");
 }
 
 
@@ -88,58 +705,59 @@ void scheduler_cleanup(void) {
 
 
 // Start scheduler
-int scheduler_start(void) {
-    if (!is_initialized) {
-        log_error("Scheduler not initialized");
+int scheduler_start_ctx(SchedContext *ctx) {
+    if (!ctx->initialized) {
+        LOG_ERROR("Scheduler not initialized");
         return ERROR;
     }
     
-    if (scheduler_state.is_running) {
-        log_error("Scheduler already running");
+    if (ctx->state.is_running) {
+        LOG_ERROR("Scheduler already running");
         return ERROR;
     }
     
-    scheduler_state.is_running = true;
-    log_info("Scheduler started");
+    ctx->state.is_running = true;
+    LOG_INFO("Scheduler started");
     
     return SUCCESS;
 }
 
 // Stop scheduler
-int scheduler_stop(void) {
-    if (!is_initialized) {
-        log_error("Scheduler not initialized");
+int scheduler_stop_ctx(SchedContext *ctx) {
+    if (!ctx->initialized) {
+        LOG_ERROR("Scheduler not initialized");
         return ERROR;
     }
     
-    scheduler_state.is_running = false;
-    log_info("Scheduler stopped");
+    ctx->state.is_running = false;
+    scheduler_notify_ctx(ctx, SCHED_EVENT_STOP);
+    LOG_INFO("Scheduler stopped");
     
     return SUCCESS;
 }
 
 // Pause scheduler
-int scheduler_pause(void) {
-    if (!is_initialized || !scheduler_state.is_running) {
-        log_error("Scheduler not running");
+int scheduler_pause_ctx(SchedContext *ctx) {
+    if (!ctx->initialized || !ctx->state.is_running) {
+        LOG_ERROR("Scheduler not running");
         return ERROR;
     }
     
-    scheduler_state.is_running = false;
-    log_info("Scheduler paused");
+    ctx->state.is_running = false;
+    LOG_INFO("Scheduler paused");
     
     return SUCCESS;
 }
 
 // Resume scheduler
-int scheduler_resume(void) {
-    if (!is_initialized) {
-        log_error("Scheduler not initialized");
+int scheduler_resume_ctx(SchedContext *ctx) {
+    if (!ctx->initialized) {
+        LOG_ERROR("Scheduler not initialized");
         return ERROR;
     }
     
-    scheduler_state.is_running = true;
-    log_info("Scheduler resumed");
+    ctx->state.is_running = true;
+    LOG_INFO("Scheduler resumed");
     
     return SUCCESS;
 }
@@ -149,131 +767,143 @@ int scheduler_resume(void) {
 
 
 // Set scheduler algorithm
-int set_scheduler_algorithm(SchedulerAlgorithm algorithm) {
-    if (!is_initialized) {
-        log_error("Scheduler not initialized");
+int set_scheduler_algorithm_ctx(SchedContext *ctx, SchedulerAlgorithm algorithm) {
+    if (!ctx->initialized) {
+        LOG_ERROR("Scheduler not initialized");
         return ERROR;
     }
     
-    scheduler_state.config.algorithm = algorithm;
+    ctx->state.config.algorithm = algorithm;
+    migrate_ready_tasks(ctx);
     
-    char log_msg[MAX_LOG_MSG];
-    snprintf(log_msg, MAX_LOG_MSG, "Scheduler algorithm changed to: %d", algorithm);
-    log_info(log_msg);
+    LOG_INFO("Scheduler algorithm changed to: %d", algorithm);
     
     return SUCCESS;
 }
 
 // Set scheduler mode
-int set_scheduler_mode(SchedulerMode mode) {
-    if (!is_initialized) {
-        log_error("Scheduler not initialized");
+int set_scheduler_mode_ctx(SchedContext *ctx, SchedulerMode mode) {
+    if (!ctx->initialized) {
+        LOG_ERROR("Scheduler not initialized");
         return ERROR;
     }
     
-    scheduler_state.mode = mode;
-    scheduler_state.config.mode = mode;
+    SCHED_TRACE(ctx, TRACE_MODE_CHANGE, -1, ctx->state.mode, mode, get_battery_level_ctx(ctx), 0);
+    ctx->state.mode = mode;
+    ctx->state.config.mode = mode;
     
-    char log_msg[MAX_LOG_MSG];
-    snprintf(log_msg, MAX_LOG_MSG, "Scheduler mode changed to: %d", mode);
-    log_info(log_msg);
+    LOG_INFO("Scheduler mode changed to: %d", mode);
     
     return SUCCESS;
 }
 
 // Set time quantum for round robin
-int set_time_quantum(int quantum_ms) {
-    if (!is_initialized) {
-        log_error("Scheduler not initialized");
+int set_time_quantum_ctx(SchedContext *ctx, int quantum_ms) {
+    if (!ctx->initialized) {
+        LOG_ERROR("Scheduler not initialized");
         return ERROR;
     }
     
-    scheduler_state.config.time_quantum = quantum_ms;
-    log_info("Time quantum updated");
+    ctx->state.config.time_quantum = quantum_ms;
+    LOG_INFO("Time quantum updated");
     
     return SUCCESS;
 }
 
 // Get scheduler configuration
-SchedulerConfig* get_scheduler_config(void) {
-    if (!is_initialized) {
+SchedulerConfig* get_scheduler_config_ctx(SchedContext *ctx) {
+    if (!ctx->initialized) {
         return NULL;
     }
-    return &scheduler_state.config;
+    return &ctx->state.config;
 }
 
 // Configure scheduler
-void configure_scheduler(SchedulerConfig *config) {
-    if (!is_initialized || config == NULL) {
-        log_error("Invalid configuration");
+void configure_scheduler_ctx(SchedContext *ctx, SchedulerConfig *config) {
+    if (!ctx->initialized || config == NULL) {
+        LOG_ERROR("Invalid configuration");
         return;
     }
     
-    scheduler_state.config = *config;
-    log_info("Scheduler configuration updated");
+    ctx->state.config = *config;
+    migrate_ready_tasks(ctx);
+    LOG_INFO("Scheduler configuration updated");
 }
 
 
 // MODE MANAGEMENT BASED ON BATTERY
 
 
-// Determine scheduler mode based on battery level
-SchedulerMode determine_scheduler_mode(int battery_level) {
-    if (battery_level <= BATTERY_CRITICAL) {
+// Scheduler mode for a battery level under a set of thresholds
+static SchedulerMode mode_for_level(const BatteryThresholds *thresholds, int battery_level) {
+    if (battery_level <= thresholds->critical_threshold) {
         return MODE_CRITICAL;
-    } else if (battery_level <= BATTERY_LOW) {
+    } else if (battery_level <= thresholds->low_threshold) {
         return MODE_POWER_SAVE;
-    } else if (battery_level <= BATTERY_MEDIUM) {
+    } else if (battery_level <= thresholds->medium_threshold) {
         return MODE_BALANCED;
     } else {
         return MODE_PERFORMANCE;
     }
 }
 
+// Determine scheduler mode based on battery level (default thresholds)
+SchedulerMode determine_scheduler_mode(int battery_level) {
+    static const BatteryThresholds defaults = {
+        BATTERY_CRITICAL, BATTERY_LOW, BATTERY_MEDIUM, BATTERY_HIGH
+    };
+    return mode_for_level(&defaults, battery_level);
+}
+
+// Determine scheduler mode under the context's battery thresholds
+SchedulerMode determine_scheduler_mode_ctx(SchedContext *ctx, int battery_level) {
+    return mode_for_level(&ctx->battery.thresholds, battery_level);
+}
+
 // Adjust scheduler based on battery level
-int adjust_scheduler_for_battery(void) {
-    if (!is_initialized) {
-        log_error("Scheduler not initialized");
+int adjust_scheduler_for_battery_ctx(SchedContext *ctx) {
+    if (!ctx->initialized) {
+        LOG_ERROR("Scheduler not initialized");
         return ERROR;
     }
     
-    int battery_level = get_battery_level();
-    SchedulerMode new_mode = determine_scheduler_mode(battery_level);
+    int battery_level = get_battery_level_ctx(ctx);
+    SchedulerMode new_mode = determine_scheduler_mode_ctx(ctx, battery_level);
     
-    if (new_mode != scheduler_state.mode) {
-        set_scheduler_mode(new_mode);
-        apply_power_saving_policies();
+    if (new_mode != ctx->state.mode) {
+        set_scheduler_mode_ctx(ctx, new_mode);
+        apply_power_saving_policies_ctx(ctx);
     }
     
     return SUCCESS;
 }
 
 // Apply power saving policies
-int apply_power_saving_policies(void) {
-    if (!is_initialized) {
+int apply_power_saving_policies_ctx(SchedContext *ctx) {
+    if (!ctx->initialized) {
         return ERROR;
     }
     
-    switch(scheduler_state.mode) {
+    switch(ctx->state.mode) {
         case MODE_CRITICAL:
             // Only run critical tasks
-            log_info("CRITICAL mode: Only critical tasks allowed");
+            LOG_INFO("CRITICAL mode: Only critical tasks allowed");
             // Suspend non-critical tasks from ready queue
             break;
             
         case MODE_POWER_SAVE:
             // Prefer low-energy tasks
-            log_info("POWER_SAVE mode: Prioritizing low-energy tasks");
+            LOG_INFO("POWER_SAVE mode: Prioritizing low-energy tasks");
             break;
             
         case MODE_BALANCED:
             // Balance between performance and energy
-            log_info("BALANCED mode: Balancing performance and energy");
+            LOG_INFO("BALANCED mode: Balancing performance and energy");
             break;
             
         case MODE_PERFORMANCE:
             // Normal operation
-            log_info("PERFORMANCE mode: Normal operation");
+            LOG_INFO("PERFORMANCE mode: Normal operation");
             break;
     }
     
@@ -285,26 +915,26 @@ int apply_power_saving_policies(void) {
 
 
 // Check if task can be admitted
-bool can_admit_task(Task *task) {
-    if (!is_initialized || task == NULL) {
+bool can_admit_task_ctx(SchedContext *ctx, Task *task) {
+    if (!ctx->initialized || task == NULL) {
         return false;
     }
     
-    int battery_level = get_battery_level();
+    int battery_level = get_battery_level_ctx(ctx);
     
     // In critical mode, only admit critical tasks
-    if (scheduler_state.mode == MODE_CRITICAL && !task->is_critical) {
+    if (ctx->state.mode == MODE_CRITICAL && !task->is_critical) {
         return false;
     }
     
     // In power save mode, avoid high-energy tasks unless critical
-    if (scheduler_state.mode == MODE_POWER_SAVE && 
+    if (ctx->state.mode == MODE_POWER_SAVE && 
         task->energy_cost == ENERGY_HIGH && !task->is_critical) {
         return false;
     }
     
     // Check if battery can handle the task
-    if (battery_level < BATTERY_CRITICAL && task->energy_cost > ENERGY_LOW) {
+    if (battery_level < ctx->battery.thresholds.critical_threshold && task->energy_cost > ENERGY_LOW) {
         return false;
     }
     
@@ -312,28 +942,29 @@ bool can_admit_task(Task *task) {
 }
 
 // Admit task to scheduler
-int admit_task_to_scheduler(Task *task) {
-    if (!is_initialized || task == NULL) {
-        log_error("Invalid task or scheduler not initialized");
+int admit_task_to_scheduler_ctx(SchedContext *ctx, Task *task) {
+    if (!ctx->initialized || task == NULL) {
+        LOG_ERROR("Invalid task or scheduler not initialized");
         return ERROR;
     }
     
-    if (!can_admit_task(task)) {
-        log_error("Task admission denied due to battery constraints");
+    if (!can_admit_task_ctx(ctx, task)) {
+        LOG_ERROR("Task admission denied due to battery constraints");
         return ERROR;
     }
     
-    if (enqueue_task(scheduler_state.ready_queue, task) != SUCCESS) {
-        log_error("Failed to enqueue task");
+    if (enqueue_ready_task(ctx, task) != SUCCESS) {
+        LOG_ERROR("Failed to enqueue task");
         return ERROR;
     }
     
-    scheduler_stats.total_tasks_scheduled++;
+    ctx->stats.total_tasks_scheduled++;
+    scheduler_notify_ctx(ctx, SCHED_EVENT_TASK_READY);
+    SCHED_TRACE(ctx, TRACE_ADMIT, task->task_id, task->priority, task->energy_cost, 
+                 task->burst_time, task->deadline);
     
-    char log_msg[MAX_LOG_MSG];
-    snprintf(log_msg, MAX_LOG_MSG, "Task admitted: ID=%d, Name=%s", 
+    LOG_INFO("Task admitted: ID=%d, Name=%s", 
              task->task_id, task->task_name);
-    log_info(log_msg);
     
     return SUCCESS;
 }
@@ -343,74 +974,143 @@ int admit_task_to_scheduler(Task *task) {
 
 
 // Select next task based on algorithm
-Task* select_next_task(void) {
-    if (!is_initialized) {
+Task* select_next_task_ctx(SchedContext *ctx) {
+    if (!ctx->initialized) {
         return NULL;
     }
     
-    switch(scheduler_state.config.algorithm) {
+    process_aging_timers(ctx);
+    
+    Task *task;
+    switch(ctx->state.config.algorithm) {
         case SCHEDULER_FCFS:
-            return schedule_fcfs();
+            task = schedule_fcfs_ctx(ctx);
+            break;
         case SCHEDULER_SJF:
-            return schedule_sjf();
+            task = schedule_sjf_ctx(ctx);
+            break;
         case SCHEDULER_PRIORITY:
-            return schedule_priority();
+            task = schedule_priority_ctx(ctx);
+            break;
         case SCHEDULER_ROUND_ROBIN:
-            return schedule_round_robin();
+            task = schedule_round_robin_ctx(ctx);
+            break;
+        case SCHEDULER_EDF:
+            task = schedule_edf_ctx(ctx);
+            break;
+        case SCHEDULER_ENERGY_EDF:
+            task = schedule_energy_edf_ctx(ctx);
+            break;
+        case SCHEDULER_CFS:
+            task = schedule_cfs_ctx(ctx);
+            break;
         case SCHEDULER_BATTERY_AWARE:
-            return schedule_battery_aware();
         default:
-            return schedule_battery_aware();
+            task = schedule_battery_aware_ctx(ctx);
+            break;
     }
+    
+    return dispatch_ready_task(ctx, task);
 }
 
 // Schedule a task
-int schedule_task(Task *task) {
-    if (!is_initialized || task == NULL) {
+int schedule_task_ctx(SchedContext *ctx, Task *task) {
+    if (!ctx->initialized || task == NULL) {
         return ERROR;
     }
     
-    scheduler_state.current_task = task;
-    set_task_state(task, TASK_STATE_RUNNING);
+    ctx->state.current_task = task;
+    set_task_state_ctx(ctx, task, TASK_STATE_RUNNING);
+    ctx->stats.dispatches++;
+    SCHED_TRACE(ctx, TRACE_DISPATCH, task->task_id, ctx->state.config.algorithm, 
+                 ctx->state.mode, task->remaining_time, get_battery_level_ctx(ctx));
     
-    char log_msg[MAX_LOG_MSG];
-    snprintf(log_msg, MAX_LOG_MSG, "Scheduled task: ID=%d, Name=%s", 
+    LOG_INFO("Scheduled task: ID=%d, Name=%s", 
              task->task_id, task->task_name);
-    log_info(log_msg);
     
     return SUCCESS;
 }
 
-// Execute a task
-int execute_task(Task *task) {
-    if (!is_initialized || task == NULL) {
-        return ERROR;
+// CFS weight of a priority level (HIGH runs 3x as much as LOW per vruntime)
+static int cfs_weight(const Task *task) {
+    static const int priority_weight[] = {3, 3, 2, 1};
+    int priority = task->priority;
+    if (priority < PRIORITY_HIGH || priority > PRIORITY_LOW) {
+        priority = PRIORITY_MEDIUM;
+    }
+    return priority_weight[priority];
+}
+
+// Advance a task's vruntime for time it ran, scaled by energy over weight
+static void charge_vruntime(Task *task, int ran_ms) {
+    task->vruntime += (long)ran_ms * CFS_VRUNTIME_SCALE * max(task->energy_cost, 1) / 
+                      cfs_weight(task);
+}
+
+// Slice a task may run before the next scheduling decision
+static int get_time_slice(SchedContext *ctx) {
+    if (ctx->state.config.algorithm != SCHEDULER_CFS) {
+        return ctx->state.config.time_quantum;
     }
     
-    char log_msg[MAX_LOG_MSG];
-    snprintf(log_msg, MAX_LOG_MSG, "Executing task: ID=%d for %d ms", 
-             task->task_id, min(task->remaining_time, scheduler_state.config.time_quantum));
-    log_info(log_msg);
-    
-    // Simulate task execution
-    int execution_time = min(task->remaining_time, scheduler_state.config.time_quantum);
-    sleep_ms(execution_time);
-    
+    // Every runnable task gets a turn within the target latency, but slices
+    // never shrink below the minimum granularity
+    int runnable = get_heap_size(ctx->state.ready_heap) + 1;
+    return max(CFS_TARGET_LATENCY_MS / runnable, max(ctx->state.config.min_granularity, 1));
+}
+
+// Let an execution slice pass. In the run loop a wall-clock slice waits on
+// the event condition instead of sleeping, so admissions and battery events
+// can take the scheduler lock while the task runs; their events stay pending
+// for the next decision.
+static void run_slice(SchedContext *ctx, int milliseconds) {
+    if (!ctx->in_run_loop || ctx->clock->mode == CLOCK_MODE_VIRTUAL) {
+        sim_clock_sleep_ms(ctx->clock, milliseconds);
+        return;
+    }
+    
+    struct timespec until = monotonic_deadline(milliseconds);
+    while (pthread_cond_timedwait(&ctx->event_cond, &ctx->mutex, &until) != ETIMEDOUT) {
+    }
+}
+
+// Execute a task
+int execute_task_ctx(SchedContext *ctx, Task *task) {
+    if (!ctx->initialized || task == NULL) {
+        return ERROR;
+    }
+    
+    LOG_INFO("Executing task: ID=%d for %d ms", 
+             task->task_id, min(task->remaining_time, get_time_slice(ctx)));
+    
+    // Simulate task execution
+    int execution_time = min(task->remaining_time, get_time_slice(ctx));
+    run_slice(ctx, execution_time);
+    
     task->remaining_time -= execution_time;
+    update_task_keys_ctx(ctx, task);
+    if (ctx->state.config.algorithm == SCHEDULER_CFS) {
+        charge_vruntime(task, execution_time);
+    }
     
     // Simulate battery drain
-    simulate_battery_drain(task->energy_cost);
-    scheduler_stats.total_energy_consumed += task->energy_cost;
+    simulate_battery_drain_ctx(ctx, task->energy_cost);
+    ctx->stats.total_energy_consumed += task->energy_cost;
+    SCHED_TRACE(ctx, TRACE_BATTERY, task->task_id, get_battery_level_ctx(ctx), get_battery_state_ctx(ctx), 
+                 task->energy_cost, 0);
     
     // Check if task completed
     if (task->remaining_time <= 0) {
-        set_task_state(task, TASK_STATE_COMPLETED);
-        scheduler_stats.tasks_completed++;
+        set_task_state_ctx(ctx, task, TASK_STATE_COMPLETED);
+        ctx->stats.tasks_completed++;
+        SCHED_TRACE(ctx, TRACE_COMPLETE, task->task_id, (int32_t)(task->waiting_time_ns / NS_PER_US),
+                     (int32_t)(task->turnaround_time_ns / NS_PER_US),
+                     task->deadline > 0 && task->turnaround_time_ns > (int64_t)task->deadline * NS_PER_MS,
+                     0);
         
-        snprintf(log_msg, MAX_LOG_MSG, "Task completed: ID=%d", task->task_id);
-        log_info(log_msg);
+        LOG_INFO("Task completed: ID=%d", task->task_id);
         
-        scheduler_state.current_task = NULL;
+        ctx->state.current_task = NULL;
         return SUCCESS;
     }
     
@@ -418,50 +1118,49 @@ int execute_task(Task *task) {
 }
 
 // Preempt a task
-int preempt_task(Task *task) {
-    if (!is_initialized || task == NULL) {
+int preempt_task_ctx(SchedContext *ctx, Task *task) {
+    if (!ctx->initialized || task == NULL) {
         return ERROR;
     }
     
-    set_task_state(task, TASK_STATE_READY);
-    enqueue_task(scheduler_state.ready_queue, task);
+    set_task_state_ctx(ctx, task, TASK_STATE_READY);
+    enqueue_ready_task(ctx, task);
+    SCHED_TRACE(ctx, TRACE_PREEMPT, task->task_id, task->remaining_time, 0, 0, 0);
     
-    char log_msg[MAX_LOG_MSG];
-    snprintf(log_msg, MAX_LOG_MSG, "Task preempted: ID=%d", task->task_id);
-    log_info(log_msg);
+    LOG_INFO("Task preempted: ID=%d", task->task_id);
     
     return SUCCESS;
 }
 
 // Suspend a task
-int suspend_task(Task *task) {
-    if (!is_initialized || task == NULL) {
+int suspend_task_ctx(SchedContext *ctx, Task *task) {
+    if (!ctx->initialized || task == NULL) {
         return ERROR;
     }
     
-    set_task_state(task, TASK_STATE_SUSPENDED);
-    enqueue_task(scheduler_state.waiting_queue, task);
-    scheduler_stats.tasks_suspended++;
+    set_task_state_ctx(ctx, task, TASK_STATE_SUSPENDED);
+    enqueue_task(ctx->state.waiting_queue, task);
+    ctx->stats.tasks_suspended++;
+    SCHED_TRACE(ctx, TRACE_SUSPEND, task->task_id, task->remaining_time, 0, 0, 0);
     
-    char log_msg[MAX_LOG_MSG];
-    snprintf(log_msg, MAX_LOG_MSG, "Task suspended: ID=%d", task->task_id);
-    log_info(log_msg);
+    LOG_INFO("Task suspended: ID=%d", task->task_id);
     
     return SUCCESS;
 }
 
 // Resume a task
-int resume_task(Task *task) {
-    if (!is_initialized || task == NULL) {
+int resume_task_ctx(SchedContext *ctx, Task *task) {
+    if (!ctx->initialized || task == NULL) {
         return ERROR;
     }
     
-    set_task_state(task, TASK_STATE_READY);
-    enqueue_task(scheduler_state.ready_queue, task);
+    remove_queued_task(ctx->state.waiting_queue, task);
+    set_task_state_ctx(ctx, task, TASK_STATE_READY);
+    enqueue_ready_task(ctx, task);
+    scheduler_notify_ctx(ctx, SCHED_EVENT_TASK_READY);
+    SCHED_TRACE(ctx, TRACE_RESUME, task->task_id, task->remaining_time, 0, 0, 0);
     
-    char log_msg[MAX_LOG_MSG];
-    snprintf(log_msg, MAX_LOG_MSG, "Task resumed: ID=%d", task->task_id);
-    log_info(log_msg);
+    LOG_INFO("Task resumed: ID=%d", task->task_id);
     
     return SUCCESS;
 }
@@ -471,121 +1170,195 @@ int resume_task(Task *task) {
 
 
 // First Come First Serve
-Task* schedule_fcfs(void) {
-    if (is_queue_empty(scheduler_state.ready_queue)) {
+Task* schedule_fcfs_ctx(SchedContext *ctx) {
+    if (is_queue_empty(ctx->state.ready_queue)) {
         return NULL;
     }
     
-    return dequeue_task(scheduler_state.ready_queue);
+    return pop_ready_fifo(ctx);
 }
 
-// Shortest Job First
-Task* schedule_sjf(void) {
-    if (is_queue_empty(scheduler_state.ready_queue)) {
+// Shortest Job First (least remaining time, from the keyed ready queue)
+Task* schedule_sjf_ctx(SchedContext *ctx) {
+    if (is_heap_empty(ctx->state.ready_heap)) {
         return NULL;
     }
     
-    // Find task with shortest burst time
-    TaskQueue *queue = scheduler_state.ready_queue;
-    int shortest_index = queue->front;
-    int shortest_time = queue->tasks[shortest_index].burst_time;
+    return heap_pop_task(ctx->state.ready_heap);
+}
+
+// Priority-based scheduling (lowest number = highest priority)
+Task* schedule_priority_ctx(SchedContext *ctx) {
+    if (is_heap_empty(ctx->state.ready_heap)) {
+        return NULL;
+    }
     
-    int index = queue->front;
-    for (int i = 0; i < queue->count; i++) {
-        if (queue->tasks[index].burst_time < shortest_time) {
-            shortest_index = index;
-            shortest_time = queue->tasks[index].burst_time;
-        }
-        index = (index + 1) % MAX_TASKS;
+    return heap_pop_task(ctx->state.ready_heap);
+}
+
+// Round Robin scheduling
+Task* schedule_round_robin_ctx(SchedContext *ctx) {
+    if (is_queue_empty(ctx->state.ready_queue)) {
+        return NULL;
     }
     
-    // For simplicity, just dequeue front (in full implementation, would remove shortest)
-    return dequeue_task(queue);
+    return pop_ready_fifo(ctx);
 }
 
-// Priority-based scheduling
-Task* schedule_priority(void) {
-    if (is_queue_empty(scheduler_state.ready_queue)) {
+// Battery-aware scheduling: first non-empty bucket in the current mode's
+// search order (CRITICAL mode only ever considers critical buckets)
+Task* schedule_battery_aware_ctx(SchedContext *ctx) {
+    if (ctx->state.runqueue.count == 0) {
         return NULL;
     }
     
-    // Find highest priority task (lowest number = highest priority)
-    TaskQueue *queue = scheduler_state.ready_queue;
-    int best_index = queue->front;
-    int best_priority = queue->tasks[best_index].priority;
+    LOG_DEBUG("Battery-aware scheduling: Battery=%d%%, Mode=%d",
+              get_battery_level_ctx(ctx), ctx->state.mode);
     
-    int index = queue->front;
-    for (int i = 0; i < queue->count; i++) {
-        if (queue->tasks[index].priority < best_priority) {
-            best_index = index;
-            best_priority = queue->tasks[index].priority;
-        }
-        index = (index + 1) % MAX_TASKS;
+    return runqueue_pick(&ctx->state.runqueue, ctx->state.mode);
+}
+
+// Earliest Deadline First (from the keyed ready queue)
+Task* schedule_edf_ctx(SchedContext *ctx) {
+    if (is_heap_empty(ctx->state.ready_heap)) {
+        return NULL;
     }
     
-    // For simplicity, just dequeue front
-    return dequeue_task(queue);
+    return heap_pop_task(ctx->state.ready_heap);
 }
 
-// Round Robin scheduling
-Task* schedule_round_robin(void) {
-    if (is_queue_empty(scheduler_state.ready_queue)) {
-        return NULL;
+// Time since a task arrived
+static int task_age_ms(SchedContext *ctx, const Task *task) {
+    return (int)((sim_clock_ns(ctx->clock) - task->arrival_time_ns) / NS_PER_MS);
+}
+
+// Battery percentage a task still needs: one drain step per quantum it runs
+static int estimate_task_energy(SchedContext *ctx, const Task *task) {
+    int quantum = max(ctx->state.config.time_quantum, 1);
+    int quanta = (task->remaining_time + quantum - 1) / quantum;
+    return quanta * task->energy_cost;
+}
+
+// Abandon a task that can no longer finish before its deadline
+static void drop_task(SchedContext *ctx, Task *task) {
+    timer_wheel_cancel(&ctx->state.aging_wheel, &task->aging_timer);
+    set_task_state_ctx(ctx, task, TASK_STATE_DROPPED);
+    ctx->stats.tasks_dropped++;
+    SCHED_TRACE(ctx, TRACE_DROP, task->task_id, task->remaining_time, task->deadline, 0, 0);
+    
+    LOG_INFO("Task dropped: ID=%d cannot meet its deadline", 
+             task->task_id);
+    task_done(ctx, task);
+}
+
+// Time after which a task can no longer meet its deadline (LONG_MAX = none)
+static long task_hopeless_after_ms(const Task *task) {
+    if (task->deadline <= 0) {
+        return LONG_MAX;
+    }
+    return (long)(task->arrival_time_ns / NS_PER_MS) + task->deadline - task->remaining_time;
+}
+
+// Note when a deferred task could next become affordable or hopeless
+static void track_deferred_task(SchedContext *ctx, const Task *task) {
+    long expiry = task_hopeless_after_ms(task);
+    ctx->state.deferred_min_energy = min(ctx->state.deferred_min_energy, 
+                                         estimate_task_energy(ctx, task));
+    if (expiry < ctx->state.deferred_expiry_ms) {
+        ctx->state.deferred_expiry_ms = expiry;
     }
+}
+
+// Hold back a task the battery cannot pay for until the budget covers it
+static void defer_task(SchedContext *ctx, Task *task) {
+    set_task_state_ctx(ctx, task, TASK_STATE_SUSPENDED);
+    enqueue_task(ctx->state.deferred_queue, task);
+    track_deferred_task(ctx, task);
+    ctx->stats.tasks_suspended++;
+    SCHED_TRACE(ctx, TRACE_SUSPEND, task->task_id, task->remaining_time, 0, 0, 0);
     
-    return dequeue_task(scheduler_state.ready_queue);
+    LOG_INFO("Task deferred: ID=%d needs %d%% battery", 
+             task->task_id, estimate_task_energy(ctx, task));
 }
 
-// Battery-aware scheduling
-Task* schedule_battery_aware(void) {
-    if (is_queue_empty(scheduler_state.ready_queue)) {
-        return NULL;
+// Return deferred tasks to the ready heap once the budget covers them and
+// drop those that can no longer meet their deadline; the queue is only
+// scanned when one of the two may have happened
+static void recheck_deferred_tasks(SchedContext *ctx, int budget) {
+    TaskQueue *deferred = ctx->state.deferred_queue;
+    if (is_queue_empty(deferred) ||
+        (budget < ctx->state.deferred_min_energy && 
+         sim_clock_ms(ctx->clock) <= ctx->state.deferred_expiry_ms)) {
+        return;
     }
     
-    int battery_level = get_battery_level();
-    TaskQueue *queue = scheduler_state.ready_queue;
-    char log_msg[MAX_LOG_MSG];
-    snprintf(log_msg, MAX_LOG_MSG, "Battery-aware scheduling: Battery=%d%%, Mode=%d",
-             battery_level, scheduler_state.mode);
-    log_debug(log_msg);
-    
-    // Adjust scheduling based on battery mode
-    if (scheduler_state.mode == MODE_CRITICAL) {
-        // Only select critical tasks
-        int index = queue->front;
-        for (int i = 0; i < queue->count; i++) {
-            if (queue->tasks[index].is_critical) {
-                // For simplicity, dequeue front
-                return dequeue_task(queue);
-            }
-            index = (index + 1) % MAX_TASKS;
+    ctx->state.deferred_min_energy = INT_MAX;
+    ctx->state.deferred_expiry_ms = LONG_MAX;
+    for (int i = get_queue_size(deferred); i > 0; i--) {
+        Task *task = dequeue_task(deferred);
+        
+        if (task->deadline > 0 && task_age_ms(ctx, task) + task->remaining_time > task->deadline) {
+            drop_task(ctx, task);
+        } else if (estimate_task_energy(ctx, task) <= budget) {
+            set_task_state_ctx(ctx, task, TASK_STATE_READY);
+            enqueue_ready_task(ctx, task);
+            SCHED_TRACE(ctx, TRACE_RESUME, task->task_id, task->remaining_time, 0, 0, 0);
+            LOG_INFO("Deferred task resumed: ID=%d", task->task_id);
+        } else {
+            enqueue_task(deferred, task);
+            track_deferred_task(ctx, task);
         }
-        return NULL;  // No critical tasks available
     }
+}
+
+// Drop every task still deferred; the run loop calls this when it gives up
+// so each admitted task is either completed or counted as dropped
+static void drop_deferred_tasks(SchedContext *ctx) {
+    while (!is_queue_empty(ctx->state.deferred_queue)) {
+        drop_task(ctx, dequeue_task(ctx->state.deferred_queue));
+    }
+    ctx->state.deferred_min_energy = INT_MAX;
+    ctx->state.deferred_expiry_ms = LONG_MAX;
+}
+
+// Energy-aware EDF: earliest deadline first, except that non-critical tasks
+// which can no longer meet their deadline are dropped, and those the battery
+// above the critical reserve cannot pay for are deferred until it can
+Task* schedule_energy_edf_ctx(SchedContext *ctx) {
+    int budget = get_battery_level_ctx(ctx) - ctx->battery.thresholds.critical_threshold;
+    recheck_deferred_tasks(ctx, budget);
     
-    if (scheduler_state.mode == MODE_POWER_SAVE) {
-        // Prefer low-energy tasks
-        int best_index = queue->front;
-        int best_energy = queue->tasks[best_index].energy_cost;
-        int best_priority = queue->tasks[best_index].priority;
+    while (!is_heap_empty(ctx->state.ready_heap)) {
+        Task *task = heap_pop_task(ctx->state.ready_heap);
         
-        int index = queue->front;
-        for (int i = 0; i < queue->count; i++) {
-            Task *t = &queue->tasks[index];
-            // Prioritize: critical > low energy > high priority
-            if (t->is_critical || 
-                (t->energy_cost < best_energy) ||
-                (t->energy_cost == best_energy && t->priority < best_priority)) {
-                best_index = index;
-                best_energy = t->energy_cost;
-                best_priority = t->priority;
-            }
-            index = (index + 1) % MAX_TASKS;
+        if (task->is_critical) {
+            return task;
         }
+        if (task->deadline > 0 && task_age_ms(ctx, task) + task->remaining_time > task->deadline) {
+            drop_task(ctx, task);
+            continue;
+        }
+        if (estimate_task_energy(ctx, task) > budget) {
+            defer_task(ctx, task);
+            continue;
+        }
+        return task;
+    }
+    
+    return NULL;
+}
+
+// Completely fair scheduling: smallest energy-weighted vruntime first
+Task* schedule_cfs_ctx(SchedContext *ctx) {
+    if (is_heap_empty(ctx->state.ready_heap)) {
+        return NULL;
     }
     
-    // Default: consider both priority and energy
-    return dequeue_task(queue);
+    Task *task = heap_pop_task(ctx->state.ready_heap);
+    if (task->vruntime > ctx->state.min_vruntime) {
+        ctx->state.min_vruntime = task->vruntime;
+    }
+    return task;
 }
 
 
@@ -593,86 +1366,155 @@ Task* schedule_battery_aware(void) {
 
 
 // Perform context switch
-int perform_context_switch(Task *old_task, Task *new_task) {
-    if (!is_initialized) {
+int perform_context_switch_ctx(SchedContext *ctx, Task *old_task, Task *new_task) {
+    if (!ctx->initialized) {
         return ERROR;
     }
     
-    scheduler_state.context_switches++;
-    scheduler_stats.context_switches++;
+    ctx->state.context_switches++;
+    ctx->stats.context_switches++;
+    SCHED_TRACE(ctx, TRACE_CONTEXT_SWITCH, new_task ? new_task->task_id : -1, 
+                 old_task ? old_task->task_id : -1, ctx->stats.context_switches, 0, 0);
     
-    char log_msg[MAX_LOG_MSG];
-    snprintf(log_msg, MAX_LOG_MSG, "Context switch: Old=%d, New=%d", 
-             old_task ? old_task->task_id : 0, 
-             new_task ? new_task->task_id : 0);
-    log_debug(log_msg);
+    LOG_DEBUG("Context switch: Old=%d, New=%d", 
+              old_task ? old_task->task_id : 0, 
+              new_task ? new_task->task_id : 0);
     
     return SUCCESS;
 }
 
 
+// PHASE TIMING
+
+
+#if SCHED_PROFILE
+// Close the phase that began at ctx->phase_mark and record its duration
+static void end_phase(SchedContext *ctx, SchedulerPhase phase) {
+    int64_t now = get_monotonic_ns();
+    int64_t elapsed = now - ctx->phase_mark;
+    histogram_record(&ctx->stats.phase_ns[phase], elapsed);
+    if (phase != SCHED_PHASE_EXECUTE) {
+        ctx->decision_ns += elapsed;
+    }
+    ctx->phase_mark = now;
+}
+
+#define PHASE_BEGIN() (ctx->phase_mark = get_monotonic_ns(), ctx->decision_ns = 0)
+#define PHASE_END(phase) end_phase(ctx, phase)
+#define PHASE_DECISION_END() \
+    histogram_record(&ctx->stats.phase_ns[SCHED_PHASE_DECISION], ctx->decision_ns)
+#else
+#define PHASE_BEGIN() ((void)0)
+#define PHASE_END(phase) ((void)0)
+#define PHASE_DECISION_END() ((void)0)
+#endif
+
+
 // SCHEDULER MAIN LOOP
 
 
 // Main scheduler loop
-void scheduler_run_loop(void) {
-    if (!is_initialized) {
-        log_error("Scheduler not initialized");
+void scheduler_run_loop_ctx(SchedContext *ctx) {
+    if (!ctx->initialized) {
+        LOG_ERROR("Scheduler not initialized");
         return;
     }
-
-    log_info("Entering scheduler main loop");
-    int idle_count = 0;  // ← ADD THIS: Track consecutive idles
-    const int MAX_IDLE = 10;  // ← Maximum idle iterations before exit
     
-    while (scheduler_state.is_running) {
+    scheduler_lock_ctx(ctx);
+    ctx->in_run_loop = true;
+    LOG_INFO("Entering scheduler main loop");
+    ctx->pending_events = 0;
+    long idle_deadline = -1;  // When an idle loop gives up (-1 = not idle)
+    
+    while (ctx->state.is_running) {
+        long next_arrival = poll_arrivals(ctx);
+        PHASE_BEGIN();
+        
         // Update battery status
-        update_battery_status();
+        update_battery_status_ctx(ctx);
+        PHASE_END(SCHED_PHASE_BATTERY);
         
         // Adjust scheduler mode based on battery
-        adjust_scheduler_for_battery();
+        adjust_scheduler_for_battery_ctx(ctx);
+        PHASE_END(SCHED_PHASE_MODE);
         
-        // Select next task
-        Task *next_task = select_next_task();
+        // Select next task; without preemption the running task keeps the
+        // processor until it finishes
+        Task *next_task = ctx->state.current_task;
+        if (ctx->state.config.enable_preemption || next_task == NULL ||
+            next_task->state != TASK_STATE_RUNNING) {
+            next_task = select_next_task_ctx(ctx);
+        }
+        PHASE_END(SCHED_PHASE_SELECT);
         
         if (next_task != NULL) {
-            idle_count = 0;  // ← Reset idle counter when task found
+            idle_deadline = -1;
             
             // Context switch if different task
-            if (scheduler_state.current_task != next_task) {
-                perform_context_switch(scheduler_state.current_task, next_task);
+            if (ctx->state.current_task != next_task) {
+                perform_context_switch_ctx(ctx, ctx->state.current_task, next_task);
+                PHASE_END(SCHED_PHASE_SWITCH);
             }
             
             // Schedule and execute task
-            schedule_task(next_task);
-            execute_task(next_task);
+            schedule_task_ctx(ctx, next_task);
+            execute_task_ctx(ctx, next_task);
+            PHASE_END(SCHED_PHASE_EXECUTE);
             
             // If task still has remaining time and preemption enabled, re-queue
-            if (next_task->remaining_time > 0 && scheduler_state.config.enable_preemption) {
-                preempt_task(next_task);
+            if (next_task->remaining_time > 0 && ctx->state.config.enable_preemption) {
+                preempt_task_ctx(ctx, next_task);
+                PHASE_END(SCHED_PHASE_REQUEUE);
             }
-        } else {
-            // No tasks available, idle
-            log_debug("No tasks in ready queue, idling...");
-            sleep_ms(100);
-            idle_count++;  // ← INCREMENT idle counter
+            PHASE_DECISION_END();
             
-            // ← ADD THIS: Exit if too many consecutive idles
-            if (idle_count >= MAX_IDLE) {
-                log_info("Maximum idle iterations reached - stopping scheduler");
+            if (next_task->state == TASK_STATE_COMPLETED) {
+                task_done(ctx, next_task);
+            }
+        } else {
+            // No tasks available: block until a task becomes ready or
+            // arrives, the battery changes, the next aging timer is due or
+            // the idle timeout expires (never while arrivals are pending)
+            long now = sim_clock_ms(ctx->clock);
+            if (idle_deadline < 0 || next_arrival >= 0) {
+                idle_deadline = now + SCHEDULER_IDLE_TIMEOUT_MS;
+            }
+            if (now >= idle_deadline) {
+                LOG_INFO("Idle timeout reached - stopping scheduler");
+                drop_deferred_tasks(ctx);
                 break;
             }
+            
+            long wake_at = idle_deadline;
+            if (next_arrival >= 0 && next_arrival < wake_at) {
+                wake_at = next_arrival;
+            }
+            long next_timer = timer_wheel_next_expiry(&ctx->state.aging_wheel);
+            if (next_timer >= 0 && next_timer < wake_at) {
+                wake_at = next_timer;
+            }
+            // A deferred task is dropped just after its last feasible start
+            if (ctx->state.deferred_expiry_ms < wake_at) {
+                wake_at = ctx->state.deferred_expiry_ms + 1;
+            }
+            
+            LOG_DEBUG("No tasks in ready queue, waiting for an event...");
+            if (wait_for_event(ctx, wake_at) != 0) {
+                idle_deadline = -1;  // Activity restarts the idle timeout
+            }
         }
         
-        // ← ADD THIS: Exit if battery critical and no tasks
-        if (get_battery_level() <= BATTERY_CRITICAL && 
-            is_queue_empty(scheduler_state.ready_queue)) {
-            log_info("Battery critical and queue empty - stopping scheduler");
+        // Exit if battery critical and no tasks are ready or deferred
+        if (get_battery_level_ctx(ctx) <= ctx->battery.thresholds.critical_threshold &&
+            get_ready_count(ctx) == 0 && is_queue_empty(ctx->state.deferred_queue)) {
+            LOG_INFO("Battery critical and queue empty - stopping scheduler");
             break;
         }
     }
     
-    log_info("Exiting scheduler main loop");
+    LOG_INFO("Exiting scheduler main loop");
+    ctx->in_run_loop = false;
+    scheduler_unlock_ctx(ctx);
 }
 
 
@@ -680,51 +1522,85 @@ void scheduler_run_loop(void) {
 
 
 // Get scheduler statistics
-SchedulerStats* get_scheduler_statistics(void) {
-    return &scheduler_stats;
+SchedulerStats* get_scheduler_statistics_ctx(SchedContext *ctx) {
+    return &ctx->stats;
+}
+
+// Bytes allocated by the ready structures, waiting queue and task manager
+size_t get_scheduler_memory_usage_ctx(SchedContext *ctx) {
+    if (!ctx->initialized) {
+        return 0;
+    }
+    
+    size_t bytes = get_task_memory_usage_ctx(ctx);
+    bytes += (size_t)ctx->state.ready_queue->capacity * sizeof(Task*);
+    bytes += (size_t)ctx->state.ready_heap->capacity * sizeof(Task*);
+    bytes += (size_t)ctx->state.waiting_queue->capacity * sizeof(Task*);
+    bytes += (size_t)ctx->state.deferred_queue->capacity * sizeof(Task*);
+    return bytes;
 }
 
 // Update scheduler statistics
-void update_scheduler_statistics(void) {
-    TaskStats *task_stats = get_task_statistics();
+void update_scheduler_statistics_ctx(SchedContext *ctx) {
+    TaskStats *task_stats = get_task_statistics_ctx(ctx);
     
     if (task_stats->total_tasks > 0) {
-        scheduler_stats.cpu_utilization = 
+        ctx->stats.cpu_utilization = 
             calculate_percentage(task_stats->completed_tasks, task_stats->total_tasks);
     }
 }
 
 // Print scheduler status
-void print_scheduler_status(void) {
+void print_scheduler_status_ctx(SchedContext *ctx) {
     printf("\n=== Scheduler Status ===\n");
-    printf("Algorithm: %d\n", scheduler_state.config.algorithm);
+    printf("Algorithm: %d\n", ctx->state.config.algorithm);
     printf("Mode: ");
-    switch(scheduler_state.mode) {
+    switch(ctx->state.mode) {
         case MODE_PERFORMANCE: printf("PERFORMANCE\n"); break;
         case MODE_BALANCED: printf("BALANCED\n"); break;
         case MODE_POWER_SAVE: printf("POWER_SAVE\n"); break;
         case MODE_CRITICAL: printf("CRITICAL\n"); break;
     }
-    printf("Running: %s\n", scheduler_state.is_running ? "YES" : "NO");
-    printf("Ready Queue Size: %d\n", get_queue_size(scheduler_state.ready_queue));
-    printf("Waiting Queue Size: %d\n", get_queue_size(scheduler_state.waiting_queue));
-    printf("Context Switches: %d\n", scheduler_state.context_switches);
+    printf("Running: %s\n", ctx->state.is_running ? "YES" : "NO");
+    printf("Ready Queue Size: %d\n", get_ready_count(ctx));
+    printf("Waiting Queue Size: %d\n", get_queue_size(ctx->state.waiting_queue));
+    printf("Deferred Queue Size: %d\n", get_queue_size(ctx->state.deferred_queue));
+    printf("Context Switches: %d\n", ctx->state.context_switches);
     printf("=======================\n\n");
 }
 
 // Print scheduler statistics
-void print_scheduler_statistics(void) {
+void print_scheduler_statistics_ctx(SchedContext *ctx) {
     printf("\n=== Scheduler Statistics ===\n");
-    printf("Total Tasks Scheduled: %d\n", scheduler_stats.total_tasks_scheduled);
-    printf("Tasks Completed: %d\n", scheduler_stats.tasks_completed);
-    printf("Tasks Suspended: %d\n", scheduler_stats.tasks_suspended);
-    printf("Context Switches: %d\n", scheduler_stats.context_switches);
-    printf("CPU Utilization: %.2f%%\n", scheduler_stats.cpu_utilization);
-    printf("Battery Saved: %.2f%%\n", scheduler_stats.battery_saved);
-    printf("Total Energy Consumed: %ld units\n", scheduler_stats.total_energy_consumed);
+    printf("Total Tasks Scheduled: %d\n", ctx->stats.total_tasks_scheduled);
+    printf("Tasks Completed: %d\n", ctx->stats.tasks_completed);
+    printf("Tasks Suspended: %d\n", ctx->stats.tasks_suspended);
+    printf("Context Switches: %d\n", ctx->stats.context_switches);
+    printf("CPU Utilization: %.2f%%\n", ctx->stats.cpu_utilization);
+    printf("Battery Saved: %.2f%%\n", ctx->stats.battery_saved);
+    printf("Total Energy Consumed: %ld units\n", ctx->stats.total_energy_consumed);
+    printf("Aging Promotions: %d\n", ctx->stats.aging_promotions);
+    printf("Tasks Dropped: %d\n", ctx->stats.tasks_dropped);
+    if (SCHED_PROFILE) {
+        printf("\n");
+        print_phase_timings_ctx(ctx, stdout);
+    }
     printf("===========================\n\n");
 }
 
+// Print run-loop phase timings (empty unless built with SCHED_PROFILE)
+void print_phase_timings_ctx(SchedContext *ctx, FILE *out) {
+    static const char *phase_names[NUM_SCHED_PHASES] = {
+        "Battery update", "Mode adjust", "Select (dequeue)", "Context switch",
+        "Execute", "Requeue", "Decision total"
+    };
+    
+    histogram_print_header(out, "Run-loop phase (us)");
+    for (int phase = 0; phase < NUM_SCHED_PHASES; phase++) {
+        histogram_print_row(out, phase_names[phase], &ctx->stats.phase_ns[phase], NS_PER_US);
+    }
+}
+
 
 // DEBUG AND LOGGING
 
@@ -733,15 +1609,249 @@ void print_scheduler_statistics(void) {
 void log_scheduling_decision(Task *task, const char *reason) {
     if (task == NULL) return;
     
-    char log_msg[MAX_LOG_MSG];
-    snprintf(log_msg, MAX_LOG_MSG, "Scheduling decision - Task: %d, Reason: %s", 
-             task->task_id, reason);
-    log_debug(log_msg);
+    LOG_DEBUG("Scheduling decision - Task: %d, Reason: %s", 
+              task->task_id, reason);
 }
 
 // Print ready queue
-void print_ready_queue(void) {
+void print_ready_queue_ctx(SchedContext *ctx) {
     printf("\n=== Ready Queue ===\n");
-    print_task_queue(scheduler_state.ready_queue);
+    switch (ready_structure_for(ctx->state.config.algorithm)) {
+        case READY_HEAP:
+            print_task_heap(ctx->state.ready_heap);
+            break;
+        case READY_BUCKETS:
+            for (int rank = 0; rank < mode_order_length[ctx->state.mode]; rank++) {
+                int bucket = mode_order[ctx->state.mode][rank];
+                for (Task *t = ctx->state.runqueue.buckets[bucket].head; t != NULL; 
+                     t = t->queue_next) {
+                    print_task(t);
+                }
+            }
+            break;
+        case READY_FIFO:
+        default:
+            print_task_queue(ctx->state.ready_queue);
+            break;
+    }
     printf("===================\n\n");
 }
+
+
+// DEFAULT CONTEXT
+
+
+// Initialize scheduler
+int scheduler_init(SchedulerAlgorithm algorithm) {
+    return scheduler_init_ctx(&default_context, algorithm);
+}
+
+// Cleanup scheduler
+void scheduler_cleanup(void) {
+    scheduler_cleanup_ctx(&default_context);
+}
+
+// Start scheduler
+int scheduler_start(void) {
+    return scheduler_start_ctx(&default_context);
+}
+
+// Stop scheduler
+int scheduler_stop(void) {
+    return scheduler_stop_ctx(&default_context);
+}
+
+// Pause scheduler
+int scheduler_pause(void) {
+    return scheduler_pause_ctx(&default_context);
+}
+
+// Resume scheduler
+int scheduler_resume(void) {
+    return scheduler_resume_ctx(&default_context);
+}
+
+// Record an event and wake the run loop if it is idle
+void scheduler_notify(SchedulerEvent event) {
+    scheduler_notify_ctx(&default_context, event);
+}
+
+// Lock the scheduler against the run loop
+void scheduler_lock(void) {
+    scheduler_lock_ctx(&default_context);
+}
+
+// Release the scheduler lock
+void scheduler_unlock(void) {
+    scheduler_unlock_ctx(&default_context);
+}
+
+// Register the source polled for newly arrived tasks
+void set_arrival_source(ArrivalSource source, void *context) {
+    set_arrival_source_ctx(&default_context, source, context);
+}
+
+// Register the hook called for each completed or dropped task
+void set_task_done_hook(TaskDoneHook hook, void *context) {
+    set_task_done_hook_ctx(&default_context, hook, context);
+}
+
+// Set scheduler algorithm
+int set_scheduler_algorithm(SchedulerAlgorithm algorithm) {
+    return set_scheduler_algorithm_ctx(&default_context, algorithm);
+}
+
+// Set scheduler mode
+int set_scheduler_mode(SchedulerMode mode) {
+    return set_scheduler_mode_ctx(&default_context, mode);
+}
+
+// Set time quantum for round robin
+int set_time_quantum(int quantum_ms) {
+    return set_time_quantum_ctx(&default_context, quantum_ms);
+}
+
+// Get scheduler configuration
+SchedulerConfig* get_scheduler_config(void) {
+    return get_scheduler_config_ctx(&default_context);
+}
+
+// Configure scheduler
+void configure_scheduler(SchedulerConfig *config) {
+    configure_scheduler_ctx(&default_context, config);
+}
+
+// Select next task based on algorithm
+Task* select_next_task(void) {
+    return select_next_task_ctx(&default_context);
+}
+
+// Schedule a task
+int schedule_task(Task *task) {
+    return schedule_task_ctx(&default_context, task);
+}
+
+// Execute a task
+int execute_task(Task *task) {
+    return execute_task_ctx(&default_context, task);
+}
+
+// Preempt a task
+int preempt_task(Task *task) {
+    return preempt_task_ctx(&default_context, task);
+}
+
+// Suspend a task
+int suspend_task(Task *task) {
+    return suspend_task_ctx(&default_context, task);
+}
+
+// Resume a task
+int resume_task(Task *task) {
+    return resume_task_ctx(&default_context, task);
+}
+
+// Adjust scheduler based on battery level
+int adjust_scheduler_for_battery(void) {
+    return adjust_scheduler_for_battery_ctx(&default_context);
+}
+
+// Apply power saving policies
+int apply_power_saving_policies(void) {
+    return apply_power_saving_policies_ctx(&default_context);
+}
+
+// Check if task can be admitted
+bool can_admit_task(Task *task) {
+    return can_admit_task_ctx(&default_context, task);
+}
+
+// Admit task to scheduler
+int admit_task_to_scheduler(Task *task) {
+    return admit_task_to_scheduler_ctx(&default_context, task);
+}
+
+// First Come First Serve
+Task* schedule_fcfs(void) {
+    return schedule_fcfs_ctx(&default_context);
+}
+
+// Shortest Job First (least remaining time, from the keyed ready queue)
+Task* schedule_sjf(void) {
+    return schedule_sjf_ctx(&default_context);
+}
+
+// Priority-based scheduling (lowest number = highest priority)
+Task* schedule_priority(void) {
+    return schedule_priority_ctx(&default_context);
+}
+
+// Round Robin scheduling
+Task* schedule_round_robin(void) {
+    return schedule_round_robin_ctx(&default_context);
+}
+
+// Battery-aware scheduling
+Task* schedule_battery_aware(void) {
+    return schedule_battery_aware_ctx(&default_context);
+}
+
+// Earliest Deadline First (from the keyed ready queue)
+Task* schedule_edf(void) {
+    return schedule_edf_ctx(&default_context);
+}
+
+// Energy-aware EDF
+Task* schedule_energy_edf(void) {
+    return schedule_energy_edf_ctx(&default_context);
+}
+
+// Completely fair scheduling: smallest energy-weighted vruntime first
+Task* schedule_cfs(void) {
+    return schedule_cfs_ctx(&default_context);
+}
+
+// Perform context switch
+int perform_context_switch(Task *old_task, Task *new_task) {
+    return perform_context_switch_ctx(&default_context, old_task, new_task);
+}
+
+// Main scheduler loop
+void scheduler_run_loop(void) {
+    scheduler_run_loop_ctx(&default_context);
+}
+
+// Get scheduler statistics
+SchedulerStats* get_scheduler_statistics(void) {
+    return get_scheduler_statistics_ctx(&default_context);
+}
+
+// Bytes allocated by the ready structures, waiting queue and task manager
+size_t get_scheduler_memory_usage(void) {
+    return get_scheduler_memory_usage_ctx(&default_context);
+}
+
+// Update scheduler statistics
+void update_scheduler_statistics(void) {
+    update_scheduler_statistics_ctx(&default_context);
+}
+
+// Print scheduler status
+void print_scheduler_status(void) {
+    print_scheduler_status_ctx(&default_context);
+}
+
+// Print scheduler statistics
+void print_scheduler_statistics(void) {
+    print_scheduler_statistics_ctx(&default_context);
+}
+
+// Print run-loop phase timings (empty unless built with SCHED_PROFILE)
+void print_phase_timings(FILE *out) {
+    print_phase_timings_ctx(&default_context, out);
+}
+
+// Print ready queue
+void print_ready_queue(void) {
+    print_ready_queue_ctx(&default_context);
+}
@@ -0,0 +1,299 @@
+#include "../include/simd_scan.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SCAN_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+
+// GLOBAL VARIABLES
+
+
+static ScanKernel requested_kernel = SCAN_KERNEL_AUTO;
+static ScanKernel active_kernel = SCAN_KERNEL_AUTO;   // Resolved on first use
+
+
+// KERNEL SELECTION
+
+
+// Check whether the CPU can run a kernel
+static bool kernel_supported(ScanKernel kernel) {
+    switch (kernel) {
+        case SCAN_KERNEL_SCALAR:
+            return true;
+#ifdef SCAN_HAVE_X86
+        case SCAN_KERNEL_SSE41:
+            return __builtin_cpu_supports("sse4.1");
+        case SCAN_KERNEL_AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+// Pick the requested kernel, or the best supported one below it
+static ScanKernel resolve_kernel(void) {
+    ScanKernel kernel = (requested_kernel == SCAN_KERNEL_AUTO) ? SCAN_KERNEL_AVX2 : requested_kernel;
+    while (kernel > SCAN_KERNEL_SCALAR && !kernel_supported(kernel)) {
+        kernel = (ScanKernel)(kernel - 1);
+    }
+    return kernel;
+}
+
+// Force a kernel (SCAN_KERNEL_AUTO restores CPU detection)
+void set_scan_kernel(ScanKernel kernel) {
+    requested_kernel = kernel;
+    active_kernel = resolve_kernel();
+}
+
+// Get the kernel scans will run with
+ScanKernel get_scan_kernel(void) {
+    if (active_kernel == SCAN_KERNEL_AUTO) {
+        active_kernel = resolve_kernel();
+    }
+    return active_kernel;
+}
+
+// Kernel name for reports
+const char* scan_kernel_name(ScanKernel kernel) {
+    switch (kernel) {
+        case SCAN_KERNEL_SCALAR: return "scalar";
+        case SCAN_KERNEL_SSE41: return "sse4.1";
+        case SCAN_KERNEL_AVX2: return "avx2";
+        default: return "auto";
+    }
+}
+
+
+// SCALAR KERNELS
+
+
+// Selection score of one entry
+static inline int32_t entry_score(const TaskKeyBlock *block, int i, const TaskScanWeights *w) {
+    return w->priority * block->priority[i] +
+           w->energy_cost * block->energy_cost[i] +
+           w->remaining_time * block->remaining_time[i] +
+           w->deadline * block->deadline[i] +
+           w->non_critical * (1 - block->is_critical[i]);
+}
+
+// Lowest-score matching entry in [start, count)
+static int min_score_scalar(const TaskKeyBlock *block, int start, int32_t state,
+                            const TaskScanWeights *w, int best_index, int32_t *best_score) {
+    for (int i = start; i < block->count; i++) {
+        if (block->state[i] != state) {
+            continue;
+        }
+        int32_t score = entry_score(block, i, w);
+        if (best_index < 0 || score < *best_score) {
+            best_index = i;
+            *best_score = score;
+        }
+    }
+    return best_index;
+}
+
+// Count live matching entries in [start, count)
+static int count_equal_scalar(const TaskKeyBlock *block, int start,
+                              const int32_t *values, int32_t value) {
+    int count = 0;
+    for (int i = start; i < block->count; i++) {
+        count += (block->state[i] >= 0 && values[i] == value);
+    }
+    return count;
+}
+
+// Merge per-lane minimums into one result (lowest score, then lowest index)
+static int reduce_lanes(const int32_t *scores, const int32_t *indexes, int lanes,
+                        int32_t *best_score) {
+    int best_index = -1;
+    for (int lane = 0; lane < lanes; lane++) {
+        if (indexes[lane] < 0) {
+            continue;
+        }
+        if (best_index < 0 || scores[lane] < *best_score ||
+            (scores[lane] == *best_score && indexes[lane] < best_index)) {
+            best_index = indexes[lane];
+            *best_score = scores[lane];
+        }
+    }
+    return best_index;
+}
+
+
+// SIMD KERNELS
+
+
+#ifdef SCAN_HAVE_X86
+
+// Lowest-score matching entry, 4 lanes at a time
+__attribute__((target("sse4.1")))
+static int min_score_sse41(const TaskKeyBlock *block, int32_t state,
+                           const TaskScanWeights *w, int32_t *best_score) {
+    const __m128i want = _mm_set1_epi32(state);
+    const __m128i wp = _mm_set1_epi32(w->priority);
+    const __m128i we = _mm_set1_epi32(w->energy_cost);
+    const __m128i wr = _mm_set1_epi32(w->remaining_time);
+    const __m128i wd = _mm_set1_epi32(w->deadline);
+    const __m128i wc = _mm_set1_epi32(w->non_critical);
+    const __m128i unmatched = _mm_set1_epi32(INT32_MAX);
+    const __m128i step = _mm_set1_epi32(4);
+
+    __m128i best = unmatched;
+    __m128i best_idx = _mm_set1_epi32(-1);
+    __m128i idx = _mm_setr_epi32(0, 1, 2, 3);
+
+    int i = 0;
+    for (; i + 4 <= block->count; i += 4) {
+        __m128i score = _mm_mullo_epi32(_mm_loadu_si128((const __m128i*)(block->priority + i)), wp);
+        score = _mm_add_epi32(score, _mm_mullo_epi32(
+            _mm_loadu_si128((const __m128i*)(block->energy_cost + i)), we));
+        score = _mm_add_epi32(score, _mm_mullo_epi32(
+            _mm_loadu_si128((const __m128i*)(block->remaining_time + i)), wr));
+        score = _mm_add_epi32(score, _mm_mullo_epi32(
+            _mm_loadu_si128((const __m128i*)(block->deadline + i)), wd));
+        score = _mm_add_epi32(score, _mm_sub_epi32(wc, _mm_mullo_epi32(
+            _mm_loadu_si128((const __m128i*)(block->is_critical + i)), wc)));
+
+        __m128i match = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(block->state + i)), want);
+        score = _mm_blendv_epi8(unmatched, score, match);
+
+        __m128i better = _mm_and_si128(_mm_cmpgt_epi32(best, score), match);
+        best = _mm_blendv_epi8(best, score, better);
+        best_idx = _mm_blendv_epi8(best_idx, idx, better);
+        idx = _mm_add_epi32(idx, step);
+    }
+
+    int32_t scores[4], indexes[4];
+    _mm_storeu_si128((__m128i*)scores, best);
+    _mm_storeu_si128((__m128i*)indexes, best_idx);
+    int best_index = reduce_lanes(scores, indexes, 4, best_score);
+    return min_score_scalar(block, i, state, w, best_index, best_score);
+}
+
+// Lowest-score matching entry, 8 lanes at a time
+__attribute__((target("avx2")))
+static int min_score_avx2(const TaskKeyBlock *block, int32_t state,
+                          const TaskScanWeights *w, int32_t *best_score) {
+    const __m256i want = _mm256_set1_epi32(state);
+    const __m256i wp = _mm256_set1_epi32(w->priority);
+    const __m256i we = _mm256_set1_epi32(w->energy_cost);
+    const __m256i wr = _mm256_set1_epi32(w->remaining_time);
+    const __m256i wd = _mm256_set1_epi32(w->deadline);
+    const __m256i wc = _mm256_set1_epi32(w->non_critical);
+    const __m256i unmatched = _mm256_set1_epi32(INT32_MAX);
+    const __m256i step = _mm256_set1_epi32(8);
+
+    __m256i best = unmatched;
+    __m256i best_idx = _mm256_set1_epi32(-1);
+    __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    int i = 0;
+    for (; i + 8 <= block->count; i += 8) {
+        __m256i score = _mm256_mullo_epi32(
+            _mm256_loadu_si256((const __m256i*)(block->priority + i)), wp);
+        score = _mm256_add_epi32(score, _mm256_mullo_epi32(
+            _mm256_loadu_si256((const __m256i*)(block->energy_cost + i)), we));
+        score = _mm256_add_epi32(score, _mm256_mullo_epi32(
+            _mm256_loadu_si256((const __m256i*)(block->remaining_time + i)), wr));
+        score = _mm256_add_epi32(score, _mm256_mullo_epi32(
+            _mm256_loadu_si256((const __m256i*)(block->deadline + i)), wd));
+        score = _mm256_add_epi32(score, _mm256_sub_epi32(wc, _mm256_mullo_epi32(
+            _mm256_loadu_si256((const __m256i*)(block->is_critical + i)), wc)));
+
+        __m256i match = _mm256_cmpeq_epi32(
+            _mm256_loadu_si256((const __m256i*)(block->state + i)), want);
+        score = _mm256_blendv_epi8(unmatched, score, match);
+
+        __m256i better = _mm256_and_si256(_mm256_cmpgt_epi32(best, score), match);
+        best = _mm256_blendv_epi8(best, score, better);
+        best_idx = _mm256_blendv_epi8(best_idx, idx, better);
+        idx = _mm256_add_epi32(idx, step);
+    }
+
+    int32_t scores[8], indexes[8];
+    _mm256_storeu_si256((__m256i*)scores, best);
+    _mm256_storeu_si256((__m256i*)indexes, best_idx);
+    int best_index = reduce_lanes(scores, indexes, 8, best_score);
+    return min_score_scalar(block, i, state, w, best_index, best_score);
+}
+
+// Count live matching entries, 4 lanes at a time
+__attribute__((target("sse4.1,popcnt")))
+static int count_equal_sse41(const TaskKeyBlock *block, const int32_t *values, int32_t value) {
+    const __m128i want = _mm_set1_epi32(value);
+    const __m128i free_slot = _mm_set1_epi32(-1);
+    int count = 0;
+
+    int i = 0;
+    for (; i + 4 <= block->count; i += 4) {
+        __m128i hit = _mm_and_si128(
+            _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(values + i)), want),
+            _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)(block->state + i)), free_slot));
+        count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(hit)));
+    }
+    return count + count_equal_scalar(block, i, values, value);
+}
+
+// Count live matching entries, 8 lanes at a time
+__attribute__((target("avx2,popcnt")))
+static int count_equal_avx2(const TaskKeyBlock *block, const int32_t *values, int32_t value) {
+    const __m256i want = _mm256_set1_epi32(value);
+    const __m256i free_slot = _mm256_set1_epi32(-1);
+    int count = 0;
+
+    int i = 0;
+    for (; i + 8 <= block->count; i += 8) {
+        __m256i hit = _mm256_and_si256(
+            _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(values + i)), want),
+            _mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i*)(block->state + i)), free_slot));
+        count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(hit)));
+    }
+    return count + count_equal_scalar(block, i, values, value);
+}
+
+#endif // SCAN_HAVE_X86
+
+
+// SCAN ENTRY POINTS
+
+
+// Index of the lowest-score entry whose state matches (-1 if none)
+int scan_min_score(const TaskKeyBlock *block, int32_t state,
+                   const TaskScanWeights *weights, int32_t *best_score) {
+    if (block == NULL || weights == NULL || best_score == NULL) {
+        return -1;
+    }
+
+    switch (get_scan_kernel()) {
+#ifdef SCAN_HAVE_X86
+        case SCAN_KERNEL_AVX2:
+            return min_score_avx2(block, state, weights, best_score);
+        case SCAN_KERNEL_SSE41:
+            return min_score_sse41(block, state, weights, best_score);
+#endif
+        default:
+            return min_score_scalar(block, 0, state, weights, -1, best_score);
+    }
+}
+
+// Number of live entries whose value matches
+int scan_count_equal(const TaskKeyBlock *block, const int32_t *values, int32_t value) {
+    if (block == NULL || values == NULL) {
+        return 0;
+    }
+
+    switch (get_scan_kernel()) {
+#ifdef SCAN_HAVE_X86
+        case SCAN_KERNEL_AVX2:
+            return count_equal_avx2(block, values, value);
+        case SCAN_KERNEL_SSE41:
+            return count_equal_sse41(block, values, value);
+#endif
+        default:
+            return count_equal_scalar(block, 0, values, value);
+    }
+}
@@ -0,0 +1,340 @@
+#include "../include/sweep.h"
+#include "../include/battery_monitor.h"
+#include "../include/workload.h"
+#include <errno.h>
+
+// Random combinations drawn per requested sample before giving up (most
+// draws can be rejected by the threshold ordering)
+#define SWEEP_DRAWS_PER_SAMPLE 100
+
+static const char *param_names[NUM_SWEEP_PARAMS] = {
+    "algorithm", "critical", "low", "medium", "high", "quantum", "aging", "preemption"
+};
+
+// Accepted values of each parameter
+static const int param_min[NUM_SWEEP_PARAMS] = {SCHEDULER_FCFS, 0, 0, 0, 0, 1, 1, 0};
+static const int param_max[NUM_SWEEP_PARAMS] = {SCHEDULER_CFS, 100, 100, 100, 100, 3600000, 3600000, 1};
+
+// Algorithm names, in SchedulerAlgorithm order
+static const char *algorithm_names[] = {
+    "fcfs", "sjf", "priority", "rr", "battery", "edf", "eedf", "cfs"
+};
+
+
+// SPEC PARSING
+
+
+// Parse a whole string as an integer in [low, high]
+static bool parse_int(const char *text, long low, long high, long *value) {
+    char *end;
+    errno = 0;
+    long parsed = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno != 0 || parsed < low || parsed > high) {
+        return false;
+    }
+    *value = parsed;
+    return true;
+}
+
+// Add one value to a parameter's list
+static bool add_value(SweepSpec *spec, SweepParam param, long value) {
+    if (spec->counts[param] >= SWEEP_MAX_VALUES) {
+        LOG_ERROR("Sweep: more than %d values for %s", SWEEP_MAX_VALUES, param_names[param]);
+        return false;
+    }
+    spec->values[param][spec->counts[param]++] = (int)value;
+    return true;
+}
+
+// Parse one comma-separated item: a number, lo:hi, lo:hi:step or an algorithm name
+static bool parse_item(SweepSpec *spec, SweepParam param, char *item) {
+    long low = param_min[param];
+    long high = param_max[param];
+    
+    if (param == SWEEP_ALGORITHM) {
+        for (int i = SCHEDULER_FCFS; i <= SCHEDULER_CFS; i++) {
+            if (strcmp(item, algorithm_names[i]) == 0) {
+                return add_value(spec, param, i);
+            }
+        }
+    }
+    
+    char *bounds[3] = {item, NULL, NULL};
+    int parts = 1;
+    for (char *colon = strchr(item, ':'); colon != NULL && parts < 3; colon = strchr(colon + 1, ':')) {
+        *colon = '\0';
+        bounds[parts++] = colon + 1;
+    }
+    
+    long first, last, step = 1;
+    if (!parse_int(bounds[0], low, high, &first) ||
+        (parts > 1 && !parse_int(bounds[1], first, high, &last)) ||
+        (parts > 2 && !parse_int(bounds[2], 1, high, &step))) {
+        LOG_ERROR("Sweep: bad value for %s", param_names[param]);
+        return false;
+    }
+    if (parts == 1) {
+        last = first;
+    }
+    
+    for (long value = first; value <= last; value += step) {
+        if (!add_value(spec, param, value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Parse one key=values token
+static bool parse_token(SweepSpec *spec, char *token, unsigned *seen) {
+    char *equals = strchr(token, '=');
+    if (equals == NULL) {
+        LOG_ERROR("Sweep: expected name=values, got '%s'", token);
+        return false;
+    }
+    *equals = '\0';
+    char *values = equals + 1;
+    
+    long number;
+    if (strcmp(token, "samples") == 0) {
+        if (!parse_int(values, 1, SWEEP_MAX_POINTS, &number)) {
+            LOG_ERROR("Sweep: samples must be 1..%ld", SWEEP_MAX_POINTS);
+            return false;
+        }
+        spec->samples = number;
+        return true;
+    }
+    if (strcmp(token, "seed") == 0) {
+        char *end;
+        spec->seed = strtoull(values, &end, 10);
+        if (end == values || *end != '\0') {
+            LOG_ERROR("Sweep: bad seed '%s'", values);
+            return false;
+        }
+        return true;
+    }
+    
+    for (int param = 0; param < NUM_SWEEP_PARAMS; param++) {
+        if (strcmp(token, param_names[param]) != 0) {
+            continue;
+        }
+        if (*seen & (1u << param)) {
+            LOG_ERROR("Sweep: %s given twice", token);
+            return false;
+        }
+        *seen |= 1u << param;
+        spec->counts[param] = 0;
+    
+        char *save;
+        for (char *item = strtok_r(values, ",", &save); item != NULL; item = strtok_r(NULL, ",", &save)) {
+            if (!parse_item(spec, (SweepParam)param, item)) {
+                return false;
+            }
+        }
+        if (spec->counts[param] == 0) {
+            LOG_ERROR("Sweep: no values for %s", token);
+            return false;
+        }
+        return true;
+    }
+    
+    LOG_ERROR("Sweep: unknown parameter '%s'", token);
+    return false;
+}
+
+// Parse a spec; parameters it leaves out get their default value
+int sweep_parse(SweepSpec *spec, const char *text) {
+    static const int defaults[NUM_SWEEP_PARAMS] = {
+        SCHEDULER_BATTERY_AWARE, BATTERY_CRITICAL, BATTERY_LOW, BATTERY_MEDIUM, BATTERY_HIGH,
+        DEFAULT_TIME_QUANTUM_MS, DEFAULT_AGING_THRESHOLD_MS, 1
+    };
+    
+    memset(spec, 0, sizeof(*spec));
+    spec->seed = 1;
+    for (int param = 0; param < NUM_SWEEP_PARAMS; param++) {
+        spec->values[param][0] = defaults[param];
+        spec->counts[param] = 1;
+    }
+    
+    char *copy = (char*)safe_malloc(strlen(text) + 1);
+    strcpy(copy, text);
+    
+    bool ok = true;
+    unsigned seen = 0;
+    char *save;
+    for (char *token = strtok_r(copy, "; \t", &save); ok && token != NULL;
+         token = strtok_r(NULL, "; \t", &save)) {
+        ok = parse_token(spec, token, &seen);
+    }
+    free(copy);
+    return ok ? SUCCESS : ERROR;
+}
+
+
+// EXPANSION
+
+
+// Battery thresholds must rise strictly from critical to high
+static bool valid_point(const SweepPoint *point) {
+    return point->params[SWEEP_CRITICAL] < point->params[SWEEP_LOW] &&
+           point->params[SWEEP_LOW] < point->params[SWEEP_MEDIUM] &&
+           point->params[SWEEP_MEDIUM] < point->params[SWEEP_HIGH];
+}
+
+// The configurations of a sweep (free() the array), or NULL on error
+SweepPoint* sweep_expand(const SweepSpec *spec, long *count) {
+    long total = 1;
+    for (int param = 0; spec->samples == 0 && param < NUM_SWEEP_PARAMS; param++) {
+        total *= spec->counts[param];
+        if (total > SWEEP_MAX_POINTS) {
+            LOG_ERROR("Sweep grid has more than %ld configurations; use samples=N", SWEEP_MAX_POINTS);
+            return NULL;
+        }
+    }
+    
+    long capacity = spec->samples > 0 ? spec->samples : total;
+    SweepPoint *points = (SweepPoint*)safe_malloc(sizeof(SweepPoint) * capacity);
+    *count = 0;
+    
+    if (spec->samples > 0) {
+        // Random sample: each parameter drawn from its values
+        Rng rng;
+        rng_seed(&rng, spec->seed);
+        for (long draw = 0; draw < spec->samples * SWEEP_DRAWS_PER_SAMPLE && *count < spec->samples;
+             draw++) {
+            SweepPoint *point = &points[*count];
+            for (int param = 0; param < NUM_SWEEP_PARAMS; param++) {
+                point->params[param] = spec->values[param][rng_next(&rng) % spec->counts[param]];
+            }
+            *count += valid_point(point);
+        }
+    } else {
+        // Full grid, the last parameter varying fastest
+        for (long index = 0; index < total; index++) {
+            SweepPoint *point = &points[*count];
+            long rest = index;
+            for (int param = NUM_SWEEP_PARAMS - 1; param >= 0; param--) {
+                point->params[param] = spec->values[param][rest % spec->counts[param]];
+                rest /= spec->counts[param];
+            }
+            *count += valid_point(point);
+        }
+    }
+    
+    if (*count == 0) {
+        LOG_ERROR("Sweep has no configuration with increasing battery thresholds");
+        free(points);
+        return NULL;
+    }
+    return points;
+}
+
+
+// RUNNING
+
+
+// Configure a freshly initialized context for one point
+void sweep_apply(SchedContext *ctx, const SweepPoint *point) {
+    BatteryThresholds thresholds = {
+        point->params[SWEEP_CRITICAL], point->params[SWEEP_LOW],
+        point->params[SWEEP_MEDIUM], point->params[SWEEP_HIGH]
+    };
+    set_battery_thresholds_ctx(ctx, &thresholds);
+    
+    SchedulerConfig *config = get_scheduler_config_ctx(ctx);
+    config->time_quantum = point->params[SWEEP_QUANTUM];
+    config->aging_threshold = point->params[SWEEP_AGING];
+    config->enable_preemption = point->params[SWEEP_PREEMPTION] != 0;
+}
+
+// Copy a finished run's results into its point
+void sweep_record(SchedContext *ctx, SweepPoint *point) {
+    SchedulerStats *stats = get_scheduler_statistics_ctx(ctx);
+    point->energy_consumed = stats->total_energy_consumed;
+    point->tasks_completed = stats->tasks_completed;
+    point->missed_deadlines = get_task_statistics_ctx(ctx)->missed_deadlines;
+    point->context_switches = stats->context_switches;
+    point->final_battery = get_battery_level_ctx(ctx);
+    point->tasks_dropped = stats->tasks_dropped;
+}
+
+
+// OUTPUT
+
+
+// Results of one point as CSV fields after its parameters
+static void write_csv_row(FILE *file, const SweepPoint *point) {
+    const int *p = point->params;
+    fprintf(file, "%s,%d,%d,%d,%d,%d,%d,%d,%ld,%d,%d,%d,%d,%d\n",
+            sweep_algorithm_name((SchedulerAlgorithm)p[SWEEP_ALGORITHM]),
+            p[SWEEP_CRITICAL], p[SWEEP_LOW], p[SWEEP_MEDIUM], p[SWEEP_HIGH],
+            p[SWEEP_QUANTUM], p[SWEEP_AGING], p[SWEEP_PREEMPTION],
+            point->energy_consumed, point->tasks_completed, point->missed_deadlines,
+            point->context_switches, point->final_battery, point->tasks_dropped);
+}
+
+// One point as a JSON object
+static void write_json_row(FILE *file, const SweepPoint *point, bool last) {
+    const int *p = point->params;
+    fprintf(file,
+            "  {\"algorithm\": \"%s\", \"critical\": %d, \"low\": %d, \"medium\": %d, "
+            "\"high\": %d, \"quantum\": %d, \"aging\": %d, \"preemption\": %d, "
+            "\"energy\": %ld, \"tasks_completed\": %d, \"missed_deadlines\": %d, "
+            "\"context_switches\": %d, \"final_battery\": %d, \"tasks_dropped\": %d}%s\n",
+            sweep_algorithm_name((SchedulerAlgorithm)p[SWEEP_ALGORITHM]),
+            p[SWEEP_CRITICAL], p[SWEEP_LOW], p[SWEEP_MEDIUM], p[SWEEP_HIGH],
+            p[SWEEP_QUANTUM], p[SWEEP_AGING], p[SWEEP_PREEMPTION],
+            point->energy_consumed, point->tasks_completed, point->missed_deadlines,
+            point->context_switches, point->final_battery, point->tasks_dropped,
+            last ? "" : ",");
+}
+
+// Write the results table: JSON if the path ends in ".json", else CSV
+int sweep_write(const char *path, const SweepPoint *points, long count) {
+    size_t length = strlen(path);
+    bool json = length >= 5 && strcmp(path + length - 5, ".json") == 0;
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        LOG_ERROR("Cannot create sweep results %s", path);
+        return ERROR;
+    }
+    
+    if (json) {
+        fprintf(file, "[\n");
+    } else {
+        for (int param = 0; param < NUM_SWEEP_PARAMS; param++) {
+            fprintf(file, "%s,", param_names[param]);
+        }
+        fprintf(file, "energy,tasks_completed,missed_deadlines,context_switches,"
+                      "final_battery,tasks_dropped\n");
+    }
+    for (long i = 0; i < count; i++) {
+        if (json) {
+            write_json_row(file, &points[i], i == count - 1);
+        } else {
+            write_csv_row(file, &points[i]);
+        }
+    }
+    if (json) {
+        fprintf(file, "]\n");
+    }
+    
+    bool ok = !ferror(file);
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        LOG_ERROR("Error writing sweep results %s", path);
+        return ERROR;
+    }
+    return SUCCESS;
+}
+
+// Name of a parameter
+const char* sweep_param_name(SweepParam param) {
+    return (int)param >= 0 && param < NUM_SWEEP_PARAMS ? param_names[param] : "unknown";
+}
+
+// Short name of an algorithm, as written in specs
+const char* sweep_algorithm_name(SchedulerAlgorithm algorithm) {
+    return (int)algorithm >= SCHEDULER_FCFS && algorithm <= SCHEDULER_CFS ?
+           algorithm_names[algorithm] : "unknown";
+}
@@ -1,57 +1,279 @@
 // /home/nishit/Desktop/OS/nishit/osproject/src/task_manager.c
 #include "../include/task_manager.h"
+#include "../include/scheduler.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 
 
-// GLOBAL VARIABLES
+// TASK POOL LAYOUT
 
 
-static Task tasks[MAX_TASKS];
-static int task_count = 0;
-static int next_task_id = 1;
-static TaskStats task_stats;
-static bool is_initialized = false;
+// Tasks live in fixed-size chunks that are never moved, so Task pointers
+// stay valid while the pool grows. Freed slots are recycled via a free list.
+// Each chunk also keeps the hot scheduling keys in packed parallel arrays
+// so pool-wide scans stream 24 bytes per task instead of whole Task structs.
+#define TASK_POOL_CHUNK_SHIFT 8
+#define TASK_POOL_CHUNK_SIZE (1 << TASK_POOL_CHUNK_SHIFT)
+#define TASK_POOL_CHUNK_MASK (TASK_POOL_CHUNK_SIZE - 1)
+
+// Pool slot wrapping a task (task must stay the first member)
+typedef struct {
+    Task task;                      // Task stored in this slot
+    int index;                      // This slot's pool index
+    unsigned int generation;        // Bumped each time the slot is freed
+    int next_free;                  // Next free slot index (-1 = end of list)
+    bool in_use;                    // Is this slot holding a live task
+} TaskSlot;
+
+// Marks an unused slot in the packed state array
+#define TASK_SLOT_FREE -1
+
+// Pool chunk: task slots plus their scheduling keys (struct-of-arrays)
+typedef struct TaskChunk {
+    int32_t priority[TASK_POOL_CHUNK_SIZE];
+    int32_t energy_cost[TASK_POOL_CHUNK_SIZE];
+    int32_t remaining_time[TASK_POOL_CHUNK_SIZE];
+    int32_t deadline[TASK_POOL_CHUNK_SIZE];
+    int32_t is_critical[TASK_POOL_CHUNK_SIZE];
+    int32_t state[TASK_POOL_CHUNK_SIZE];        // TaskState or TASK_SLOT_FREE
+    TaskSlot slots[TASK_POOL_CHUNK_SIZE];
+} TaskChunk;
+
+// Task IDs start at 1, so key 0 marks an empty index bucket
+#define TASK_INDEX_MIN_CAPACITY 64
+
+
+// TASK POOL
+
+
+// Get the slot at a pool index
+static TaskSlot* pool_slot(TaskPool *pool, int index) {
+    return &pool->chunks[index >> TASK_POOL_CHUNK_SHIFT]->slots[index & TASK_POOL_CHUNK_MASK];
+}
+
+// Get the slot that owns a task
+static TaskSlot* slot_of(Task *task) {
+    return (TaskSlot*)task;
+}
+
+// Take a slot from the free list, or from a new chunk if none are free
+static int pool_alloc_slot(TaskPool *pool) {
+    if (pool->free_head >= 0) {
+        int index = pool->free_head;
+        pool->free_head = pool_slot(pool, index)->next_free;
+        return index;
+    }
+    
+    if (pool->slot_count == pool->chunk_count * TASK_POOL_CHUNK_SIZE) {
+        if (pool->chunk_count == pool->chunk_capacity) {
+            int new_capacity = pool->chunk_capacity > 0 ? pool->chunk_capacity * 2 : 4;
+            TaskChunk **chunks = (TaskChunk**)safe_malloc(new_capacity * sizeof(TaskChunk*));
+            if (pool->chunks != NULL) {
+                memcpy(chunks, pool->chunks, pool->chunk_count * sizeof(TaskChunk*));
+                free(pool->chunks);
+            }
+            pool->chunks = chunks;
+            pool->chunk_capacity = new_capacity;
+        }
+        TaskChunk *chunk = (TaskChunk*)safe_malloc(sizeof(TaskChunk));
+        for (int i = 0; i < TASK_POOL_CHUNK_SIZE; i++) {
+            chunk->state[i] = TASK_SLOT_FREE;
+        }
+        pool->chunks[pool->chunk_count++] = chunk;
+    }
+    
+    int index = pool->slot_count++;
+    pool_slot(pool, index)->index = index;
+    return index;
+}
+
+// Return a slot to the free list
+static void pool_free_slot(TaskPool *pool, int index) {
+    TaskSlot *slot = pool_slot(pool, index);
+    slot->in_use = false;
+    slot->generation++;
+    pool->chunks[index >> TASK_POOL_CHUNK_SHIFT]->state[index & TASK_POOL_CHUNK_MASK] = 
+        TASK_SLOT_FREE;
+    slot->next_free = pool->free_head;
+    pool->free_head = index;
+}
+
+// Release every chunk
+static void pool_destroy(TaskPool *pool) {
+    for (int i = 0; i < pool->chunk_count; i++) {
+        free(pool->chunks[i]);
+    }
+    free(pool->chunks);
+    
+    pool->chunks = NULL;
+    pool->chunk_count = 0;
+    pool->chunk_capacity = 0;
+    pool->slot_count = 0;
+    pool->free_head = -1;
+}
+
+
+// Copy a task's scheduling fields into its chunk's packed key arrays
+static void store_task_keys(TaskPool *pool, TaskSlot *slot) {
+    TaskChunk *chunk = pool->chunks[slot->index >> TASK_POOL_CHUNK_SHIFT];
+    int i = slot->index & TASK_POOL_CHUNK_MASK;
+    Task *task = &slot->task;
+    
+    chunk->priority[i] = task->priority;
+    chunk->energy_cost[i] = task->energy_cost;
+    chunk->remaining_time[i] = task->remaining_time;
+    chunk->deadline[i] = task->deadline;
+    chunk->is_critical[i] = task->is_critical ? 1 : 0;
+    chunk->state[i] = task->state;
+}
+
+// Describe the live part of a chunk for the scan kernels
+static TaskKeyBlock chunk_key_block(TaskPool *pool, int chunk_index) {
+    TaskChunk *chunk = pool->chunks[chunk_index];
+    TaskKeyBlock block;
+    
+    block.priority = chunk->priority;
+    block.energy_cost = chunk->energy_cost;
+    block.remaining_time = chunk->remaining_time;
+    block.deadline = chunk->deadline;
+    block.is_critical = chunk->is_critical;
+    block.state = chunk->state;
+    block.count = min(TASK_POOL_CHUNK_SIZE, 
+                      pool->slot_count - chunk_index * TASK_POOL_CHUNK_SIZE);
+    return block;
+}
+
+
+// TASK ID INDEX
+
+
+// Home bucket for a task ID (Fibonacci hashing)
+static unsigned int index_bucket(TaskIndex *table, int task_id) {
+    return ((unsigned int)task_id * 2654435769u) & table->mask;
+}
+
+// Allocate an empty index with the given power-of-two capacity
+static void index_alloc(TaskIndex *table, unsigned int capacity) {
+    table->entries = (TaskIndexEntry*)safe_malloc(capacity * sizeof(TaskIndexEntry));
+    table->mask = capacity - 1;
+    table->count = 0;
+}
+
+// Find the pool slot for a task ID (-1 if absent)
+static int index_lookup(TaskIndex *table, int task_id) {
+    if (table->entries == NULL || task_id <= 0) {
+        return -1;
+    }
+    
+    unsigned int bucket = index_bucket(table, task_id);
+    while (table->entries[bucket].task_id != 0) {
+        if (table->entries[bucket].task_id == task_id) {
+            return table->entries[bucket].slot;
+        }
+        bucket = (bucket + 1) & table->mask;
+    }
+    return -1;
+}
+
+// Insert a task ID, doubling the table to keep the load factor under 1/2
+static void index_insert(TaskIndex *table, int task_id, int slot) {
+    if ((unsigned int)(table->count + 1) * 2 > table->mask + 1) {
+        TaskIndexEntry *old_entries = table->entries;
+        unsigned int old_capacity = table->mask + 1;
+        
+        index_alloc(table, old_capacity * 2);
+        for (unsigned int i = 0; i < old_capacity; i++) {
+            if (old_entries[i].task_id != 0) {
+                index_insert(table, old_entries[i].task_id, old_entries[i].slot);
+            }
+        }
+        free(old_entries);
+    }
+    
+    unsigned int bucket = index_bucket(table, task_id);
+    while (table->entries[bucket].task_id != 0) {
+        bucket = (bucket + 1) & table->mask;
+    }
+    table->entries[bucket].task_id = task_id;
+    table->entries[bucket].slot = slot;
+    table->count++;
+}
+
+// Remove a task ID, shifting later probe-chain entries back (no tombstones)
+static void index_remove(TaskIndex *table, int task_id) {
+    unsigned int bucket = index_bucket(table, task_id);
+    while (table->entries[bucket].task_id != task_id) {
+        if (table->entries[bucket].task_id == 0) {
+            return;
+        }
+        bucket = (bucket + 1) & table->mask;
+    }
+    
+    unsigned int hole = bucket;
+    unsigned int next = (hole + 1) & table->mask;
+    while (table->entries[next].task_id != 0) {
+        unsigned int home = index_bucket(table, table->entries[next].task_id);
+        // Move the entry back if its home is not in the range (hole, next]
+        if (((next - home) & table->mask) >= ((next - hole) & table->mask)) {
+            table->entries[hole] = table->entries[next];
+            hole = next;
+        }
+        next = (next + 1) & table->mask;
+    }
+    table->entries[hole].task_id = 0;
+    table->count--;
+}
 
 
 // INITIALIZATION AND CLEANUP
 
 
 // Initialize task manager
-int task_manager_init(void) {
-    if (is_initialized) {
-        log_error("Task manager already initialized");
+int task_manager_init_ctx(SchedContext *ctx) {
+    TaskManager *tm = &ctx->tasks;
+    
+    if (tm->initialized) {
+        LOG_ERROR("Task manager already initialized");
         return ERROR;
     }
     
-    task_count = 0;
-    next_task_id = 1;
+    tm->task_count = 0;
+    tm->next_task_id = 1;
+    tm->pool.free_head = -1;
+    index_alloc(&tm->index, TASK_INDEX_MIN_CAPACITY);
     
     // Initialize statistics
-    task_stats.total_tasks = 0;
-    task_stats.completed_tasks = 0;
-    task_stats.suspended_tasks = 0;
-    task_stats.avg_waiting_time = 0.0;
-    task_stats.avg_turnaround_time = 0.0;
-    task_stats.missed_deadlines = 0;
+    tm->stats.total_tasks = 0;
+    tm->stats.completed_tasks = 0;
+    tm->stats.suspended_tasks = 0;
+    tm->stats.avg_waiting_time = 0.0;
+    tm->stats.avg_turnaround_time = 0.0;
+    tm->stats.missed_deadlines = 0;
+    reset_latency_stats(&tm->stats.latency);
     
-    is_initialized = true;
-    log_info("Task manager initialized successfully");
+    tm->initialized = true;
+    LOG_INFO("Task manager initialized successfully");
     
     return SUCCESS;
 }
 
 // Cleanup task manager
-void task_manager_cleanup(void) {
-    if (!is_initialized) {
+void task_manager_cleanup_ctx(SchedContext *ctx) {
+    TaskManager *tm = &ctx->tasks;
+    
+    if (!tm->initialized) {
         return;
     }
     
-    task_count = 0;
-    next_task_id = 1;
-    is_initialized = false;
-    log_info("Task manager cleaned up");
+    pool_destroy(&tm->pool);
+    free(tm->index.entries);
+    tm->index.entries = NULL;
+    tm->task_count = 0;
+    tm->next_task_id = 1;
+    tm->initialized = false;
+    LOG_INFO("Task manager cleaned up");
 }
 
 
@@ -59,56 +281,57 @@ void task_manager_cleanup(void) {
 
 
 // Create a new task
-Task* create_task(const char *name, int priority, int energy_cost, 
-                  int burst_time, bool is_critical, int deadline) {
-    if (!is_initialized) {
-        log_error("Task manager not initialized");
-        return NULL;
-    }
+Task* create_task_ctx(SchedContext *ctx, const char *name, int priority, int energy_cost,
+                      int burst_time, bool is_critical, int deadline) {
+    TaskManager *tm = &ctx->tasks;
     
-    if (task_count >= MAX_TASKS) {
-        log_error("Maximum task limit reached");
+    if (!tm->initialized) {
+        LOG_ERROR("Task manager not initialized");
         return NULL;
     }
     
-    Task *task = &tasks[task_count];
+    TaskSlot *slot = pool_slot(&tm->pool, pool_alloc_slot(&tm->pool));
+    slot->in_use = true;
+    Task *task = &slot->task;
     
-    task->task_id = next_task_id++;
+    task->task_id = tm->next_task_id++;
     strncpy(task->task_name, name, MAX_TASK_NAME - 1);
     task->task_name[MAX_TASK_NAME - 1] = '\0';
     task->priority = priority;
+    task->base_priority = priority;
     task->energy_cost = energy_cost;
     task->burst_time = burst_time;
     task->remaining_time = burst_time;
-    task->arrival_time = get_current_time_ms();
-    task->start_time = 0;
-    task->completion_time = 0;
-    task->waiting_time = 0;
-    task->turnaround_time = 0;
+    task->arrival_time_ns = sim_clock_ns(ctx->clock);
+    task->start_time_ns = 0;
+    task->completion_time_ns = 0;
+    task->waiting_time_ns = 0;
+    task->turnaround_time_ns = 0;
     task->state = TASK_STATE_READY;
     task->is_critical = is_critical;
     task->deadline = deadline;
+    task->queue_index = -1;
+    task->queue_seq = 0;
+    task->queue_prev = NULL;
+    task->queue_next = NULL;
+    timer_entry_init(&task->aging_timer);
+    task->vruntime = 0;
     
-    task_count++;
-    task_stats.total_tasks++;
+    store_task_keys(&tm->pool, slot);
+    index_insert(&tm->index, task->task_id, slot->index);
+    tm->task_count++;
+    tm->stats.total_tasks++;
     
-    char log_msg[MAX_LOG_MSG];
-    snprintf(log_msg, MAX_LOG_MSG, "Task created: ID=%d, Name=%s, Priority=%d, Energy=%d", 
+    LOG_INFO("Task created: ID=%d, Name=%s, Priority=%d, Energy=%d", 
              task->task_id, task->task_name, task->priority, task->energy_cost);
-    log_info(log_msg);
     
     return task;
 }
 
 // Add task to the task list
-int add_task(Task *task) {
-    if (!is_initialized || task == NULL) {
-        log_error("Invalid task or task manager not initialized");
-        return ERROR;
-    }
-    
-    if (task_count >= MAX_TASKS) {
-        log_error("Cannot add task: maximum limit reached");
+int add_task_ctx(SchedContext *ctx, Task *task) {
+    if (!ctx->tasks.initialized || task == NULL) {
+        LOG_ERROR("Invalid task or task manager not initialized");
         return ERROR;
     }
     
@@ -116,46 +339,128 @@ int add_task(Task *task) {
 }
 
 // Remove task from the list
-int remove_task(int task_id) {
-    if (!is_initialized) {
-        log_error("Task manager not initialized");
+int remove_task_ctx(SchedContext *ctx, int task_id) {
+    TaskManager *tm = &ctx->tasks;
+    
+    if (!tm->initialized) {
+        LOG_ERROR("Task manager not initialized");
         return ERROR;
     }
     
-    for (int i = 0; i < task_count; i++) {
-        if (tasks[i].task_id == task_id) {
-            // Shift remaining tasks
-            for (int j = i; j < task_count - 1; j++) {
-                tasks[j] = tasks[j + 1];
-            }
-            task_count--;
-            
-            char log_msg[MAX_LOG_MSG];
-            snprintf(log_msg, MAX_LOG_MSG, "Task removed: ID=%d", task_id);
-            log_info(log_msg);
-            
-            return SUCCESS;
-        }
+    int slot = index_lookup(&tm->index, task_id);
+    if (slot < 0) {
+        LOG_ERROR("Task not found");
+        return ERROR;
     }
     
-    log_error("Task not found");
-    return ERROR;
+    // Unlink the task from the scheduler before its slot can be reused, so
+    // no queue or timer is left pointing at the next task created there
+    scheduler_release_task_ctx(ctx, &pool_slot(&tm->pool, slot)->task);
+    
+    // Recycle the slot; other tasks keep their addresses
+    index_remove(&tm->index, task_id);
+    pool_free_slot(&tm->pool, slot);
+    tm->task_count--;
+    
+    LOG_INFO("Task removed: ID=%d", task_id);
+    
+    return SUCCESS;
 }
 
 // Get task by ID
-Task* get_task(int task_id) {
-    if (!is_initialized) {
-        log_error("Task manager not initialized");
+Task* get_task_ctx(SchedContext *ctx, int task_id) {
+    TaskManager *tm = &ctx->tasks;
+    
+    if (!tm->initialized) {
+        LOG_ERROR("Task manager not initialized");
+        return NULL;
+    }
+    
+    int slot = index_lookup(&tm->index, task_id);
+    if (slot < 0) {
+        return NULL;
+    }
+    return &pool_slot(&tm->pool, slot)->task;
+}
+
+// Get a generation-checked handle for a task
+TaskHandle get_task_handle(Task *task) {
+    TaskHandle handle = { -1, 0 };
+    if (task == NULL) {
+        return handle;
+    }
+    
+    TaskSlot *slot = slot_of(task);
+    handle.slot = slot->index;
+    handle.generation = slot->generation;
+    return handle;
+}
+
+// Resolve a handle, returning NULL if its task has since been removed
+Task* resolve_task_handle_ctx(SchedContext *ctx, TaskHandle handle) {
+    TaskManager *tm = &ctx->tasks;
+    
+    if (!tm->initialized || handle.slot < 0 || handle.slot >= tm->pool.slot_count) {
+        return NULL;
+    }
+    
+    TaskSlot *slot = pool_slot(&tm->pool, handle.slot);
+    if (!slot->in_use || slot->generation != handle.generation) {
+        return NULL;
+    }
+    return &slot->task;
+}
+
+// Refresh the packed scan keys after changing a task's scheduling fields
+void update_task_keys_ctx(SchedContext *ctx, Task *task) {
+    if (!ctx->tasks.initialized || task == NULL) {
+        return;
+    }
+    
+    TaskSlot *slot = slot_of(task);
+    if (slot->in_use) {
+        store_task_keys(&ctx->tasks.pool, slot);
+    }
+}
+
+// Find the best task in a state by linear score (SIMD scan over packed keys)
+Task* scan_best_task_ctx(SchedContext *ctx, TaskState state, const TaskScanWeights *weights) {
+    TaskPool *pool = &ctx->tasks.pool;
+    
+    if (!ctx->tasks.initialized || weights == NULL) {
         return NULL;
     }
     
-    for (int i = 0; i < task_count; i++) {
-        if (tasks[i].task_id == task_id) {
-            return &tasks[i];
+    int best_slot = -1;
+    int32_t best_score = 0;
+    
+    for (int c = 0; c < pool->chunk_count; c++) {
+        TaskKeyBlock block = chunk_key_block(pool, c);
+        int32_t score;
+        int index = scan_min_score(&block, state, weights, &score);
+        if (index >= 0 && (best_slot < 0 || score < best_score)) {
+            best_slot = c * TASK_POOL_CHUNK_SIZE + index;
+            best_score = score;
         }
     }
     
-    return NULL;
+    return (best_slot >= 0) ? &pool_slot(pool, best_slot)->task : NULL;
+}
+
+// Get number of live tasks
+int get_task_count_ctx(SchedContext *ctx) {
+    return ctx->tasks.task_count;
+}
+
+// Bytes allocated by the task pool and the task ID index
+size_t get_task_memory_usage_ctx(SchedContext *ctx) {
+    TaskManager *tm = &ctx->tasks;
+    size_t bytes = (size_t)tm->pool.chunk_count * sizeof(TaskChunk) +
+                   (size_t)tm->pool.chunk_capacity * sizeof(TaskChunk*);
+    if (tm->index.entries != NULL) {
+        bytes += (size_t)(tm->index.mask + 1) * sizeof(TaskIndexEntry);
+    }
+    return bytes;
 }
 
 
@@ -165,6 +470,8 @@ Task* get_task(int task_id) {
 // Create a new task queue
 TaskQueue* create_task_queue(void) {
     TaskQueue *queue = (TaskQueue*)safe_malloc(sizeof(TaskQueue));
+    queue->tasks = (Task**)safe_malloc(MAX_TASKS * sizeof(Task*));
+    queue->capacity = MAX_TASKS;
     queue->count = 0;
     queue->front = 0;
     queue->rear = -1;
@@ -175,24 +482,42 @@ TaskQueue* create_task_queue(void) {
 // Destroy task queue
 void destroy_task_queue(TaskQueue *queue) {
     if (queue != NULL) {
+        free(queue->tasks);
         free(queue);
     }
 }
 
+// Double queue capacity, unwrapping the ring into the new buffer
+static void grow_task_queue(TaskQueue *queue) {
+    int new_capacity = queue->capacity * 2;
+    Task **tasks = (Task**)safe_malloc(new_capacity * sizeof(Task*));
+    
+    int index = queue->front;
+    for (int i = 0; i < queue->count; i++) {
+        tasks[i] = queue->tasks[index];
+        index = (index + 1) % queue->capacity;
+    }
+    
+    free(queue->tasks);
+    queue->tasks = tasks;
+    queue->capacity = new_capacity;
+    queue->front = 0;
+    queue->rear = queue->count - 1;
+}
+
 // Enqueue a task
 int enqueue_task(TaskQueue *queue, Task *task) {
     if (queue == NULL || task == NULL) {
-        log_error("Invalid queue or task");
+        LOG_ERROR("Invalid queue or task");
         return ERROR;
     }
     
     if (is_queue_full(queue)) {
-        log_error("Queue is full");
-        return ERROR;
+        grow_task_queue(queue);
     }
     
-    queue->rear = (queue->rear + 1) % MAX_TASKS;
-    queue->tasks[queue->rear] = *task;
+    queue->rear = (queue->rear + 1) % queue->capacity;
+    queue->tasks[queue->rear] = task;
     queue->count++;
     
     return SUCCESS;
@@ -204,23 +529,47 @@ Task* dequeue_task(TaskQueue *queue) {
         return NULL;
     }
     
-    Task *task = &queue->tasks[queue->front];
-    queue->front = (queue->front + 1) % MAX_TASKS;
+    Task *task = queue->tasks[queue->front];
+    queue->front = (queue->front + 1) % queue->capacity;
     queue->count--;
     
     return task;
 }
 
+// Remove a task from anywhere in the queue, keeping the others in order
+int remove_queued_task(TaskQueue *queue, Task *task) {
+    if (queue == NULL || task == NULL) {
+        return ERROR;
+    }
+    
+    int index = queue->front;
+    for (int i = 0; i < queue->count; i++) {
+        if (queue->tasks[index] == task) {
+            // Close the gap by shifting the tasks behind it forward
+            for (int j = i + 1; j < queue->count; j++) {
+                int next = (index + 1) % queue->capacity;
+                queue->tasks[index] = queue->tasks[next];
+                index = next;
+            }
+            queue->rear = (queue->rear - 1 + queue->capacity) % queue->capacity;
+            queue->count--;
+            return SUCCESS;
+        }
+        index = (index + 1) % queue->capacity;
+    }
+    return ERROR;
+}
+
 // Check if queue is empty
 bool is_queue_empty(TaskQueue *queue) {
     if (queue == NULL) return true;
     return (queue->count == 0);
 }
 
-// Check if queue is full
+// Check if queue is at capacity (the next enqueue grows it)
 bool is_queue_full(TaskQueue *queue) {
     if (queue == NULL) return true;
-    return (queue->count >= MAX_TASKS);
+    return (queue->count >= queue->capacity);
 }
 
 // Get queue size
@@ -230,26 +579,210 @@ int get_queue_size(TaskQueue *queue) {
 }
 
 
+// KEYED READY QUEUE (BINARY HEAP)
+
+
+// Does a run before b? Equal keys fall back to enqueue order
+static bool heap_before(TaskHeap *heap, Task *a, Task *b) {
+    int order = heap->compare(a, b);
+    if (order != 0) {
+        return order < 0;
+    }
+    return a->queue_seq < b->queue_seq;
+}
+
+// Place a task at a heap position and record the position in the task
+static void heap_place(TaskHeap *heap, int index, Task *task) {
+    heap->tasks[index] = task;
+    task->queue_index = index;
+}
+
+// Move the task at index toward the root until the heap is ordered
+static void heap_sift_up(TaskHeap *heap, int index) {
+    Task *task = heap->tasks[index];
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!heap_before(heap, task, heap->tasks[parent])) {
+            break;
+        }
+        heap_place(heap, index, heap->tasks[parent]);
+        index = parent;
+    }
+    heap_place(heap, index, task);
+}
+
+// Move the task at index toward the leaves until the heap is ordered
+static void heap_sift_down(TaskHeap *heap, int index) {
+    Task *task = heap->tasks[index];
+    while (true) {
+        int child = 2 * index + 1;
+        if (child >= heap->count) {
+            break;
+        }
+        if (child + 1 < heap->count && 
+            heap_before(heap, heap->tasks[child + 1], heap->tasks[child])) {
+            child++;
+        }
+        if (!heap_before(heap, heap->tasks[child], task)) {
+            break;
+        }
+        heap_place(heap, index, heap->tasks[child]);
+        index = child;
+    }
+    heap_place(heap, index, task);
+}
+
+// Create a keyed ready queue
+TaskHeap* create_task_heap(TaskCompareFn compare) {
+    TaskHeap *heap = (TaskHeap*)safe_malloc(sizeof(TaskHeap));
+    heap->tasks = (Task**)safe_malloc(MAX_TASKS * sizeof(Task*));
+    heap->capacity = MAX_TASKS;
+    heap->count = 0;
+    heap->compare = compare;
+    heap->next_seq = 0;
+    
+    return heap;
+}
+
+// Destroy keyed ready queue
+void destroy_task_heap(TaskHeap *heap) {
+    if (heap != NULL) {
+        free(heap->tasks);
+        free(heap);
+    }
+}
+
+// Change the ordering key and rebuild the heap (O(n))
+void set_heap_order(TaskHeap *heap, TaskCompareFn compare) {
+    if (heap == NULL || compare == NULL) {
+        return;
+    }
+    
+    heap->compare = compare;
+    for (int i = heap->count / 2 - 1; i >= 0; i--) {
+        heap_sift_down(heap, i);
+    }
+}
+
+// Insert a task
+int heap_push_task(TaskHeap *heap, Task *task) {
+    if (heap == NULL || task == NULL) {
+        LOG_ERROR("Invalid heap or task");
+        return ERROR;
+    }
+    
+    if (heap->count == heap->capacity) {
+        int new_capacity = heap->capacity * 2;
+        Task **tasks = (Task**)safe_malloc(new_capacity * sizeof(Task*));
+        memcpy(tasks, heap->tasks, heap->count * sizeof(Task*));
+        free(heap->tasks);
+        heap->tasks = tasks;
+        heap->capacity = new_capacity;
+    }
+    
+    task->queue_seq = heap->next_seq++;
+    heap->tasks[heap->count] = task;
+    heap_sift_up(heap, heap->count++);
+    
+    return SUCCESS;
+}
+
+// Remove and return the task that should run next
+Task* heap_pop_task(TaskHeap *heap) {
+    if (heap == NULL || heap->count == 0) {
+        return NULL;
+    }
+    
+    Task *top = heap->tasks[0];
+    heap_remove_task(heap, top);
+    return top;
+}
+
+// Return the task that should run next without removing it
+Task* heap_peek_task(TaskHeap *heap) {
+    if (heap == NULL || heap->count == 0) {
+        return NULL;
+    }
+    return heap->tasks[0];
+}
+
+// Remove a task from anywhere in the heap
+int heap_remove_task(TaskHeap *heap, Task *task) {
+    if (heap == NULL || task == NULL) {
+        return ERROR;
+    }
+    
+    int index = task->queue_index;
+    if (index < 0 || index >= heap->count || heap->tasks[index] != task) {
+        return ERROR;
+    }
+    
+    task->queue_index = -1;
+    heap->count--;
+    if (index == heap->count) {
+        return SUCCESS;
+    }
+    
+    // Fill the hole with the last task and restore order in either direction
+    Task *moved = heap->tasks[heap->count];
+    heap_place(heap, index, moved);
+    heap_sift_up(heap, index);
+    heap_sift_down(heap, moved->queue_index);
+    
+    return SUCCESS;
+}
+
+// Restore order after a queued task's key changed (decrease- or increase-key)
+int heap_update_task(TaskHeap *heap, Task *task) {
+    if (heap == NULL || task == NULL) {
+        return ERROR;
+    }
+    
+    int index = task->queue_index;
+    if (index < 0 || index >= heap->count || heap->tasks[index] != task) {
+        return ERROR;
+    }
+    
+    heap_sift_up(heap, index);
+    heap_sift_down(heap, task->queue_index);
+    
+    return SUCCESS;
+}
+
+// Check if heap is empty
+bool is_heap_empty(TaskHeap *heap) {
+    if (heap == NULL) return true;
+    return (heap->count == 0);
+}
+
+// Get heap size
+int get_heap_size(TaskHeap *heap) {
+    if (heap == NULL) return 0;
+    return heap->count;
+}
+
+
 // TASK STATE MANAGEMENT
 
 
 // Set task state
-int set_task_state(Task *task, TaskState state) {
+int set_task_state_ctx(SchedContext *ctx, Task *task, TaskState state) {
     if (task == NULL) {
-        log_error("Invalid task");
+        LOG_ERROR("Invalid task");
         return ERROR;
     }
     
     task->state = state;
+    update_task_keys_ctx(ctx, task);
     
-    if (state == TASK_STATE_RUNNING && task->start_time == 0) {
-        task->start_time = get_current_time_ms();
+    if (state == TASK_STATE_RUNNING && task->start_time_ns == 0) {
+        task->start_time_ns = sim_clock_ns(ctx->clock);
     } else if (state == TASK_STATE_COMPLETED) {
-        task->completion_time = get_current_time_ms();
+        task->completion_time_ns = sim_clock_ns(ctx->clock);
         update_task_times(task);
-        update_task_statistics(task);
+        update_task_statistics_ctx(ctx, task);
     } else if (state == TASK_STATE_SUSPENDED) {
-        task_stats.suspended_tasks++;
+        ctx->tasks.stats.suspended_tasks++;
     }
     
     return SUCCESS;
@@ -269,13 +802,11 @@ int update_task_times(Task *task) {
         return ERROR;
     }
     
-    // long current_time = get_current_time_ms();
-    
-    if (task->completion_time > 0) {
-        task->turnaround_time = task->completion_time - task->arrival_time;
-        task->waiting_time = task->turnaround_time - task->burst_time;
-    } else if (task->start_time > 0) {
-        task->waiting_time = task->start_time - task->arrival_time;
+    if (task->completion_time_ns > 0) {
+        task->turnaround_time_ns = task->completion_time_ns - task->arrival_time_ns;
+        task->waiting_time_ns = task->turnaround_time_ns - (int64_t)task->burst_time * NS_PER_MS;
+    } else if (task->start_time_ns > 0) {
+        task->waiting_time_ns = task->start_time_ns - task->arrival_time_ns;
     }
     
     return SUCCESS;
@@ -285,36 +816,32 @@ int update_task_times(Task *task) {
 // TASK FILTERING AND SORTING
 
 
-// Get tasks by priority (simplified - returns count)
-Task** get_tasks_by_priority(int priority, int *count) {
-    *count = 0;
-    for (int i = 0; i < task_count; i++) {
-        if (tasks[i].priority == priority) {
-            (*count)++;
-        }
+// Count live tasks whose packed key equals value (SIMD scan)
+static int count_matching_keys(TaskPool *pool, size_t key_offset, int32_t value) {
+    int count = 0;
+    for (int c = 0; c < pool->chunk_count; c++) {
+        TaskKeyBlock block = chunk_key_block(pool, c);
+        const int32_t *values = (const int32_t*)((const char*)pool->chunks[c] + key_offset);
+        count += scan_count_equal(&block, values, value);
     }
+    return count;
+}
+
+// Get tasks by priority (simplified - returns count)
+Task** get_tasks_by_priority_ctx(SchedContext *ctx, int priority, int *count) {
+    *count = count_matching_keys(&ctx->tasks.pool, offsetof(TaskChunk, priority), priority);
     return NULL;  // Simplified for now
 }
 
 // Get tasks by state
-Task** get_tasks_by_state(TaskState state, int *count) {
-    *count = 0;
-    for (int i = 0; i < task_count; i++) {
-        if (tasks[i].state == state) {
-            (*count)++;
-        }
-    }
+Task** get_tasks_by_state_ctx(SchedContext *ctx, TaskState state, int *count) {
+    *count = count_matching_keys(&ctx->tasks.pool, offsetof(TaskChunk, state), state);
     return NULL;  // Simplified for now
 }
 
 // Get critical tasks
-Task** get_critical_tasks(int *count) {
-    *count = 0;
-    for (int i = 0; i < task_count; i++) {
-        if (tasks[i].is_critical) {
-            (*count)++;
-        }
-    }
+Task** get_critical_tasks_ctx(SchedContext *ctx, int *count) {
+    *count = count_matching_keys(&ctx->tasks.pool, offsetof(TaskChunk, is_critical), 1);
     return NULL;  // Simplified for now
 }
 
@@ -349,46 +876,116 @@ void sort_tasks_by_energy(Task *task_array[], int count) {
 
 
 // Get task statistics
-TaskStats* get_task_statistics(void) {
-    return &task_stats;
+TaskStats* get_task_statistics_ctx(SchedContext *ctx) {
+    return &ctx->tasks.stats;
 }
 
 // Update task statistics
-void update_task_statistics(Task *task) {
+void update_task_statistics_ctx(SchedContext *ctx, Task *task) {
+    TaskStats *task_stats = &ctx->tasks.stats;
+    
     if (task == NULL || task->state != TASK_STATE_COMPLETED) {
         return;
     }
     
-    task_stats.completed_tasks++;
+    task_stats->completed_tasks++;
+    
+    int64_t values[NUM_LATENCY_METRICS];
+    values[LATENCY_WAITING] = task->waiting_time_ns;
+    values[LATENCY_RESPONSE] = task->start_time_ns > 0 ? task->start_time_ns - task->arrival_time_ns
+                                                       : task->turnaround_time_ns;
+    values[LATENCY_TURNAROUND] = task->turnaround_time_ns;
     
-    // Update average waiting time
-    double total_waiting = task_stats.avg_waiting_time * (task_stats.completed_tasks - 1);
-    total_waiting += task->waiting_time;
-    task_stats.avg_waiting_time = total_waiting / task_stats.completed_tasks;
+    LatencyStats *latency = &task_stats->latency;
+    int priority_class = max(PRIORITY_HIGH, min(PRIORITY_LOW, task->base_priority)) - 1;
+    int energy_class = max(ENERGY_LOW, min(ENERGY_HIGH, task->energy_cost)) - 1;
+    for (int metric = 0; metric < NUM_LATENCY_METRICS; metric++) {
+        histogram_record(&latency->all[metric], values[metric]);
+        histogram_record(&latency->by_priority[priority_class][metric], values[metric]);
+        histogram_record(&latency->by_energy[energy_class][metric], values[metric]);
+        if (task->is_critical) {
+            histogram_record(&latency->critical[metric], values[metric]);
+        }
+    }
     
-    // Update average turnaround time
-    double total_turnaround = task_stats.avg_turnaround_time * (task_stats.completed_tasks - 1);
-    total_turnaround += task->turnaround_time;
-    task_stats.avg_turnaround_time = total_turnaround / task_stats.completed_tasks;
+    // Averages from the exact sums kept by the histograms
+    task_stats->avg_waiting_time = histogram_mean(&latency->all[LATENCY_WAITING]) / NS_PER_MS;
+    task_stats->avg_turnaround_time = histogram_mean(&latency->all[LATENCY_TURNAROUND]) / NS_PER_MS;
     
     // Check for missed deadline
-    if (task->deadline > 0 && task->completion_time > (task->arrival_time + task->deadline)) {
-        task_stats.missed_deadlines++;
+    if (task->deadline > 0 && task->turnaround_time_ns > (int64_t)task->deadline * NS_PER_MS) {
+        task_stats->missed_deadlines++;
     }
 }
 
 // Print task statistics
-void print_task_statistics(void) {
+void print_task_statistics_ctx(SchedContext *ctx) {
+    TaskStats *task_stats = &ctx->tasks.stats;
+    
     printf("\n=== Task Statistics ===\n");
-    printf("Total Tasks: %d\n", task_stats.total_tasks);
-    printf("Completed Tasks: %d\n", task_stats.completed_tasks);
-    printf("Suspended Tasks: %d\n", task_stats.suspended_tasks);
-    printf("Average Waiting Time: %.2f ms\n", task_stats.avg_waiting_time);
-    printf("Average Turnaround Time: %.2f ms\n", task_stats.avg_turnaround_time);
-    printf("Missed Deadlines: %d\n", task_stats.missed_deadlines);
+    printf("Total Tasks: %d\n", task_stats->total_tasks);
+    printf("Completed Tasks: %d\n", task_stats->completed_tasks);
+    printf("Suspended Tasks: %d\n", task_stats->suspended_tasks);
+    printf("Average Waiting Time: %.2f ms\n", task_stats->avg_waiting_time);
+    printf("Average Turnaround Time: %.2f ms\n", task_stats->avg_turnaround_time);
+    printf("Missed Deadlines: %d\n", task_stats->missed_deadlines);
+    printf("\n");
+    print_latency_stats(stdout, &task_stats->latency);
     printf("=====================\n\n");
 }
 
+// Empty every latency histogram
+void reset_latency_stats(LatencyStats *latency) {
+    for (int m = 0; m < NUM_LATENCY_METRICS; m++) {
+        histogram_init(&latency->all[m]);
+        histogram_init(&latency->critical[m]);
+        for (int c = 0; c < NUM_PRIORITY_CLASSES; c++) {
+            histogram_init(&latency->by_priority[c][m]);
+        }
+        for (int c = 0; c < NUM_ENERGY_CLASSES; c++) {
+            histogram_init(&latency->by_energy[c][m]);
+        }
+    }
+}
+
+// Add the latency histograms of another run
+void merge_latency_stats(LatencyStats *dst, const LatencyStats *src) {
+    for (int m = 0; m < NUM_LATENCY_METRICS; m++) {
+        histogram_merge(&dst->all[m], &src->all[m]);
+        histogram_merge(&dst->critical[m], &src->critical[m]);
+        for (int c = 0; c < NUM_PRIORITY_CLASSES; c++) {
+            histogram_merge(&dst->by_priority[c][m], &src->by_priority[c][m]);
+        }
+        for (int c = 0; c < NUM_ENERGY_CLASSES; c++) {
+            histogram_merge(&dst->by_energy[c][m], &src->by_energy[c][m]);
+        }
+    }
+}
+
+// Print latency percentiles overall and per task class (ms)
+void print_latency_stats(FILE *out, const LatencyStats *latency) {
+    static const char *metric_names[NUM_LATENCY_METRICS] = {"Waiting", "Response", "Turnaround"};
+    static const char *priority_names[NUM_PRIORITY_CLASSES] = {"high", "medium", "low"};
+    static const char *energy_names[NUM_ENERGY_CLASSES] = {"low", "medium", "high"};
+    char label[32];
+    
+    histogram_print_header(out, "Latency (ms)");
+    for (int metric = 0; metric < NUM_LATENCY_METRICS; metric++) {
+        histogram_print_row(out, metric_names[metric], &latency->all[metric], NS_PER_MS);
+    }
+    
+    // Per-class response time, the basis of the response-time targets
+    histogram_print_row(out, "Response: critical", &latency->critical[LATENCY_RESPONSE], NS_PER_MS);
+    for (int i = 0; i < NUM_PRIORITY_CLASSES; i++) {
+        snprintf(label, sizeof(label), "Response: %s prio", priority_names[i]);
+        histogram_print_row(out, label, &latency->by_priority[i][LATENCY_RESPONSE], NS_PER_MS);
+    }
+    for (int i = 0; i < NUM_ENERGY_CLASSES; i++) {
+        snprintf(label, sizeof(label), "Response: %s energy", energy_names[i]);
+        histogram_print_row(out, label, &latency->by_energy[i][LATENCY_RESPONSE], NS_PER_MS);
+    }
+}
+
 
 // TASK DISPLAY
 
@@ -409,16 +1006,22 @@ void print_task(Task *task) {
         case TASK_STATE_WAITING: printf("WAITING"); break;
         case TASK_STATE_COMPLETED: printf("COMPLETED"); break;
         case TASK_STATE_SUSPENDED: printf("SUSPENDED"); break;
+        case TASK_STATE_DROPPED: printf("DROPPED"); break;
     }
     
     printf(" | Critical: %s\n", task->is_critical ? "YES" : "NO");
 }
 
 // Print all tasks
-void print_all_tasks(void) {
+void print_all_tasks_ctx(SchedContext *ctx) {
+    TaskPool *pool = &ctx->tasks.pool;
+    
     printf("\n=== All Tasks ===\n");
-    for (int i = 0; i < task_count; i++) {
-        print_task(&tasks[i]);
+    for (int i = 0; i < pool->slot_count; i++) {
+        TaskSlot *slot = pool_slot(pool, i);
+        if (slot->in_use) {
+            print_task(&slot->task);
+        }
     }
     printf("=================\n\n");
 }
@@ -433,8 +1036,123 @@ void print_task_queue(TaskQueue *queue) {
     printf("\n=== Task Queue (Size: %d) ===\n", queue->count);
     int index = queue->front;
     for (int i = 0; i < queue->count; i++) {
-        print_task(&queue->tasks[index]);
-        index = (index + 1) % MAX_TASKS;
+        print_task(queue->tasks[index]);
+        index = (index + 1) % queue->capacity;
     }
     printf("============================\n\n");
 }
+
+// Print keyed ready queue (heap order, not dispatch order)
+void print_task_heap(TaskHeap *heap) {
+    if (heap == NULL || is_heap_empty(heap)) {
+        printf("Queue is empty\n");
+        return;
+    }
+    
+    printf("\n=== Task Queue (Size: %d) ===\n", heap->count);
+    for (int i = 0; i < heap->count; i++) {
+        print_task(heap->tasks[i]);
+    }
+    printf("============================\n\n");
+}
+
+
+// DEFAULT CONTEXT
+
+
+// Initialize the default context's task manager
+int task_manager_init(void) {
+    return task_manager_init_ctx(sched_default_context());
+}
+
+// Cleanup the default context's task manager
+void task_manager_cleanup(void) {
+    task_manager_cleanup_ctx(sched_default_context());
+}
+
+// Create a new task
+Task* create_task(const char *name, int priority, int energy_cost, 
+                  int burst_time, bool is_critical, int deadline) {
+    return create_task_ctx(sched_default_context(), name, priority, energy_cost,
+                           burst_time, is_critical, deadline);
+}
+
+// Add task to the task list
+int add_task(Task *task) {
+    return add_task_ctx(sched_default_context(), task);
+}
+
+// Remove task from the list
+int remove_task(int task_id) {
+    return remove_task_ctx(sched_default_context(), task_id);
+}
+
+// Get task by ID
+Task* get_task(int task_id) {
+    return get_task_ctx(sched_default_context(), task_id);
+}
+
+// Get number of live tasks
+int get_task_count(void) {
+    return get_task_count_ctx(sched_default_context());
+}
+
+// Bytes allocated by the task pool and the task ID index
+size_t get_task_memory_usage(void) {
+    return get_task_memory_usage_ctx(sched_default_context());
+}
+
+// Refresh the packed scan keys after changing a task's scheduling fields
+void update_task_keys(Task *task) {
+    update_task_keys_ctx(sched_default_context(), task);
+}
+
+// Find the best task in a state by linear score
+Task* scan_best_task(TaskState state, const TaskScanWeights *weights) {
+    return scan_best_task_ctx(sched_default_context(), state, weights);
+}
+
+// Resolve a handle, returning NULL if its task has since been removed
+Task* resolve_task_handle(TaskHandle handle) {
+    return resolve_task_handle_ctx(sched_default_context(), handle);
+}
+
+// Set task state
+int set_task_state(Task *task, TaskState state) {
+    return set_task_state_ctx(sched_default_context(), task, state);
+}
+
+// Get tasks by priority (simplified - returns count)
+Task** get_tasks_by_priority(int priority, int *count) {
+    return get_tasks_by_priority_ctx(sched_default_context(), priority, count);
+}
+
+// Get tasks by state
+Task** get_tasks_by_state(TaskState state, int *count) {
+    return get_tasks_by_state_ctx(sched_default_context(), state, count);
+}
+
+// Get critical tasks
+Task** get_critical_tasks(int *count) {
+    return get_critical_tasks_ctx(sched_default_context(), count);
+}
+
+// Get task statistics
+TaskStats* get_task_statistics(void) {
+    return get_task_statistics_ctx(sched_default_context());
+}
+
+// Update task statistics
+void update_task_statistics(Task *task) {
+    update_task_statistics_ctx(sched_default_context(), task);
+}
+
+// Print task statistics
+void print_task_statistics(void) {
+    print_task_statistics_ctx(sched_default_context());
+}
+
+// Print all tasks
+void print_all_tasks(void) {
+    print_all_tasks_ctx(sched_default_context());
+}
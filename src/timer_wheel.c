@@ -0,0 +1,231 @@
+#include "../include/timer_wheel.h"
+#include <stddef.h>
+
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
+
+
+// SLOT LISTS
+
+
+// Make a list head point at itself (empty list)
+static void list_init(TimerEntry *head) {
+    head->prev = head;
+    head->next = head;
+}
+
+// Check whether a list is empty
+static bool list_empty(const TimerEntry *head) {
+    return head->next == head;
+}
+
+// Append an entry to a list
+static void list_append(TimerEntry *head, TimerEntry *entry) {
+    entry->prev = head->prev;
+    entry->next = head;
+    head->prev->next = entry;
+    head->prev = entry;
+}
+
+// Unlink an entry from whatever list holds it
+static void list_unlink(TimerEntry *entry) {
+    entry->prev->next = entry->next;
+    entry->next->prev = entry->prev;
+    entry->prev = NULL;
+    entry->next = NULL;
+}
+
+// Move every entry of a wheel slot onto a private list and clear the slot
+static void take_slot(TimerWheel *wheel, int level, int slot, TimerEntry *out) {
+    TimerEntry *head = &wheel->slots[level][slot];
+    list_init(out);
+    if (!list_empty(head)) {
+        out->next = head->next;
+        out->prev = head->prev;
+        out->next->prev = out;
+        out->prev->next = out;
+        list_init(head);
+    }
+    wheel->occupied[level] &= ~(1ULL << slot);
+}
+
+
+// PLACEMENT
+
+
+// Put an entry in the slot for its expiry tick, relative to current_tick
+static void place_entry(TimerWheel *wheel, TimerEntry *entry) {
+    long delta = entry->expires_tick - wheel->current_tick;
+    long slot_tick = entry->expires_tick;
+    int level = 0;
+    
+    if (delta < 0) {
+        // Already due: fire on the next processed tick
+        slot_tick = wheel->current_tick;
+    } else {
+        while (level < TIMER_WHEEL_LEVELS - 1 &&
+               delta >= (1L << (TIMER_WHEEL_BITS * (level + 1)))) {
+            level++;
+        }
+        long range = 1L << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS);
+        if (delta >= range) {
+            // Beyond the wheel: park in the farthest slot, re-placed on cascade
+            slot_tick = wheel->current_tick + range - 1;
+        }
+    }
+    
+    int slot = (int)((slot_tick >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK);
+    entry->level = level;
+    entry->slot = slot;
+    list_append(&wheel->slots[level][slot], entry);
+    wheel->occupied[level] |= 1ULL << slot;
+}
+
+// Re-place the timers of one higher-level slot; returns the slot index
+static int cascade(TimerWheel *wheel, int level) {
+    int slot = (int)((wheel->current_tick >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK);
+    TimerEntry pending;
+    take_slot(wheel, level, slot, &pending);
+    
+    while (!list_empty(&pending)) {
+        TimerEntry *entry = pending.next;
+        list_unlink(entry);
+        place_entry(wheel, entry);
+    }
+    return slot;
+}
+
+
+// TIMER WHEEL API
+
+
+// Initialize an empty wheel whose clock starts at now_ms
+void timer_wheel_init(TimerWheel *wheel, long tick_ms, long now_ms) {
+    if (wheel == NULL) {
+        return;
+    }
+    
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (int slot = 0; slot < TIMER_WHEEL_SLOTS; slot++) {
+            list_init(&wheel->slots[level][slot]);
+        }
+        wheel->occupied[level] = 0;
+    }
+    wheel->tick_ms = tick_ms > 0 ? tick_ms : 1;
+    wheel->current_tick = now_ms / wheel->tick_ms;
+    wheel->count = 0;
+}
+
+// Initialize a timer as not armed
+void timer_entry_init(TimerEntry *entry) {
+    if (entry == NULL) {
+        return;
+    }
+    entry->prev = NULL;
+    entry->next = NULL;
+    entry->expires_tick = 0;
+    entry->level = -1;
+    entry->slot = -1;
+    entry->data = NULL;
+}
+
+// Arm a timer to fire at expires_ms (re-arms it if already armed)
+void timer_wheel_add(TimerWheel *wheel, TimerEntry *entry, long expires_ms, void *data) {
+    if (wheel == NULL || entry == NULL) {
+        return;
+    }
+    
+    timer_wheel_cancel(wheel, entry);
+    
+    // Round up so a timer never fires before its expiry time
+    entry->expires_tick = (expires_ms + wheel->tick_ms - 1) / wheel->tick_ms;
+    entry->data = data;
+    place_entry(wheel, entry);
+    wheel->count++;
+}
+
+// Disarm a timer (no effect if it is not armed)
+void timer_wheel_cancel(TimerWheel *wheel, TimerEntry *entry) {
+    if (wheel == NULL || !timer_is_armed(entry)) {
+        return;
+    }
+    
+    list_unlink(entry);
+    if (entry->level >= 0 && list_empty(&wheel->slots[entry->level][entry->slot])) {
+        wheel->occupied[entry->level] &= ~(1ULL << entry->slot);
+    }
+    wheel->count--;
+}
+
+// Check whether a timer is armed
+bool timer_is_armed(const TimerEntry *entry) {
+    return entry != NULL && entry->next != NULL;
+}
+
+// Fire every timer due at or before now_ms; returns the number fired
+int timer_wheel_advance(TimerWheel *wheel, long now_ms, TimerCallback callback, void *context) {
+    if (wheel == NULL) {
+        return 0;
+    }
+    
+    long target_tick = now_ms / wheel->tick_ms;
+    int fired = 0;
+    
+    while (wheel->current_tick <= target_tick) {
+        if (wheel->count == 0) {
+            wheel->current_tick = target_tick + 1;
+            break;
+        }
+    
+        // On a level-0 wrap, pull the next slot of each higher level down
+        int index = (int)(wheel->current_tick & TIMER_WHEEL_MASK);
+        for (int level = 1; index == 0 && level < TIMER_WHEEL_LEVELS; level++) {
+            index = cascade(wheel, level);
+        }
+    
+        TimerEntry expired;
+        take_slot(wheel, 0, (int)(wheel->current_tick & TIMER_WHEEL_MASK), &expired);
+        wheel->current_tick++;
+    
+        while (!list_empty(&expired)) {
+            TimerEntry *entry = expired.next;
+            list_unlink(entry);
+            entry->level = -1;
+            wheel->count--;
+            fired++;
+            if (callback != NULL) {
+                callback(entry, context);
+            }
+        }
+    
+        // Skip empty level-0 slots up to the next occupied slot or wrap
+        int next = (int)(wheel->current_tick & TIMER_WHEEL_MASK);
+        if (next != 0) {
+            uint64_t ahead = wheel->occupied[0] >> next;
+            long skip = ahead ? __builtin_ctzll(ahead) : TIMER_WHEEL_SLOTS - next;
+            long jump = wheel->current_tick + skip;
+            wheel->current_tick = jump < target_tick + 1 ? jump : target_tick + 1;
+        }
+    }
+    
+    return fired;
+}
+
+// Number of armed timers
+int timer_wheel_count(const TimerWheel *wheel) {
+    return wheel ? wheel->count : 0;
+}
+
+// Earliest time the next timer could fire (-1 if none armed)
+long timer_wheel_next_expiry(const TimerWheel *wheel) {
+    if (wheel == NULL || wheel->count == 0) {
+        return -1;
+    }
+    
+    // Next occupied level-0 slot before the wrap, else the wrap itself,
+    // where the next cascade may bring higher-level timers down
+    int index = (int)(wheel->current_tick & TIMER_WHEEL_MASK);
+    uint64_t ahead = wheel->occupied[0] >> index;
+    long next_tick = ahead ? wheel->current_tick + __builtin_ctzll(ahead) :
+                             (wheel->current_tick | TIMER_WHEEL_MASK) + 1;
+    return next_tick * wheel->tick_ms;
+}
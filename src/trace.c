@@ -0,0 +1,138 @@
+#define _DEFAULT_SOURCE
+#include "../include/trace.h"
+#include "../include/utils.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+// TRACE STATE
+
+
+static TraceHeader *trace_header = NULL;    // Start of the mapping (NULL = off)
+static TraceEvent *trace_events = NULL;     // Event array after the header
+static uint64_t next_event = 0;             // Events claimed, including dropped ones
+static size_t map_size = 0;
+static int trace_fd = -1;
+
+static const char *event_names[] = {
+    "UNKNOWN", "ADMIT", "DISPATCH", "PREEMPT", "SUSPEND", "RESUME", "COMPLETE",
+    "DROP", "MODE_CHANGE", "BATTERY", "CONTEXT_SWITCH"
+};
+
+
+// TRACE API
+
+
+// Start recording into a new file with room for `capacity` events
+int trace_open(const char *path, uint64_t capacity) {
+    if (trace_header != NULL) {
+        LOG_ERROR("Trace already open");
+        return ERROR;
+    }
+    if (path == NULL || capacity == 0) {
+        LOG_ERROR("Invalid trace file or capacity");
+        return ERROR;
+    }
+    
+    trace_fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (trace_fd < 0) {
+        LOG_ERROR("Cannot create trace file %s", path);
+        return ERROR;
+    }
+    
+    // Preallocate the whole file so recording never extends it
+    map_size = sizeof(TraceHeader) + capacity * sizeof(TraceEvent);
+    if (ftruncate(trace_fd, (off_t)map_size) != 0) {
+        LOG_ERROR("Cannot size trace file %s", path);
+        close(trace_fd);
+        trace_fd = -1;
+        return ERROR;
+    }
+    
+    void *mapping = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                         trace_fd, 0);
+    if (mapping == MAP_FAILED) {
+        LOG_ERROR("Cannot map trace file %s", path);
+        close(trace_fd);
+        trace_fd = -1;
+        return ERROR;
+    }
+    
+    TraceHeader *header = (TraceHeader*)mapping;
+    memcpy(header->magic, TRACE_MAGIC, sizeof(header->magic));
+    header->version = TRACE_VERSION;
+    header->event_size = sizeof(TraceEvent);
+    header->capacity = capacity;
+    header->count = 0;
+    header->dropped = 0;
+    header->start_ns = (uint64_t)get_time_ns();
+    
+    trace_events = (TraceEvent*)(header + 1);
+    next_event = 0;
+    trace_header = header;
+    
+    LOG_INFO("Tracing to %s (%llu events)", path, (unsigned long long)capacity);
+    return SUCCESS;
+}
+
+// Stop recording; the file is truncated to the events recorded
+int trace_close(void) {
+    if (trace_header == NULL) {
+        return ERROR;
+    }
+    
+    TraceHeader *header = trace_header;
+    trace_header = NULL;
+    
+    uint64_t recorded = next_event < header->capacity ? next_event : header->capacity;
+    header->count = recorded;
+    header->dropped = next_event - recorded;
+    
+    munmap(header, map_size);
+    if (ftruncate(trace_fd, (off_t)(sizeof(TraceHeader) + recorded * sizeof(TraceEvent))) != 0) {
+        LOG_ERROR("Cannot truncate trace file");
+    }
+    close(trace_fd);
+    trace_fd = -1;
+    trace_events = NULL;
+    
+    LOG_INFO("Trace closed: %llu events, %llu dropped",
+             (unsigned long long)recorded, (unsigned long long)(next_event - recorded));
+    return SUCCESS;
+}
+
+// Check whether a trace is being recorded
+bool trace_enabled(void) {
+    return trace_header != NULL;
+}
+
+// Record one event (no effect unless a trace is open)
+void trace_record(TraceEventType type, int task_id, int32_t a, int32_t b, int32_t c, int32_t d) {
+    if (trace_header == NULL) {
+        return;
+    }
+    
+    uint64_t index = __atomic_fetch_add(&next_event, 1, __ATOMIC_RELAXED);
+    if (index >= trace_header->capacity) {
+        return;  // Full: counted as dropped on close
+    }
+    
+    TraceEvent *event = &trace_events[index];
+    event->timestamp_ns = (uint64_t)get_time_ns();
+    event->task_id = task_id;
+    event->type = (uint16_t)type;
+    event->reserved = 0;
+    event->payload[0] = a;
+    event->payload[1] = b;
+    event->payload[2] = c;
+    event->payload[3] = d;
+}
+
+// Name of an event type (for decoders)
+const char* trace_event_name(uint16_t type) {
+    if (type >= sizeof(event_names) / sizeof(event_names[0])) {
+        return event_names[0];
+    }
+    return event_names[type];
+}
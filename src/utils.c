@@ -1,17 +1,69 @@
 // /home/nishit/Desktop/OS/nishit/osproject/src/utils.c
 #define _DEFAULT_SOURCE
 #include "../include/utils.h"
-#include <sys/time.h>
+#include "../include/log_ring.h"
 #include <unistd.h>
 #include <ctype.h>
+#include <pthread.h>
 
 // TIME UTILITIES
 
+// Virtual clock starts at 1 ms so a start time of 0 still means "never ran"
+#define VIRTUAL_CLOCK_START_NS NS_PER_MS
+
+// Clock of the global time functions (and of the default scheduler context)
+SimClock default_clock = {CLOCK_MODE_WALL, VIRTUAL_CLOCK_START_NS};
+
+// Set a clock's mode and rewind its virtual time
+void sim_clock_init(SimClock *clock, ClockMode mode) {
+    clock->mode = mode;
+    clock->virtual_time_ns = VIRTUAL_CLOCK_START_NS;
+}
+
+// Current time of a clock in nanoseconds
+int64_t sim_clock_ns(const SimClock *clock) {
+    if (clock->mode == CLOCK_MODE_VIRTUAL) {
+        return clock->virtual_time_ns;
+    }
+    return get_monotonic_ns();
+}
+
+// Current time of a clock in milliseconds
+long sim_clock_ms(const SimClock *clock) {
+    return (long)(sim_clock_ns(clock) / NS_PER_MS);
+}
+
+// Sleep on a clock: a virtual clock just moves forward
+void sim_clock_sleep_ms(SimClock *clock, int milliseconds) {
+    if (clock->mode == CLOCK_MODE_VIRTUAL) {
+        sim_clock_advance(clock, milliseconds);
+        return;
+    }
+    usleep(milliseconds * 1000);
+}
+
+// Jump a virtual clock forward to the next event
+void sim_clock_advance(SimClock *clock, long milliseconds) {
+    if (milliseconds > 0) {
+        clock->virtual_time_ns += (int64_t)milliseconds * NS_PER_MS;
+    }
+}
+
+// Get current time in nanoseconds (monotonic, unaffected by clock adjustments)
+int64_t get_time_ns(void) {
+    return sim_clock_ns(&default_clock);
+}
+
+// Read CLOCK_MONOTONIC in nanoseconds, whatever the clock mode
+int64_t get_monotonic_ns(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (int64_t)time.tv_sec * NS_PER_SEC + time.tv_nsec;
+}
+
 // Get current time in milliseconds
 long get_current_time_ms(void) {
-    struct timeval time;
-    gettimeofday(&time, NULL);
-    return (time.tv_sec * 1000) + (time.tv_usec / 1000);
+    return sim_clock_ms(&default_clock);
 }
 
 
@@ -19,6 +71,9 @@ long get_current_time_ms(void) {
 // Global log file pointers
 static FILE *log_file = NULL;
 
+// Messages above this level are skipped (read atomically by LOG_AT)
+int log_runtime_level = LOG_LEVEL_DEBUG;
+
 // Initialize logging
 void init_logging(void) {
     log_file = fopen("logs/scheduler.log", "w");
@@ -29,9 +84,13 @@ void init_logging(void) {
     } else {
         printf("[ERROR] Cannot create logs/scheduler.log\n");
     }
+    
+    // From here on log lines are queued and written by a background thread
+    log_ring_start(STDOUT_FILENO, log_file ? fileno(log_file) : -1);
 }
 // Close logging
 void close_logging(void) {
+    log_ring_stop();
     if (log_file) {
         fprintf(log_file, "=== Logging closed ===\n");
         fflush(log_file);
@@ -41,102 +100,104 @@ void close_logging(void) {
     }
 }
 
+// Wait until every queued log line has been written
+void log_flush(void) {
+    fflush(stdout);
+    log_ring_flush();
+}
+
+// Set the most verbose level that is logged
+void set_log_level(int level) {
+    level = max(LOG_LEVEL_ERROR, min(level, LOG_LEVEL_DEBUG));
+    __atomic_store_n(&log_runtime_level, level, __ATOMIC_RELAXED);
+}
+
+// Get the current log level
+int get_log_level(void) {
+    return __atomic_load_n(&log_runtime_level, __ATOMIC_RELAXED);
+}
+
 // Get current timestamp
 void get_timestamp(char *buffer, size_t size) {
     time_t now = time(NULL);
-    struct tm *tm_info = localtime(&now);
-    strftime(buffer, size, "[%a %b %d %H:%M:%S %Y]", tm_info);
+    struct tm tm_info;
+    localtime_r(&now, &tm_info);  // Contexts may log from several threads
+    strftime(buffer, size, "[%a %b %d %H:%M:%S %Y]", &tm_info);
 }
 
 // LOGGING UTILITIES
 
-// Generic log message with level
-void log_message(const char *level, const char *message) {
+// Log a line on the calling thread (before init_logging() or after close_logging())
+static void log_sync(const char *level, const char *format, va_list args) {
     char timestamp[100];
     get_timestamp(timestamp, sizeof(timestamp));
     
+    va_list file_args;
+    va_copy(file_args, args);
+    
     // Print to CONSOLE
-    printf("%s [%s] %s\n", timestamp, level, message);
+    printf("%s [%s] ", timestamp, level);
+    vprintf(format, args);
+    printf("\n");
     
     // WRITE TO FILE
     if (log_file) {
-        fprintf(log_file, "%s [%s] %s\n", timestamp, level, message);
+        fprintf(log_file, "%s [%s] ", timestamp, level);
+        vfprintf(log_file, format, file_args);
+        fprintf(log_file, "\n");
         fflush(log_file);
     }
+    va_end(file_args);
 }
 
-// Log error message
-void log_error(const char *format, ...) {
+// Queue a line for the writer thread, or write it directly if none is running
+static void log_write(int level, const char *name, const char *format, va_list args) {
+    if (level > get_log_level()) {
+        return;
+    }
+    
+    if (log_ring_push(level, format, args) == LOG_PUSH_STOPPED) {
+        log_sync(name, format, args);
+    }
+}
+
+// Generic log message with level
+void log_message(const char *level, const char *message) {
     char timestamp[100];
     get_timestamp(timestamp, sizeof(timestamp));
     
-    va_list args;
-    
     // Print to CONSOLE
-    printf("%s [ERROR] ", timestamp);
-    va_start(args, format);
-    vprintf(format, args);
-    va_end(args);
-    printf("\n");
+    printf("%s [%s] %s\n", timestamp, level, message);
     
     // WRITE TO FILE
     if (log_file) {
-        fprintf(log_file, "%s [ERROR] ", timestamp);
-        va_start(args, format);
-        vfprintf(log_file, format, args);
-        va_end(args);
-        fprintf(log_file, "\n");
+        fprintf(log_file, "%s [%s] %s\n", timestamp, level, message);
         fflush(log_file);
     }
 }
 
+// Log error message
+void log_error(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    log_write(LOG_LEVEL_ERROR, "ERROR", format, args);
+    va_end(args);
+}
+
 // Log info message
 void log_info(const char *format, ...) {
-    char timestamp[100];
-    get_timestamp(timestamp, sizeof(timestamp));
-    
-    // Print to console
-    printf("%s [INFO] ", timestamp);
     va_list args;
     va_start(args, format);
-    vprintf(format, args);
+    log_write(LOG_LEVEL_INFO, "INFO", format, args);
     va_end(args);
-    printf("\n");
-
-    // Write to log file
-    if (log_file) {
-        fprintf(log_file, "%s [INFO] ", timestamp);
-        va_start(args, format);
-        vfprintf(log_file, format, args);
-        va_end(args);
-        fprintf(log_file, "\n"); 
-        fflush(log_file);
-    }
 }
 
 // Log debug message
 void log_debug(const char *format, ...) {
-    char timestamp[100];
-    get_timestamp(timestamp, sizeof(timestamp));
-    
     va_list args;
-    
-    // Print to CONSOLE
-    printf("%s [DEBUG] ", timestamp);
     va_start(args, format);
-    vprintf(format, args);
+    log_write(LOG_LEVEL_DEBUG, "DEBUG", format, args);
     va_end(args);
-    printf("\n");
-    
-    // WRITE TO FILE
-    if (log_file) {
-        fprintf(log_file, "%s [DEBUG] ", timestamp);
-        va_start(args, format);
-        vfprintf(log_file, format, args);
-        va_end(args);
-        fprintf(log_file, "\n");
-        fflush(log_file);
-    }
 }
 
 // STRING UTILITIES
@@ -209,5 +270,70 @@ void safe_free(void **ptr) {
 
 // Sleep for specified milliseconds
 void sleep_ms(int milliseconds) {
-    usleep(milliseconds * 1000);
+    sim_clock_sleep_ms(&default_clock, milliseconds);
+}
+
+// Select wall-clock or virtual time
+void set_clock_mode(ClockMode mode) {
+    default_clock.mode = mode;
+}
+
+// Get the active clock mode
+ClockMode get_clock_mode(void) {
+    return default_clock.mode;
+}
+
+// Rewind the virtual clock to its start so every run sees the same timeline
+void reset_virtual_clock(void) {
+    default_clock.virtual_time_ns = VIRTUAL_CLOCK_START_NS;
+}
+
+// Jump the virtual clock forward to the next event
+void advance_virtual_clock(long milliseconds) {
+    sim_clock_advance(&default_clock, milliseconds);
+}
+
+// PARALLEL JOBS
+
+// Work shared by the threads of one run_parallel() call
+typedef struct {
+    ParallelJob job;
+    void *context;
+    int count;
+    int next;                       // Next index to claim (atomic)
+} ParallelWork;
+
+// Processors available to run on (at least 1)
+int online_cpu_count(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+}
+
+// Worker: claim and run indices until none are left
+static void* parallel_worker(void *arg) {
+    ParallelWork *work = (ParallelWork*)arg;
+    int index;
+    while ((index = __atomic_fetch_add(&work->next, 1, __ATOMIC_RELAXED)) < work->count) {
+        work->job(index, work->context);
+    }
+    return NULL;
+}
+
+// Run job(0..count-1) on up to `threads` threads (the caller is one of them)
+void run_parallel(ParallelJob job, int count, void *context, int threads) {
+    ParallelWork work = {job, context, count, 0};
+    if (threads > count) {
+        threads = count;
+    }
+    
+    pthread_t *workers = threads > 1 ? (pthread_t*)safe_malloc(sizeof(pthread_t) * (threads - 1)) : NULL;
+    int started = 0;
+    while (started < threads - 1 && pthread_create(&workers[started], NULL, parallel_worker, &work) == 0) {
+        started++;
+    }
+    parallel_worker(&work);
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    free(workers);
 }
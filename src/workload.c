@@ -0,0 +1,310 @@
+#include "../include/workload.h"
+#include "../include/scheduler.h"
+#include <math.h>
+
+
+// RANDOM NUMBER GENERATOR
+
+
+// Rotate left
+static inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// Seed the generator; splitmix64 spreads any seed (even 0) over the state
+void rng_seed(Rng *rng, uint64_t seed) {
+    for (int i = 0; i < 4; i++) {
+        seed += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        rng->state[i] = z ^ (z >> 31);
+    }
+}
+
+// Next 64 random bits (xoshiro256**)
+uint64_t rng_next(Rng *rng) {
+    uint64_t *s = rng->state;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    
+    return result;
+}
+
+// Uniform double in [0, 1) from the top 53 bits
+double rng_uniform(Rng *rng) {
+    return (rng_next(rng) >> 11) * 0x1.0p-53;
+}
+
+// Exponential deviate with the given mean
+double rng_exponential(Rng *rng, double mean) {
+    return -mean * log(1.0 - rng_uniform(rng));
+}
+
+
+// SAMPLING
+
+
+// Index 0-2 drawn with the given relative weights
+static int weighted_pick(Rng *rng, const int weights[3]) {
+    int roll = (int)(rng_uniform(rng) * (weights[0] + weights[1] + weights[2]));
+    for (int i = 0; i < 2; i++) {
+        if (roll < weights[i]) {
+            return i;
+        }
+        roll -= weights[i];
+    }
+    return 2;
+}
+
+// Burst time from the configured distribution, within the bounds
+static int sample_burst(WorkloadGenerator *gen) {
+    const WorkloadConfig *config = &gen->config;
+    double burst;
+    
+    switch (config->burst) {
+        case BURST_PARETO:
+            burst = config->min_burst_ms / pow(1.0 - rng_uniform(&gen->rng), 1.0 / config->pareto_alpha);
+            break;
+        case BURST_BIMODAL:
+            burst = rng_uniform(&gen->rng) < config->long_fraction ?
+                    config->long_burst_ms : config->short_burst_ms;
+            break;
+        case BURST_EXPONENTIAL:
+        default:
+            burst = rng_exponential(&gen->rng, config->burst_mean_ms);
+            break;
+    }
+    
+    burst = fmax(burst, max(config->min_burst_ms, 1));
+    return (int)fmin(burst + 0.5, config->max_burst_ms);
+}
+
+// Gap until the next regular arrival (or batch)
+static double sample_gap(WorkloadGenerator *gen) {
+    if (gen->config.arrival == ARRIVAL_PERIODIC) {
+        return gen->config.mean_interarrival_ms;
+    }
+    return rng_exponential(&gen->rng, gen->config.mean_interarrival_ms);
+}
+
+// Fill in everything but the arrival time
+static void sample_task(WorkloadGenerator *gen, TaskSpec *spec, bool critical) {
+    const WorkloadConfig *config = &gen->config;
+    
+    strcpy(spec->name, critical ? "Critical" : "Synthetic");
+    spec->is_critical = critical;
+    spec->priority = critical ? PRIORITY_HIGH : PRIORITY_HIGH + weighted_pick(&gen->rng, config->priority_mix);
+    spec->energy_cost = ENERGY_LOW + weighted_pick(&gen->rng, config->energy_mix);
+    spec->burst_time = sample_burst(gen);
+    spec->deadline = 0;
+    if (config->deadline_slack_max > 0) {
+        double slack = config->deadline_slack_min +
+                       rng_uniform(&gen->rng) * (config->deadline_slack_max - config->deadline_slack_min);
+        spec->deadline = (int)ceil(spec->burst_time * slack);
+    }
+}
+
+
+// WORKLOAD GENERATOR
+
+
+// Defaults: a mixed interactive workload at ~75% load (Pareto bursts, mean
+// ~30 ms uncapped, one arrival every 40 ms)
+void workload_default_config(WorkloadConfig *config) {
+    config->task_count = 10000;
+    config->seed = 1;
+    config->arrival = ARRIVAL_POISSON;
+    config->mean_interarrival_ms = 40.0;
+    config->batch_size = 4;
+    config->burst = BURST_PARETO;
+    config->burst_mean_ms = 30.0;
+    config->pareto_alpha = 1.5;
+    config->short_burst_ms = 20;
+    config->long_burst_ms = 400;
+    config->long_fraction = 0.05;
+    config->min_burst_ms = 10;
+    config->max_burst_ms = 2000;
+    config->priority_mix[0] = 2;
+    config->priority_mix[1] = 5;
+    config->priority_mix[2] = 3;
+    config->energy_mix[0] = 5;
+    config->energy_mix[1] = 3;
+    config->energy_mix[2] = 2;
+    config->critical_fraction = 0.05;
+    config->critical_bursts_per_sec = 0.0;
+    config->critical_burst_max = 8;
+    config->deadline_slack_min = 2.0;
+    config->deadline_slack_max = 10.0;
+}
+
+// Start a generator at arrival time 0
+int workload_init(WorkloadGenerator *gen, const WorkloadConfig *config) {
+    if (gen == NULL || config == NULL) {
+        LOG_ERROR("Invalid workload generator");
+        return ERROR;
+    }
+    if (config->task_count < 0 || config->mean_interarrival_ms <= 0 ||
+        config->min_burst_ms > config->max_burst_ms || config->max_burst_ms <= 0) {
+        LOG_ERROR("Invalid workload: task count, interarrival or burst bounds");
+        return ERROR;
+    }
+    if ((config->burst == BURST_PARETO && config->pareto_alpha <= 1.0) ||
+        (config->burst == BURST_EXPONENTIAL && config->burst_mean_ms <= 0)) {
+        LOG_ERROR("Invalid workload: burst distribution parameters");
+        return ERROR;
+    }
+    if (config->priority_mix[0] + config->priority_mix[1] + config->priority_mix[2] <= 0 ||
+        config->energy_mix[0] + config->energy_mix[1] + config->energy_mix[2] <= 0) {
+        LOG_ERROR("Invalid workload: priority and energy mixes need a positive weight");
+        return ERROR;
+    }
+    
+    gen->config = *config;
+    gen->config.batch_size = max(config->batch_size, 1);
+    gen->config.critical_burst_max = max(config->critical_burst_max, 1);
+    rng_seed(&gen->rng, config->seed);
+    gen->generated = 0;
+    gen->next_arrival_ms = 0.0;
+    gen->batch_remaining = 0;
+    gen->next_critical_ms = config->critical_bursts_per_sec > 0 ?
+                            rng_exponential(&gen->rng, 1000.0 / config->critical_bursts_per_sec) : 0.0;
+    gen->critical_remaining = 0;
+    
+    return SUCCESS;
+}
+
+// Produce the next task in arrival order (false once task_count are out)
+bool workload_next(void *generator, TaskSpec *spec) {
+    WorkloadGenerator *gen = (WorkloadGenerator*)generator;
+    const WorkloadConfig *config = &gen->config;
+    
+    if (gen->generated >= config->task_count) {
+        return false;
+    }
+    
+    // Start whichever group arrives first: a critical burst or the next
+    // regular arrival (a batch of one unless arrivals come in batches)
+    if (gen->critical_remaining == 0 && gen->batch_remaining == 0) {
+        if (config->critical_bursts_per_sec > 0 && gen->next_critical_ms < gen->next_arrival_ms) {
+            gen->critical_remaining = 1 + (int)(rng_uniform(&gen->rng) * config->critical_burst_max);
+        } else if (config->arrival == ARRIVAL_BATCH) {
+            gen->batch_remaining = 1 + (int)(rng_uniform(&gen->rng) * config->batch_size);
+        } else {
+            gen->batch_remaining = 1;
+        }
+    }
+    
+    if (gen->critical_remaining > 0) {
+        spec->arrival_ms = (int64_t)gen->next_critical_ms;
+        sample_task(gen, spec, true);
+        if (--gen->critical_remaining == 0) {
+            gen->next_critical_ms += rng_exponential(&gen->rng, 1000.0 / config->critical_bursts_per_sec);
+        }
+    } else {
+        spec->arrival_ms = (int64_t)gen->next_arrival_ms;
+        sample_task(gen, spec, rng_uniform(&gen->rng) < config->critical_fraction);
+        if (--gen->batch_remaining == 0) {
+            gen->next_arrival_ms += sample_gap(gen);
+        }
+    }
+    
+    gen->generated++;
+    return true;
+}
+
+// Mean burst time of the configured distribution before the bounds apply
+// (for turning an offered load into an interarrival time)
+double workload_mean_burst_ms(const WorkloadConfig *config) {
+    switch (config->burst) {
+        case BURST_PARETO:
+            return config->pareto_alpha * config->min_burst_ms / (config->pareto_alpha - 1.0);
+        case BURST_BIMODAL:
+            return config->long_fraction * config->long_burst_ms +
+                   (1.0 - config->long_fraction) * config->short_burst_ms;
+        case BURST_EXPONENTIAL:
+        default:
+            return config->burst_mean_ms;
+    }
+}
+
+
+// STREAMING ADMISSION
+
+
+// Create a task from its spec and offer it to the scheduler
+static void admit_spec(WorkloadStream *stream, const TaskSpec *spec) {
+    SchedContext *ctx = stream->ctx;
+    Task *task = create_task_ctx(ctx, spec->name, spec->priority, spec->energy_cost,
+                                 spec->burst_time, spec->is_critical, spec->deadline);
+    if (task == NULL) {
+        stream->rejected++;
+        return;
+    }
+    
+    // Checked first so a refusal is not logged as an error per task
+    if (!can_admit_task_ctx(ctx, task) || admit_task_to_scheduler_ctx(ctx, task) != SUCCESS) {
+        remove_task_ctx(ctx, task->task_id);
+        stream->rejected++;
+        return;
+    }
+    
+    stream->admitted++;
+    stream->peak_live = max(stream->peak_live, get_task_count_ctx(ctx));
+}
+
+// Scheduler done hook: finished and dropped tasks leave the pool
+static void release_task(Task *task, void *context) {
+    remove_task_ctx((SchedContext*)context, task->task_id);
+}
+
+// Start feeding a spec source to the default scheduler from the current time
+int workload_stream_start(WorkloadStream *stream, TaskSpecSource next, void *source) {
+    return workload_stream_start_ctx(sched_default_context(), stream, next, source);
+}
+
+// Start feeding a spec source to a context's scheduler from its current time
+int workload_stream_start_ctx(SchedContext *ctx, WorkloadStream *stream, TaskSpecSource next,
+                              void *source) {
+    if (stream == NULL || next == NULL) {
+        LOG_ERROR("Invalid workload stream");
+        return ERROR;
+    }
+    
+    stream->ctx = ctx;
+    stream->next = next;
+    stream->source = source;
+    stream->has_pending = next(source, &stream->pending);
+    stream->start_ms = sim_clock_ms(ctx->clock);
+    stream->admitted = 0;
+    stream->rejected = 0;
+    stream->peak_live = 0;
+    
+    set_arrival_source_ctx(ctx, workload_stream_admit, stream);
+    set_task_done_hook_ctx(ctx, release_task, ctx);
+    
+    return SUCCESS;
+}
+
+// Arrival source: admit every task due by now_ms; returns when the next is due
+long workload_stream_admit(long now_ms, void *context) {
+    WorkloadStream *stream = (WorkloadStream*)context;
+    
+    while (stream->has_pending) {
+        long due = stream->start_ms + (long)stream->pending.arrival_ms;
+        if (due > now_ms) {
+            return due;
+        }
+        admit_spec(stream, &stream->pending);
+        stream->has_pending = stream->next(stream->source, &stream->pending);
+    }
+    
+    return -1;
+}
@@ -119,6 +119,41 @@ void test_simulate_battery_drain(void) {
     battery_monitor_cleanup();
 }
 
+// Events seen by the battery event callback
+static int battery_events = 0;
+static BatteryState last_event_state;
+
+// Record a battery event
+static void count_battery_event(SchedContext *ctx, int level, BatteryState state) {
+    (void)ctx;
+    (void)level;
+    battery_events++;
+    last_event_state = state;
+}
+
+// Test that state changes and threshold crossings raise events
+void test_battery_events(void) {
+    battery_monitor_init();
+    set_battery_event_callback(count_battery_event);
+    battery_events = 0;
+    
+    set_battery_state(BATTERY_STATE_CHARGING);
+    TEST_ASSERT(battery_events == 1, "State change raises an event");
+    TEST_ASSERT(last_event_state == BATTERY_STATE_CHARGING, "Event reports the new state");
+    
+    set_battery_state(BATTERY_STATE_DISCHARGING);
+    battery_events = 0;
+    
+    // Draining to empty crosses the high, medium, low and critical thresholds
+    while (get_battery_level() > 0) {
+        simulate_battery_drain(ENERGY_LOW);
+    }
+    TEST_ASSERT(battery_events == 4, "Each threshold crossing raises one event");
+    
+    set_battery_event_callback(NULL);
+    battery_monitor_cleanup();
+}
+
 // Test battery threshold management
 void test_battery_thresholds(void) {
     battery_monitor_init();
@@ -209,7 +244,7 @@ void test_update_battery_status(void) {
     TEST_ASSERT(result == SUCCESS, "Update battery status");
     
     BatteryInfo *info = get_battery_info();
-    TEST_ASSERT(info->last_update_time > 0, "Last update time set");
+    TEST_ASSERT(info->last_update_ns > 0, "Last update time set");
     
     battery_monitor_cleanup();
 }
@@ -265,6 +300,27 @@ void test_battery_level_bounds(void) {
     battery_monitor_cleanup();
 }
 
+// Test setting the level directly (simulated top-up)
+void test_set_battery_level(void) {
+    battery_monitor_init();
+    set_battery_event_callback(count_battery_event);
+    battery_events = 0;
+    
+    TEST_ASSERT(set_battery_level(15) == SUCCESS, "Set battery level");
+    TEST_ASSERT(get_battery_level() == 15, "Level is the one set");
+    TEST_ASSERT(get_battery_info()->voltage == 3300 + 15 * 9, "Voltage follows the level");
+    TEST_ASSERT(battery_events == 1, "Crossing thresholds raises an event");
+    
+    set_battery_level(150);
+    TEST_ASSERT(get_battery_level() == 100, "Level capped at 100%");
+    set_battery_level(-5);
+    TEST_ASSERT(get_battery_level() == 0, "Level floored at 0%");
+    
+    set_battery_event_callback(NULL);
+    battery_monitor_cleanup();
+    TEST_ASSERT(set_battery_level(50) == ERROR, "Set level fails when not initialized");
+}
+
 // Test battery info structure
 void test_battery_info_structure(void) {
     battery_monitor_init();
@@ -304,6 +360,7 @@ int main(void) {
     RUN_TEST(test_discharge_rate);
     RUN_TEST(test_simulate_battery_drain);
     RUN_TEST(test_battery_thresholds);
+    RUN_TEST(test_battery_events);
     RUN_TEST(test_is_battery_critical);
     RUN_TEST(test_is_battery_low);
     RUN_TEST(test_is_battery_charging);
@@ -311,6 +368,7 @@ int main(void) {
     RUN_TEST(test_estimate_remaining_time);
     RUN_TEST(test_voltage_correlation);
     RUN_TEST(test_battery_level_bounds);
+    RUN_TEST(test_set_battery_level);
     RUN_TEST(test_battery_info_structure);
     RUN_TEST(test_cleanup_without_init);
     
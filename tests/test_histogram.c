@@ -0,0 +1,171 @@
+#include "../include/histogram.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+
+// TEST COUNTER
+
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+
+// TEST HELPER MACROS
+
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            printf("[PASS] %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("[FAIL] %s\n", message); \
+            tests_failed++; \
+        } \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        printf("\n--- Running %s ---\n", #test_func); \
+        test_func(); \
+    } while(0)
+
+
+// TEST HELPERS
+
+
+static Histogram hist;
+static Histogram other;
+
+// Check that a reported value is within the histogram's relative precision
+static int within_precision(int64_t reported, int64_t expected) {
+    int64_t error = reported > expected ? reported - expected : expected - reported;
+    return error * HIST_SUB_BUCKETS <= expected;
+}
+
+
+// TEST FUNCTIONS
+
+
+// Test an empty histogram
+void test_empty_histogram(void) {
+    histogram_init(&hist);
+    TEST_ASSERT(hist.total == 0, "Empty histogram has no values");
+    TEST_ASSERT(histogram_percentile(&hist, 99.0) == 0, "Percentile of empty histogram is 0");
+    TEST_ASSERT(histogram_mean(&hist) == 0.0, "Mean of empty histogram is 0");
+}
+
+// Test that small values are recorded exactly
+void test_small_values_exact(void) {
+    histogram_init(&hist);
+    for (int64_t v = 0; v < HIST_SUB_BUCKETS * 2; v++) {
+        histogram_record(&hist, v);
+    }
+    
+    TEST_ASSERT(hist.min == 0 && hist.max == HIST_SUB_BUCKETS * 2 - 1, "Min and max tracked");
+    TEST_ASSERT(histogram_percentile(&hist, 50.0) == HIST_SUB_BUCKETS - 1, "Median exact");
+    TEST_ASSERT(histogram_percentile(&hist, 100.0) == hist.max, "p100 is max");
+}
+
+// Test percentiles of a uniform distribution against their exact values
+void test_percentile_precision(void) {
+    histogram_init(&hist);
+    for (int64_t v = 1; v <= 100000; v++) {
+        histogram_record(&hist, v * 1000);  // 1 us .. 100 ms in ns
+    }
+    
+    TEST_ASSERT(within_precision(histogram_percentile(&hist, 50.0), 50000000), "p50 within 3%");
+    TEST_ASSERT(within_precision(histogram_percentile(&hist, 90.0), 90000000), "p90 within 3%");
+    TEST_ASSERT(within_precision(histogram_percentile(&hist, 99.0), 99000000), "p99 within 3%");
+    TEST_ASSERT(within_precision(histogram_percentile(&hist, 99.9), 99900000), "p99.9 within 3%");
+    TEST_ASSERT(hist.max == 100000000, "Max exact");
+    TEST_ASSERT(histogram_mean(&hist) == 50000500.0, "Mean exact");
+}
+
+// Test that a tail is visible in the high percentiles only
+void test_tail_visibility(void) {
+    histogram_init(&hist);
+    for (int i = 0; i < 990; i++) {
+        histogram_record(&hist, 1000000);     // 1 ms
+    }
+    for (int i = 0; i < 10; i++) {
+        histogram_record(&hist, 250000000);   // 250 ms
+    }
+    
+    TEST_ASSERT(within_precision(histogram_percentile(&hist, 50.0), 1000000), "Median is the common value");
+    TEST_ASSERT(within_precision(histogram_percentile(&hist, 99.0), 1000000), "p99 at the 990th value");
+    TEST_ASSERT(histogram_percentile(&hist, 99.9) == 250000000, "p99.9 shows the tail");
+}
+
+// Test out-of-range values
+void test_out_of_range(void) {
+    histogram_init(&hist);
+    histogram_record(&hist, -5);
+    histogram_record(&hist, INT64_MAX);
+    
+    TEST_ASSERT(hist.total == 2 && hist.min == 0, "Negative value recorded as 0");
+    TEST_ASSERT(hist.max == INT64_MAX, "Huge value kept as max");
+    TEST_ASSERT(histogram_percentile(&hist, 100.0) == INT64_MAX, "p100 returns exact max");
+}
+
+// Test that merging equals recording everything into one histogram
+void test_merge(void) {
+    Histogram combined;
+    histogram_init(&hist);
+    histogram_init(&other);
+    histogram_init(&combined);
+    
+    for (int64_t v = 1; v <= 5000; v++) {
+        histogram_record(v % 2 ? &hist : &other, v * 997);
+        histogram_record(&combined, v * 997);
+    }
+    histogram_merge(&hist, &other);
+    
+    TEST_ASSERT(hist.total == combined.total && hist.sum == combined.sum, "Totals merged");
+    TEST_ASSERT(hist.min == combined.min && hist.max == combined.max, "Min and max merged");
+    
+    int same = 1;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        same = same && hist.counts[i] == combined.counts[i];
+    }
+    TEST_ASSERT(same, "Bucket counts merged");
+    TEST_ASSERT(histogram_percentile(&hist, 99.0) == histogram_percentile(&combined, 99.0),
+                "Merged percentiles match");
+    
+    histogram_init(&other);
+    histogram_merge(&hist, &other);
+    TEST_ASSERT(hist.min == combined.min, "Merging an empty histogram changes nothing");
+}
+
+
+// MAIN TEST RUNNER
+
+
+int main(void) {
+    printf("\n");
+    printf("========================================\n");
+    printf("   HISTOGRAM UNIT TESTS\n");
+    printf("========================================\n");
+    
+    // Run all tests
+    RUN_TEST(test_empty_histogram);
+    RUN_TEST(test_small_values_exact);
+    RUN_TEST(test_percentile_precision);
+    RUN_TEST(test_tail_visibility);
+    RUN_TEST(test_out_of_range);
+    RUN_TEST(test_merge);
+    
+    // Print summary
+    printf("\n");
+    printf("========================================\n");
+    printf("   TEST SUMMARY\n");
+    printf("========================================\n");
+    printf("Tests Passed: %d\n", tests_passed);
+    printf("Tests Failed: %d\n", tests_failed);
+    printf("Total Tests: %d\n", tests_passed + tests_failed);
+    printf("Success Rate: %.2f%%\n",
+           (tests_passed * 100.0) / (tests_passed + tests_failed));
+    printf("========================================\n\n");
+    
+    return (tests_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,310 @@
+#define _DEFAULT_SOURCE
+#include "../include/log_ring.h"
+#include "../include/utils.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+
+
+// TEST COUNTER
+
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+
+// TEST HELPER MACROS
+
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            printf("[PASS] %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("[FAIL] %s\n", message); \
+            tests_failed++; \
+        } \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        printf("\n--- Running %s ---\n", #test_func); \
+        test_func(); \
+    } while(0)
+
+
+// TEST HELPERS
+
+
+#define PRODUCERS 4
+
+// Per-producer workload for the concurrency tests
+typedef struct {
+    int id;                         // Producer number
+    int count;                      // Entries to push
+    int level;                      // Level of every entry
+} ProducerArgs;
+
+// Result of reading the log output back
+typedef struct {
+    int lines;                      // Lines written
+    int out_of_order;               // Entries behind an earlier one from the same producer
+} OutputCheck;
+
+static FILE *output;
+
+// Push one formatted entry
+static LogPushResult push(int level, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    LogPushResult result = log_ring_push(level, format, args);
+    va_end(args);
+    return result;
+}
+
+// Start the ring writing into a fresh temporary file
+static void start_ring(void) {
+    output = tmpfile();
+    log_ring_start(-1, fileno(output));
+}
+
+// Stop the ring and parse what it wrote ("... [LEVEL] T<producer> <sequence>")
+static OutputCheck stop_ring(void) {
+    OutputCheck check = {0, 0};
+    int last[PRODUCERS];
+    for (int i = 0; i < PRODUCERS; i++) {
+        last[i] = -1;
+    }
+    
+    log_ring_stop();
+    rewind(output);
+    
+    char line[MAX_LOG_MSG + 64];
+    while (fgets(line, sizeof(line), output) != NULL) {
+        int producer, sequence;
+        char *entry = strstr(line, "] T");
+        check.lines++;
+        if (entry == NULL || sscanf(entry, "] T%d %d", &producer, &sequence) != 2 ||
+            producer < 0 || producer >= PRODUCERS) {
+            continue;
+        }
+        if (sequence <= last[producer]) {
+            check.out_of_order++;
+        }
+        last[producer] = sequence;
+    }
+    
+    fclose(output);
+    return check;
+}
+
+// Producer thread body
+static void* produce(void *arg) {
+    ProducerArgs *args = (ProducerArgs*)arg;
+    for (int i = 0; i < args->count; i++) {
+        push(args->level, "T%d %d", args->id, i);
+    }
+    return NULL;
+}
+
+// Producer thread body: log ERROR entries until the ring stops, counting
+// those queued
+static void* produce_until_stopped(void *arg) {
+    long *queued = (long*)arg;
+    while (push(LOG_LEVEL_ERROR, "T%d %ld", 0, *queued) == LOG_PUSH_QUEUED) {
+        (*queued)++;
+    }
+    return NULL;
+}
+
+// Run PRODUCERS threads concurrently against the ring
+static void run_producers(int count, int level) {
+    pthread_t threads[PRODUCERS];
+    ProducerArgs args[PRODUCERS];
+    for (int i = 0; i < PRODUCERS; i++) {
+        args[i].id = i;
+        args[i].count = count;
+        args[i].level = level;
+        pthread_create(&threads[i], NULL, produce, &args[i]);
+    }
+    for (int i = 0; i < PRODUCERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+}
+
+
+// TEST FUNCTIONS
+
+
+// Test that entries are formatted and written in order
+void test_single_producer(void) {
+    start_ring();
+    TEST_ASSERT(log_ring_active(), "Ring active after start");
+    
+    for (int i = 0; i < 100; i++) {
+        push(LOG_LEVEL_INFO, "T%d %d", 0, i);
+    }
+    log_ring_flush();
+    
+    char line[MAX_LOG_MSG + 64] = "";
+    rewind(output);
+    int lines = 0;
+    while (fgets(line, sizeof(line), output) != NULL) {
+        lines++;
+    }
+    TEST_ASSERT(lines == 100, "Flush writes every queued entry");
+    TEST_ASSERT(strstr(line, "[INFO] T0 99") != NULL, "Entry carries level and message");
+    
+    OutputCheck check = stop_ring();
+    TEST_ASSERT(!log_ring_active(), "Ring inactive after stop");
+    TEST_ASSERT(check.out_of_order == 0, "Entries written in order");
+}
+
+// Test that the writer formats entries exactly as printf would, including
+// string arguments whose buffer is reused right after the call
+void test_deferred_formatting(void) {
+    char name[16];
+    char expected[3][MAX_LOG_MSG];
+    
+    start_ring();
+    strcpy(name, "Alpha");
+    push(LOG_LEVEL_INFO, "Task %s: %5.2f%% %*d|%-4ld|%zu|%c|%.3s", 
+         name, 12.345, 6, 42, -7L, (size_t)99, 'x', "truncated");
+    snprintf(expected[0], MAX_LOG_MSG, "Task %s: %5.2f%% %*d|%-4ld|%zu|%c|%.3s", 
+             name, 12.345, 6, 42, -7L, (size_t)99, 'x', "truncated");
+    strcpy(name, "Beta");
+    push(LOG_LEVEL_INFO, "%lld %#x %e %s", -5LL, 255u, 0.5, name);
+    snprintf(expected[1], MAX_LOG_MSG, "%lld %#x %e %s", -5LL, 255u, 0.5, name);
+    strcpy(name, "Gamma");
+    
+    // More arguments than a slot holds: formatted by the producer instead
+    push(LOG_LEVEL_INFO, "%d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d",
+         1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17);
+    strcpy(expected[2], "1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17");
+    log_ring_flush();
+    
+    char line[MAX_LOG_MSG + 64];
+    int matches = 0;
+    rewind(output);
+    for (int i = 0; i < 3 && fgets(line, sizeof(line), output) != NULL; i++) {
+        char *message = strstr(line, "[INFO] ");
+        line[strcspn(line, "\n")] = '\0';
+        matches += message != NULL && strcmp(message + 7, expected[i]) == 0;
+    }
+    TEST_ASSERT(matches == 3, "Writer output matches printf");
+    stop_ring();
+}
+
+// Test that stopping the ring drains entries not yet flushed
+void test_stop_drains(void) {
+    start_ring();
+    for (int i = 0; i < LOG_RING_CAPACITY / 2; i++) {
+        push(LOG_LEVEL_DEBUG, "T%d %d", 1, i);
+    }
+    
+    OutputCheck check = stop_ring();
+    TEST_ASSERT(check.lines == LOG_RING_CAPACITY / 2, "Stop writes pending entries");
+}
+
+// Test that stopping while producers are logging loses no queued entry
+void test_stop_during_pushes(void) {
+    pthread_t threads[PRODUCERS];
+    long queued[PRODUCERS] = {0};
+    
+    start_ring();
+    for (int i = 0; i < PRODUCERS; i++) {
+        pthread_create(&threads[i], NULL, produce_until_stopped, &queued[i]);
+    }
+    usleep(20000);
+    OutputCheck check = stop_ring();
+    
+    long total = 0;
+    for (int i = 0; i < PRODUCERS; i++) {
+        pthread_join(threads[i], NULL);
+        total += queued[i];
+    }
+    TEST_ASSERT(total > 0, "Producers were logging when the ring stopped");
+    TEST_ASSERT(check.lines == total, "Every entry queued before the stop is written");
+    TEST_ASSERT(push(LOG_LEVEL_INFO, "after") == LOG_PUSH_STOPPED, "Stopped ring refuses entries");
+}
+
+// Test concurrent producers: per-producer order is kept and every entry is
+// either written or counted as dropped
+void test_concurrent_producers(void) {
+    const int count = LOG_RING_CAPACITY * 4;
+    start_ring();
+    run_producers(count, LOG_LEVEL_INFO);
+    long dropped = log_ring_dropped();
+    
+    OutputCheck check = stop_ring();
+    TEST_ASSERT(check.lines + dropped == (long)PRODUCERS * count,
+                "Every entry written or counted as dropped");
+    TEST_ASSERT(check.out_of_order == 0, "Each producer's entries stay in order");
+}
+
+// Test that ERROR entries wait for space instead of being dropped
+void test_errors_never_dropped(void) {
+    const int count = LOG_RING_CAPACITY * 2;
+    start_ring();
+    run_producers(count, LOG_LEVEL_ERROR);
+    
+    TEST_ASSERT(log_ring_dropped() == 0, "No ERROR entry dropped");
+    OutputCheck check = stop_ring();
+    TEST_ASSERT(check.lines == PRODUCERS * count, "Every ERROR entry written");
+    TEST_ASSERT(check.out_of_order == 0, "ERROR entries stay in order");
+}
+
+// Test that disabled levels skip evaluating their arguments
+void test_level_gating(void) {
+    int evaluated = 0;
+    
+    set_log_level(LOG_LEVEL_INFO);
+    LOG_DEBUG("Debug message %d", ++evaluated);
+    TEST_ASSERT(evaluated == 0, "Disabled level does not evaluate arguments");
+    LOG_INFO("Info message %d", ++evaluated);
+    TEST_ASSERT(evaluated == 1, "Enabled level evaluates arguments");
+    
+    set_log_level(LOG_LEVEL_ERROR);
+    LOG_INFO("Info message %d", ++evaluated);
+    TEST_ASSERT(evaluated == 1, "INFO skipped at ERROR level");
+    
+    set_log_level(LOG_LEVEL_DEBUG + 5);
+    TEST_ASSERT(get_log_level() == LOG_LEVEL_DEBUG, "Level clamped to DEBUG");
+}
+
+
+// MAIN TEST RUNNER
+
+
+int main(void) {
+    printf("\n");
+    printf("========================================\n");
+    printf("   LOG RING UNIT TESTS\n");
+    printf("========================================\n");
+    
+    // Run all tests
+    RUN_TEST(test_single_producer);
+    RUN_TEST(test_deferred_formatting);
+    RUN_TEST(test_stop_drains);
+    RUN_TEST(test_concurrent_producers);
+    RUN_TEST(test_stop_during_pushes);
+    RUN_TEST(test_errors_never_dropped);
+    RUN_TEST(test_level_gating);
+    
+    // Print summary
+    printf("\n");
+    printf("========================================\n");
+    printf("   TEST SUMMARY\n");
+    printf("========================================\n");
+    printf("Tests Passed: %d\n", tests_passed);
+    printf("Tests Failed: %d\n", tests_failed);
+    printf("Total Tests: %d\n", tests_passed + tests_failed);
+    printf("Success Rate: %.2f%%\n",
+           (tests_passed * 100.0) / (tests_passed + tests_failed));
+    printf("========================================\n\n");
+    
+    return (tests_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,185 @@
+#include "../include/montecarlo.h"
+#include "../include/workload.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+// TEST COUNTER
+
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+
+// TEST HELPER MACROS
+
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            printf("[PASS] %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("[FAIL] %s\n", message); \
+            tests_failed++; \
+        } \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        printf("\n--- Running %s ---\n", #test_func); \
+        test_func(); \
+    } while(0)
+
+
+// TEST HELPERS
+
+
+// Approximately normal value (sum of 12 uniforms, mean 0, variance 1)
+static double normal_value(Rng *rng) {
+    double sum = 0.0;
+    for (int i = 0; i < 12; i++) {
+        sum += rng_uniform(rng);
+    }
+    return sum - 6.0;
+}
+
+// Stat of `count` values drawn around `mean`
+static RunningStat sample_stat(Rng *rng, double mean, int count) {
+    RunningStat stat;
+    running_stat_init(&stat);
+    for (int i = 0; i < count; i++) {
+        running_stat_add(&stat, mean + normal_value(rng));
+    }
+    return stat;
+}
+
+
+// RUNNING STATISTICS TESTS
+
+
+// Test the mean and standard deviation against a direct computation
+void test_running_stat(void) {
+    double values[] = {2, 4, 4, 4, 5, 5, 7, 9};
+    RunningStat stat;
+    running_stat_init(&stat);
+    TEST_ASSERT(running_stat_stddev(&stat) == 0.0, "No spread without values");
+    for (int i = 0; i < 8; i++) {
+        running_stat_add(&stat, values[i]);
+    }
+    TEST_ASSERT(stat.count == 8 && fabs(stat.mean - 5.0) < 1e-12, "Mean");
+    TEST_ASSERT(fabs(running_stat_stddev(&stat) - sqrt(32.0 / 7.0)) < 1e-12, "Sample standard deviation");
+    
+    // A large offset does not cost precision
+    running_stat_init(&stat);
+    for (int i = 0; i < 8; i++) {
+        running_stat_add(&stat, 1e9 + values[i]);
+    }
+    TEST_ASSERT(fabs(running_stat_stddev(&stat) - sqrt(32.0 / 7.0)) < 1e-6, "Stable with a large offset");
+}
+
+// Test the t quantiles against the table and the normal limit
+void test_student_t(void) {
+    TEST_ASSERT(isinf(student_t_975(0)), "No interval without degrees of freedom");
+    TEST_ASSERT(fabs(student_t_975(1) - 12.706) < 1e-9 && fabs(student_t_975(4) - 2.776) < 1e-9,
+                "Small samples from the table");
+    TEST_ASSERT(fabs(student_t_975(40) - 2.021) < 0.003 && fabs(student_t_975(120) - 1.980) < 0.002,
+                "Approximation past the table");
+    TEST_ASSERT(student_t_975(100000) > 1.959 && student_t_975(100000) < 1.961, "Normal limit");
+    
+    bool decreasing = true;
+    for (long df = 2; df < 200; df++) {
+        decreasing &= student_t_975(df) < student_t_975(df - 1);
+    }
+    TEST_ASSERT(decreasing, "Quantile shrinks with more samples");
+}
+
+
+// CONFIDENCE INTERVAL TESTS
+
+
+// Test that about 95% of intervals contain the true mean
+void test_interval_coverage(void) {
+    Rng rng;
+    rng_seed(&rng, 42);
+    
+    RunningStat one;
+    running_stat_init(&one);
+    running_stat_add(&one, 3.0);
+    TEST_ASSERT(isinf(running_stat_ci95(&one).half_width), "One value gives no interval");
+    
+    int covered = 0;
+    for (int trial = 0; trial < 2000; trial++) {
+        RunningStat stat = sample_stat(&rng, 10.0, 8);
+        Interval interval = running_stat_ci95(&stat);
+        covered += fabs(interval.mean - 10.0) <= interval.half_width;
+    }
+    TEST_ASSERT(covered >= 1860 && covered <= 1940, "95% coverage with 8 values");
+    
+    RunningStat small = sample_stat(&rng, 0.0, 10);
+    RunningStat large = sample_stat(&rng, 0.0, 1000);
+    TEST_ASSERT(running_stat_ci95(&large).half_width < running_stat_ci95(&small).half_width / 5,
+                "Interval narrows with more values");
+}
+
+// Test that a minimum is reported only once it is clear of the others
+void test_separation(void) {
+    Rng rng;
+    rng_seed(&rng, 7);
+    RunningStat stats[3];
+    
+    stats[0] = sample_stat(&rng, 10.0, 5);
+    stats[1] = sample_stat(&rng, 10.2, 5);
+    stats[2] = sample_stat(&rng, 20.0, 5);
+    TEST_ASSERT(mc_separated_minimum(stats, 3) == -1, "Close means overlap");
+    
+    stats[1] = sample_stat(&rng, 15.0, 50);
+    stats[0] = sample_stat(&rng, 10.0, 50);
+    TEST_ASSERT(mc_separated_minimum(stats, 3) == 0, "Distinct means separate");
+    
+    stats[2] = sample_stat(&rng, 5.0, 50);
+    TEST_ASSERT(mc_separated_minimum(stats, 3) == 2, "Lowest mean wins wherever it is");
+    
+    // Identical constant results never separate
+    for (int i = 0; i < 2; i++) {
+        running_stat_init(&stats[i]);
+        for (int n = 0; n < 10; n++) {
+            running_stat_add(&stats[i], 90.0);
+        }
+    }
+    TEST_ASSERT(mc_separated_minimum(stats, 2) == -1, "Ties do not separate");
+    running_stat_init(&stats[0]);
+    TEST_ASSERT(mc_separated_minimum(stats, 2) == -1, "Empty stats do not separate");
+}
+
+
+// MAIN TEST RUNNER
+
+
+int main(void) {
+    printf("\n");
+    printf("========================================\n");
+    printf("   MONTE CARLO UNIT TESTS\n");
+    printf("========================================\n");
+    
+    // Run all tests
+    RUN_TEST(test_running_stat);
+    RUN_TEST(test_student_t);
+    RUN_TEST(test_interval_coverage);
+    RUN_TEST(test_separation);
+    
+    // Print summary
+    printf("\n");
+    printf("========================================\n");
+    printf("   TEST SUMMARY\n");
+    printf("========================================\n");
+    printf("Tests Passed: %d\n", tests_passed);
+    printf("Tests Failed: %d\n", tests_failed);
+    printf("Total Tests: %d\n", tests_passed + tests_failed);
+    printf("Success Rate: %.2f%%\n",
+           (tests_passed * 100.0) / (tests_passed + tests_failed));
+    printf("========================================\n\n");
+    
+    return (tests_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,297 @@
+#define _DEFAULT_SOURCE
+#include "../include/replay.h"
+#include "../include/scheduler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+
+// TEST COUNTER
+
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+
+// TEST HELPER MACROS
+
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            printf("[PASS] %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("[FAIL] %s\n", message); \
+            tests_failed++; \
+        } \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        printf("\n--- Running %s ---\n", #test_func); \
+        test_func(); \
+    } while(0)
+
+
+// TEST HELPERS
+
+
+static char csv_path[64];
+static char binary_path[64];
+
+// Write text to a file
+static void write_file(const char *path, const char *text) {
+    FILE *file = fopen(path, "w");
+    fputs(text, file);
+    fclose(file);
+}
+
+// Same task, field by field (names as far as the binary format keeps them)
+static bool same_spec(const TaskSpec *a, const TaskSpec *b) {
+    return a->arrival_ms == b->arrival_ms && a->priority == b->priority &&
+           a->energy_cost == b->energy_cost && a->burst_time == b->burst_time &&
+           a->is_critical == b->is_critical && a->deadline == b->deadline &&
+           strncmp(a->name, b->name, WORKLOAD_RECORD_NAME) == 0;
+}
+
+
+// FILE FORMAT TESTS
+
+
+// Test CSV parsing, including comments, bad lines and out-of-order arrivals
+void test_csv_parsing(void) {
+    write_file(csv_path,
+               "# recorded on a phone\n"
+               WORKLOAD_CSV_HEADER "\n"
+               "0,Sensor Poll,1,1,20,1,100\n"
+               "\n"
+               "5,Photo Upload,3,3,400,0,0\r\n"
+               "7,Bad Priority,4,1,20,0,0\n"
+               "8,Too Few Fields,2,2,20\n"
+               "9,Trailing Junk,2,2,20x,0,0\n"
+               "3,Late Entry,2,2,50,0,500\n");
+    
+    WorkloadReplay replay;
+    TaskSpec spec;
+    TEST_ASSERT(replay_open(&replay, csv_path) == SUCCESS, "CSV trace opened");
+    
+    TEST_ASSERT(replay_next(&replay, &spec), "First task read");
+    TEST_ASSERT(spec.arrival_ms == 0 && strcmp(spec.name, "Sensor Poll") == 0 &&
+                spec.priority == PRIORITY_HIGH && spec.energy_cost == ENERGY_LOW &&
+                spec.burst_time == 20 && spec.is_critical && spec.deadline == 100,
+                "Every field parsed");
+    
+    TEST_ASSERT(replay_next(&replay, &spec), "Comment, header and blank lines skipped");
+    TEST_ASSERT(strcmp(spec.name, "Photo Upload") == 0 && spec.deadline == 0,
+                "CRLF line endings accepted");
+    
+    TEST_ASSERT(replay_next(&replay, &spec) && strcmp(spec.name, "Late Entry") == 0,
+                "Malformed lines skipped");
+    TEST_ASSERT(spec.arrival_ms == 5, "Out-of-order task arrives with its predecessor");
+    TEST_ASSERT(!replay_next(&replay, &spec), "End of trace");
+    
+    TEST_ASSERT(replay.tasks == 3, "Three tasks read");
+    TEST_ASSERT(replay.errors == 3, "Three malformed lines counted");
+    TEST_ASSERT(replay.reordered == 1, "One reordered task counted");
+    replay_close(&replay);
+}
+
+// Test that both formats reproduce a generated workload exactly
+void test_round_trip(void) {
+    const char *paths[] = {csv_path, binary_path};
+    WorkloadConfig config;
+    workload_default_config(&config);
+    config.task_count = 5000;
+    
+    for (int format = 0; format < 2; format++) {
+        WorkloadGenerator gen;
+        WorkloadWriter writer;
+        TaskSpec spec;
+        workload_init(&gen, &config);
+        workload_writer_open(&writer, paths[format]);
+        TEST_ASSERT(writer.binary == (format == 1), "Format chosen from the file name");
+        while (workload_next(&gen, &spec)) {
+            workload_writer_write(&writer, &spec);
+        }
+        TEST_ASSERT(workload_writer_close(&writer) == SUCCESS && writer.count == 5000, "Trace written");
+    
+        WorkloadReplay replay;
+        TaskSpec replayed;
+        long matching = 0;
+        workload_init(&gen, &config);
+        TEST_ASSERT(replay_open(&replay, paths[format]) == SUCCESS, "Trace reopened");
+        TEST_ASSERT((replay.records != NULL) == (format == 1), "Format detected from the contents");
+        while (replay_next(&replay, &replayed) && workload_next(&gen, &spec)) {
+            matching += same_spec(&replayed, &spec);
+        }
+        TEST_ASSERT(matching == 5000 && replay.tasks == 5000, "Replay matches the generated tasks");
+        TEST_ASSERT(replay.errors == 0 && replay.reordered == 0, "No errors or reordering");
+        replay_close(&replay);
+    }
+}
+
+// Test that long names are cut to the record size and commas kept out of CSV
+void test_names(void) {
+    const char *paths[] = {csv_path, binary_path};
+    TaskSpec spec = {.arrival_ms = 0, .priority = PRIORITY_LOW, .energy_cost = ENERGY_LOW,
+                     .burst_time = 10, .is_critical = false, .deadline = 0};
+    snprintf(spec.name, sizeof(spec.name), "A, very long task name");
+    
+    for (int format = 0; format < 2; format++) {
+        WorkloadWriter writer;
+        WorkloadReplay replay;
+        TaskSpec replayed;
+        workload_writer_open(&writer, paths[format]);
+        workload_writer_write(&writer, &spec);
+        workload_writer_close(&writer);
+    
+        replay_open(&replay, paths[format]);
+        TEST_ASSERT(replay_next(&replay, &replayed), "Task with an awkward name read back");
+        if (format == 0) {
+            TEST_ASSERT(strcmp(replayed.name, "A  very long task name") == 0, "CSV name keeps its length");
+        } else {
+            TEST_ASSERT(strlen(replayed.name) == WORKLOAD_RECORD_NAME &&
+                        strncmp(replayed.name, spec.name, WORKLOAD_RECORD_NAME) == 0,
+                        "Binary name truncated to the record");
+        }
+        replay_close(&replay);
+    }
+}
+
+// Test that unreadable and damaged files are refused
+void test_invalid_files(void) {
+    WorkloadReplay replay;
+    TEST_ASSERT(replay_open(&replay, "/nonexistent/trace.bin") == ERROR, "Missing file refused");
+    
+    // A one-record binary trace, then damaged copies of it
+    WorkloadWriter writer;
+    TaskSpec spec = {.arrival_ms = 1, .name = "Task", .priority = PRIORITY_HIGH,
+                     .energy_cost = ENERGY_LOW, .burst_time = 10, .is_critical = false, .deadline = 0};
+    workload_writer_open(&writer, binary_path);
+    workload_writer_write(&writer, &spec);
+    workload_writer_close(&writer);
+    TEST_ASSERT(replay_open(&replay, binary_path) == SUCCESS && replay.count == 1, "Valid trace opens");
+    replay_close(&replay);
+    
+    FILE *file = fopen(binary_path, "r+b");
+    WorkloadFileHeader header;
+    fread(&header, sizeof(header), 1, file);
+    
+    header.count = 2;
+    fseek(file, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, file);
+    fflush(file);
+    TEST_ASSERT(replay_open(&replay, binary_path) == ERROR, "Truncated trace refused");
+    
+    header.count = 1;
+    header.version = WORKLOAD_FILE_VERSION + 1;
+    fseek(file, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, file);
+    fflush(file);
+    TEST_ASSERT(replay_open(&replay, binary_path) == ERROR, "Unknown version refused");
+    fclose(file);
+    
+    // Without the magic the file is read as CSV, and has no valid lines
+    write_file(csv_path, "not,a,workload\n");
+    TEST_ASSERT(replay_open(&replay, csv_path) == SUCCESS, "Text file opened as CSV");
+    TEST_ASSERT(!replay_next(&replay, &spec) && replay.errors == 1, "Text file yields no tasks");
+    replay_close(&replay);
+}
+
+
+// SCHEDULER REPLAY TESTS
+
+
+#define REPLAY_GAP_MS (2 * SCHEDULER_IDLE_TIMEOUT_MS)
+
+static long replay_start_ms;
+static int replay_finished;
+static int late_arrivals;
+
+// Done hook: the nth task to finish was recorded as arriving n gaps in
+static void check_arrival(Task *task, void *context) {
+    (void)context;
+    long arrived_ms = task->arrival_time_ns / NS_PER_MS - replay_start_ms;
+    late_arrivals += arrived_ms != ++replay_finished * REPLAY_GAP_MS;
+    remove_task(task->task_id);
+}
+
+// Test that a replayed trace enters the scheduler at its arrival times
+void test_scheduler_replay(void) {
+    // Tasks spread past the idle timeout, each finishing before the next
+    WorkloadWriter writer;
+    workload_writer_open(&writer, binary_path);
+    for (int i = 1; i <= 20; i++) {
+        TaskSpec spec = {.arrival_ms = i * REPLAY_GAP_MS, .name = "Replayed",
+                         .priority = PRIORITY_MEDIUM, .energy_cost = ENERGY_LOW,
+                         .burst_time = 50, .is_critical = false, .deadline = 0};
+        workload_writer_write(&writer, &spec);
+    }
+    workload_writer_close(&writer);
+    
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+    reset_virtual_clock();
+    scheduler_init(SCHEDULER_FCFS);
+    
+    WorkloadReplay replay;
+    WorkloadStream stream;
+    replay_open(&replay, binary_path);
+    replay_start_ms = get_current_time_ms();
+    workload_stream_start(&stream, replay_next, &replay);
+    set_task_done_hook(check_arrival, NULL);
+    replay_finished = 0;
+    late_arrivals = 0;
+    TEST_ASSERT(get_task_count() == 0, "Tasks are not created up front");
+    
+    scheduler_start();
+    scheduler_run_loop();
+    
+    TEST_ASSERT(stream.admitted == 20, "Every replayed task admitted");
+    TEST_ASSERT(get_scheduler_statistics()->tasks_completed == 20, "Every replayed task completes");
+    TEST_ASSERT(late_arrivals == 0, "Tasks arrive at their recorded times");
+    TEST_ASSERT(get_task_count() == 0, "Finished tasks are released");
+    
+    scheduler_cleanup();
+    replay_close(&replay);
+    set_clock_mode(CLOCK_MODE_WALL);
+}
+
+
+// MAIN TEST RUNNER
+
+
+int main(void) {
+    printf("\n");
+    printf("========================================\n");
+    printf("   WORKLOAD REPLAY UNIT TESTS\n");
+    printf("========================================\n");
+    
+    set_log_level(LOG_LEVEL_ERROR);
+    snprintf(csv_path, sizeof(csv_path), "/tmp/test_replay_%d.csv", (int)getpid());
+    snprintf(binary_path, sizeof(binary_path), "/tmp/test_replay_%d.bin", (int)getpid());
+    
+    // Run all tests
+    RUN_TEST(test_csv_parsing);
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_names);
+    RUN_TEST(test_invalid_files);
+    RUN_TEST(test_scheduler_replay);
+    
+    unlink(csv_path);
+    unlink(binary_path);
+    
+    // Print summary
+    printf("\n");
+    printf("========================================\n");
+    printf("   TEST SUMMARY\n");
+    printf("========================================\n");
+    printf("Tests Passed: %d\n", tests_passed);
+    printf("Tests Failed: %d\n", tests_failed);
+    printf("Total Tests: %d\n", tests_passed + tests_failed);
+    printf("Success Rate: %.2f%%\n",
+           (tests_passed * 100.0) / (tests_passed + tests_failed));
+    printf("========================================\n\n");
+    
+    return (tests_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -5,6 +5,8 @@
 #include "../include/utils.h"
 #include <stdio.h>
 #include <assert.h>
+#include <sys/time.h>
+#include <pthread.h>
 
 
 // TEST COUNTER
@@ -172,10 +174,351 @@ void test_battery_aware_scheduling(void) {
     // Battery-aware scheduler should prefer low-energy tasks
     Task *selected = select_next_task();
     TEST_ASSERT(selected != NULL, "Select task in power save mode");
+    TEST_ASSERT(selected == low_energy, "Power save mode prefers the low-energy task");
     
     scheduler_cleanup();
 }
 
+// Test the per-mode bucket search orders of the battery-aware run queue
+void test_battery_aware_modes(void) {
+    scheduler_init(SCHEDULER_BATTERY_AWARE);
+    
+    Task *background = create_task("Background", PRIORITY_LOW, ENERGY_LOW, 300, false, 8000);
+    Task *heavy = create_task("Heavy", PRIORITY_HIGH, ENERGY_HIGH, 300, false, 8000);
+    Task *watchdog = create_task("Watchdog", PRIORITY_MEDIUM, ENERGY_MEDIUM, 300, true, 8000);
+    admit_task_to_scheduler(background);
+    admit_task_to_scheduler(heavy);
+    admit_task_to_scheduler(watchdog);
+    
+    set_scheduler_mode(MODE_PERFORMANCE);
+    TEST_ASSERT(select_next_task() == heavy, "Performance mode picks highest priority");
+    
+    set_scheduler_mode(MODE_CRITICAL);
+    TEST_ASSERT(select_next_task() == watchdog, "Critical mode picks the critical task");
+    TEST_ASSERT(select_next_task() == NULL, "Critical mode skips non-critical tasks");
+    
+    set_scheduler_mode(MODE_POWER_SAVE);
+    TEST_ASSERT(select_next_task() == background, "Skipped task still queued");
+    
+    scheduler_cleanup();
+}
+
+// Test that SJF and Priority dispatch the best task, not the queue front
+void test_keyed_selection(void) {
+    scheduler_init(SCHEDULER_SJF);
+    
+    Task *long_task = create_task("Long", PRIORITY_LOW, ENERGY_LOW, 900, false, 8000);
+    Task *short_task = create_task("Short", PRIORITY_LOW, ENERGY_LOW, 100, false, 8000);
+    Task *urgent = create_task("Urgent", PRIORITY_HIGH, ENERGY_LOW, 500, false, 8000);
+    admit_task_to_scheduler(long_task);
+    admit_task_to_scheduler(short_task);
+    admit_task_to_scheduler(urgent);
+    
+    TEST_ASSERT(select_next_task() == short_task, "SJF selects the shortest task");
+    
+    // Switching algorithm re-keys the remaining tasks
+    set_scheduler_algorithm(SCHEDULER_PRIORITY);
+    TEST_ASSERT(select_next_task() == urgent, "Priority selects the highest priority task");
+    TEST_ASSERT(select_next_task() == long_task, "Remaining task dispatched last");
+    TEST_ASSERT(select_next_task() == NULL, "Selected tasks are removed from the queue");
+    
+    scheduler_cleanup();
+}
+
+// Test that EDF dispatches by absolute deadline
+void test_edf_selection(void) {
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+    reset_virtual_clock();
+    scheduler_init(SCHEDULER_EDF);
+    
+    Task *late = create_task("Late", PRIORITY_HIGH, ENERGY_LOW, 100, false, 9000);
+    Task *none = create_task("NoDeadline", PRIORITY_HIGH, ENERGY_LOW, 100, false, 0);
+    Task *soon = create_task("Soon", PRIORITY_LOW, ENERGY_LOW, 100, false, 3000);
+    advance_virtual_clock(1000);
+    Task *arrived = create_task("Arrived", PRIORITY_LOW, ENERGY_LOW, 100, false, 2500);
+    admit_task_to_scheduler(late);
+    admit_task_to_scheduler(none);
+    admit_task_to_scheduler(soon);
+    admit_task_to_scheduler(arrived);
+    
+    TEST_ASSERT(select_next_task() == soon, "EDF selects the earliest deadline");
+    TEST_ASSERT(select_next_task() == arrived, "Deadline counts from arrival");
+    TEST_ASSERT(select_next_task() == late, "Later deadline next");
+    TEST_ASSERT(select_next_task() == none, "Tasks without a deadline run last");
+    
+    scheduler_cleanup();
+    set_clock_mode(CLOCK_MODE_WALL);
+}
+
+// Test that energy-aware EDF sheds tasks it cannot finish or afford
+void test_energy_edf_sheds_tasks(void) {
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+    reset_virtual_clock();
+    scheduler_init(SCHEDULER_ENERGY_EDF);
+    
+    Task *hopeless = create_task("Hopeless", PRIORITY_HIGH, ENERGY_LOW, 800, false, 500);
+    Task *costly = create_task("Costly", PRIORITY_HIGH, ENERGY_HIGH, 1000, false, 4000);
+    Task *critical = create_task("Critical", PRIORITY_HIGH, ENERGY_HIGH, 1000, true, 6000);
+    Task *cheap = create_task("Cheap", PRIORITY_LOW, ENERGY_LOW, 200, false, 8000);
+    admit_task_to_scheduler(hopeless);
+    admit_task_to_scheduler(costly);
+    admit_task_to_scheduler(critical);
+    admit_task_to_scheduler(cheap);
+    
+    // 80% left: 70 points above the critical reserve, Costly needs 10 x 3 = 30
+    for (int i = 0; i < 20; i++) {
+        simulate_battery_drain(ENERGY_LOW);
+    }
+    TEST_ASSERT(select_next_task() == costly, "Affordable task runs in deadline order");
+    TEST_ASSERT(get_scheduler_statistics()->tasks_dropped == 1, "Unmeetable deadline dropped");
+    TEST_ASSERT(hopeless->state == TASK_STATE_DROPPED, "Dropped task no longer ready");
+    TEST_ASSERT(get_task_statistics()->suspended_tasks == 0, "Drop is not counted as a suspension");
+    
+    // Drain to 30%: 20 points left, Critical still runs but would not be affordable
+    while (get_battery_level() > 30) {
+        simulate_battery_drain(ENERGY_LOW);
+    }
+    TEST_ASSERT(select_next_task() == critical, "Critical task is never shed");
+    TEST_ASSERT(select_next_task() == cheap, "Cheap task fits the budget");
+    
+    Task *heavy = create_task("Heavy", PRIORITY_HIGH, ENERGY_HIGH, 1000, false, 9000);
+    admit_task_to_scheduler(heavy);
+    TEST_ASSERT(select_next_task() == NULL, "Unaffordable task deferred");
+    TEST_ASSERT(get_scheduler_statistics()->tasks_suspended == 1, "Deferred task suspended");
+    
+    // Once the battery can pay for it again the deferred task runs to completion
+    set_battery_level(100);
+    TEST_ASSERT(select_next_task() == heavy, "Deferred task resumes when affordable");
+    schedule_task(heavy);
+    while (heavy->remaining_time > 0) {
+        execute_task(heavy);
+    }
+    TEST_ASSERT(heavy->state == TASK_STATE_COMPLETED, "Deferred task completes");
+    
+    scheduler_cleanup();
+    set_clock_mode(CLOCK_MODE_WALL);
+}
+
+static int deferred_done;
+
+// Done hook: count tasks handed back, then release them
+static void count_deferred_done(Task *task, void *context) {
+    (void)context;
+    deferred_done += task->state == TASK_STATE_DROPPED;
+    remove_task(task->task_id);
+}
+
+// Test that a deferred task is dropped once its deadline can no longer be met
+void test_energy_edf_deferred_expiry(void) {
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+    reset_virtual_clock();
+    scheduler_init(SCHEDULER_ENERGY_EDF);
+    set_task_done_hook(count_deferred_done, NULL);
+    deferred_done = 0;
+    
+    set_battery_level(20);
+    admit_task_to_scheduler(create_task("Waiting", PRIORITY_HIGH, ENERGY_HIGH, 1000, false, 3000));
+    TEST_ASSERT(select_next_task() == NULL, "Unaffordable task deferred");
+    
+    advance_virtual_clock(1000);
+    TEST_ASSERT(select_next_task() == NULL && deferred_done == 0, "Deferred while the deadline is reachable");
+    advance_virtual_clock(1500);
+    TEST_ASSERT(select_next_task() == NULL && deferred_done == 1, "Dropped and handed to the done hook");
+    TEST_ASSERT(get_task_count() == 0, "Dropped deferred task leaves the pool");
+    
+    scheduler_cleanup();
+    set_clock_mode(CLOCK_MODE_WALL);
+}
+
+static long expired_dropped_at;
+
+// Done hook: note when the task with a deadline was dropped
+static void note_drop_time(Task *task, void *context) {
+    (void)context;
+    if (task->state == TASK_STATE_DROPPED && task->deadline > 0) {
+        expired_dropped_at = get_current_time_ms();
+    }
+}
+
+// Test that the run loop accounts for every task energy-aware EDF defers:
+// one is dropped when its deadline lapses, the rest when the loop gives up
+void test_energy_edf_run_accounts_all(void) {
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+    reset_virtual_clock();
+    scheduler_init(SCHEDULER_ENERGY_EDF);
+    set_task_done_hook(note_drop_time, NULL);
+    expired_dropped_at = -1;
+    
+    // 40% left: 30 points above the critical reserve
+    set_battery_level(40);
+    admit_task_to_scheduler(create_task("Cheap", PRIORITY_HIGH, ENERGY_LOW, 200, false, 5000));
+    admit_task_to_scheduler(create_task("Cheap", PRIORITY_HIGH, ENERGY_LOW, 200, false, 6000));
+    admit_task_to_scheduler(create_task("Expiring", PRIORITY_HIGH, ENERGY_HIGH, 1500, false, 2400));
+    admit_task_to_scheduler(create_task("Endless", PRIORITY_LOW, ENERGY_HIGH, 2000, false, 0));
+    
+    scheduler_start();
+    scheduler_run_loop();
+    scheduler_stop();
+    
+    // Missed deadlines are counted among the completed tasks
+    int completed = get_task_statistics()->completed_tasks;
+    int dropped = get_scheduler_statistics()->tasks_dropped;
+    TEST_ASSERT(completed + dropped == 4, "Every admitted task completes or is dropped");
+    TEST_ASSERT(dropped == 2, "Both unaffordable tasks dropped");
+    TEST_ASSERT(expired_dropped_at >= 900 && expired_dropped_at < 950,
+                "Loop wakes to drop a deferred task once its deadline lapses");
+    
+    scheduler_cleanup();
+    set_clock_mode(CLOCK_MODE_WALL);
+}
+
+// Run CFS decisions by hand and return how long each of two tasks ran
+static void run_cfs_rounds(Task *a, Task *b, int rounds, int *ran_a, int *ran_b) {
+    *ran_a = 0;
+    *ran_b = 0;
+    for (int i = 0; i < rounds; i++) {
+        Task *task = select_next_task();
+        if (task == NULL) {
+            break;
+        }
+        int before = task->remaining_time;
+        schedule_task(task);
+        execute_task(task);
+        if (task == a) {
+            *ran_a += before - task->remaining_time;
+        } else if (task == b) {
+            *ran_b += before - task->remaining_time;
+        }
+        if (task->remaining_time > 0) {
+            preempt_task(task);
+        }
+    }
+}
+
+// Test that CFS shares CPU time by priority weight over energy cost
+void test_cfs_weighted_fairness(void) {
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+    reset_virtual_clock();
+    scheduler_init(SCHEDULER_CFS);
+    
+    Task *frugal = create_task("Frugal", PRIORITY_MEDIUM, ENERGY_LOW, 100000, false, 0);
+    Task *hungry = create_task("Hungry", PRIORITY_MEDIUM, ENERGY_HIGH, 100000, false, 0);
+    admit_task_to_scheduler(frugal);
+    admit_task_to_scheduler(hungry);
+    
+    int ran_frugal, ran_hungry;
+    run_cfs_rounds(frugal, hungry, 40, &ran_frugal, &ran_hungry);
+    TEST_ASSERT(ran_frugal >= 2 * ran_hungry && ran_frugal <= 4 * ran_hungry,
+                "Low-energy task gets ~3x the CPU of a high-energy one");
+    scheduler_cleanup();
+    
+    reset_virtual_clock();
+    scheduler_init(SCHEDULER_CFS);
+    Task *high = create_task("High", PRIORITY_HIGH, ENERGY_MEDIUM, 100000, false, 0);
+    Task *low = create_task("Low", PRIORITY_LOW, ENERGY_MEDIUM, 100000, false, 0);
+    admit_task_to_scheduler(high);
+    admit_task_to_scheduler(low);
+    
+    int ran_high, ran_low;
+    run_cfs_rounds(high, low, 40, &ran_high, &ran_low);
+    TEST_ASSERT(ran_high >= 2 * ran_low && ran_high <= 4 * ran_low,
+                "High-priority task gets ~3x the CPU of a low-priority one");
+    
+    // A newcomer starts at the queue's vruntime instead of zero
+    Task *late = create_task("Late", PRIORITY_MEDIUM, ENERGY_MEDIUM, 1000, false, 0);
+    admit_task_to_scheduler(late);
+    TEST_ASSERT(late->vruntime > 0, "New task placed at the current minimum vruntime");
+    
+    // With many runnable tasks the slice is clamped to the minimum granularity
+    for (int i = 0; i < 20; i++) {
+        admit_task_to_scheduler(create_task("Crowd", PRIORITY_MEDIUM, ENERGY_MEDIUM, 1000, false, 0));
+    }
+    Task *next = select_next_task();
+    int before = next->remaining_time;
+    schedule_task(next);
+    execute_task(next);
+    TEST_ASSERT(before - next->remaining_time == get_scheduler_config()->min_granularity,
+                "Slices never drop below the minimum granularity");
+    
+    scheduler_cleanup();
+    set_clock_mode(CLOCK_MODE_WALL);
+}
+
+// Virtual time at which a low-priority task first runs behind a stream of
+// high-priority work, dispatching by hand so aging is the only variable
+static long low_task_dispatch_time(bool enable_aging, Task **low_out) {
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+    reset_virtual_clock();
+    scheduler_init(SCHEDULER_PRIORITY);
+    get_scheduler_config()->enable_aging = enable_aging;
+    get_scheduler_config()->aging_threshold = 500;
+    
+    Task *low = create_task("Low", PRIORITY_LOW, ENERGY_LOW, 100, false, 20000);
+    admit_task_to_scheduler(low);
+    for (int i = 0; i < 6; i++) {
+        admit_task_to_scheduler(create_task("High", PRIORITY_HIGH, ENERGY_LOW, 300, false, 20000));
+    }
+    
+    long dispatched_at = -1;
+    Task *task;
+    while ((task = select_next_task()) != NULL) {
+        if (task == low) {
+            dispatched_at = get_current_time_ms() - 1;  // Virtual clock starts at 1 ms
+            break;
+        }
+        schedule_task(task);
+        execute_task(task);
+        if (task->remaining_time > 0) {
+            preempt_task(task);
+        }
+    }
+    
+    *low_out = low;
+    return dispatched_at;
+}
+
+// Test that aging promotes a starving task past the threshold
+void test_aging_prevents_starvation(void) {
+    Task *low;
+    long starved = low_task_dispatch_time(false, &low);
+    TEST_ASSERT(starved >= 1800, "Without aging the low task waits for all high work");
+    scheduler_cleanup();
+    
+    long aged = low_task_dispatch_time(true, &low);
+    TEST_ASSERT(aged >= 1000 && aged < 1800, "Aged task runs once boosted to high priority");
+    TEST_ASSERT(get_scheduler_statistics()->aging_promotions == 2, "Promoted one level per threshold");
+    TEST_ASSERT(low->priority == PRIORITY_LOW, "Boost dropped once the task is dispatched");
+    TEST_ASSERT(!timer_is_armed(&low->aging_timer), "Dispatched task stops aging");
+    scheduler_cleanup();
+    set_clock_mode(CLOCK_MODE_WALL);
+}
+
+// Test that an algorithm switch cancels or re-arms ready tasks' aging timers
+void test_aging_follows_algorithm(void) {
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+    reset_virtual_clock();
+    scheduler_init(SCHEDULER_PRIORITY);
+    get_scheduler_config()->aging_threshold = 500;
+    
+    Task *low = create_task("Low", PRIORITY_LOW, ENERGY_LOW, 100, false, 20000);
+    admit_task_to_scheduler(low);
+    TEST_ASSERT(timer_is_armed(&low->aging_timer), "Priority scheduling ages the task");
+    
+    set_scheduler_algorithm(SCHEDULER_SJF);
+    TEST_ASSERT(!timer_is_armed(&low->aging_timer), "Switch to SJF cancels the timer");
+    advance_virtual_clock(2000);
+    select_next_task();
+    TEST_ASSERT(get_scheduler_statistics()->aging_promotions == 0, "No boost under SJF");
+    
+    admit_task_to_scheduler(low);
+    set_scheduler_algorithm(SCHEDULER_FCFS);
+    set_scheduler_algorithm(SCHEDULER_BATTERY_AWARE);
+    TEST_ASSERT(timer_is_armed(&low->aging_timer), "Switch to battery-aware re-arms it");
+    
+    scheduler_cleanup();
+    set_clock_mode(CLOCK_MODE_WALL);
+}
+
 // Test preemption
 void test_preemption(void) {
     scheduler_init(SCHEDULER_BATTERY_AWARE);
@@ -211,6 +554,43 @@ void test_suspend_resume(void) {
     scheduler_cleanup();
 }
 
+// Test that removing a queued task unlinks it before its slot is reused
+void test_remove_queued_task(void) {
+    const SchedulerAlgorithm algorithms[] = {
+        SCHEDULER_FCFS, SCHEDULER_SJF, SCHEDULER_BATTERY_AWARE
+    };
+    bool all_unlinked = true;
+    
+    for (int i = 0; i < 3; i++) {
+        scheduler_init(algorithms[i]);
+        TimerWheel *wheel = &sched_default_context()->state.aging_wheel;
+        
+        Task *gone = create_task("Gone", PRIORITY_LOW, ENERGY_LOW, 100, false, 5000);
+        Task *kept = create_task("Kept", PRIORITY_LOW, ENERGY_LOW, 200, false, 5000);
+        admit_task_to_scheduler(gone);
+        admit_task_to_scheduler(kept);
+        remove_task(gone->task_id);
+        
+        // The new task takes the removed task's slot but was never admitted
+        Task *reused = create_task("Reused", PRIORITY_HIGH, ENERGY_LOW, 50, false, 5000);
+        all_unlinked &= reused == gone;
+        all_unlinked &= select_next_task() == kept;
+        all_unlinked &= select_next_task() == NULL;
+        all_unlinked &= wheel->count == 0;
+        
+        scheduler_cleanup();
+    }
+    TEST_ASSERT(all_unlinked, "Removed task leaves FIFO, heap, run queue and aging wheel");
+    
+    scheduler_init(SCHEDULER_FCFS);
+    Task *suspended = create_task("Suspended", PRIORITY_LOW, ENERGY_LOW, 100, false, 5000);
+    suspend_task(suspended);
+    remove_task(suspended->task_id);
+    TEST_ASSERT(get_queue_size(sched_default_context()->state.waiting_queue) == 0,
+                "Removed task leaves the waiting queue");
+    scheduler_cleanup();
+}
+
 // Test scheduler statistics
 void test_scheduler_statistics(void) {
     scheduler_init(SCHEDULER_BATTERY_AWARE);
@@ -256,6 +636,367 @@ void test_context_switching(void) {
     
     scheduler_cleanup();
 }
+// Test that re-running the same task is not counted as a context switch
+void test_same_task_no_context_switch(void) {
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+    scheduler_init(SCHEDULER_ROUND_ROBIN);
+    
+    // A single task needing three quanta runs back-to-back on its own
+    admit_task_to_scheduler(create_task("Solo", PRIORITY_HIGH, ENERGY_LOW, 300, false, 5000));
+    scheduler_start();
+    scheduler_run_loop();
+    
+    SchedulerStats *stats = get_scheduler_statistics();
+    TEST_ASSERT(stats->tasks_completed == 1, "Solo task completed");
+    TEST_ASSERT(stats->context_switches == 1, "Only the initial dispatch is a context switch");
+    
+    scheduler_cleanup();
+    set_clock_mode(CLOCK_MODE_WALL);
+}
+
+// Outcome of one scheduler run, used to compare clock modes
+typedef struct {
+    SchedulerStats sched;
+    int completed_tasks;
+    int missed_deadlines;
+    int final_battery;
+    long elapsed_ms;
+} RunOutcome;
+
+// Real elapsed time, independent of the scheduler clock
+static long wall_time_ms(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (tv.tv_sec * 1000) + (tv.tv_usec / 1000);
+}
+
+// Run a small mixed workload to completion under the given clock
+static RunOutcome run_workload(SchedulerAlgorithm algorithm, ClockMode clock) {
+    RunOutcome outcome;
+    
+    set_clock_mode(clock);
+    reset_virtual_clock();
+    scheduler_init(algorithm);
+    
+    admit_task_to_scheduler(create_task("A", PRIORITY_LOW, ENERGY_HIGH, 150, false, 5000));
+    admit_task_to_scheduler(create_task("B", PRIORITY_HIGH, ENERGY_LOW, 30, true, 5000));
+    admit_task_to_scheduler(create_task("C", PRIORITY_MEDIUM, ENERGY_MEDIUM, 20, false, 5000));
+    
+    long start = wall_time_ms();
+    scheduler_start();
+    scheduler_run_loop();
+    scheduler_stop();
+    outcome.elapsed_ms = wall_time_ms() - start;
+    
+    outcome.sched = *get_scheduler_statistics();
+    outcome.completed_tasks = get_task_statistics()->completed_tasks;
+    outcome.missed_deadlines = get_task_statistics()->missed_deadlines;
+    outcome.final_battery = get_battery_level();
+    
+    scheduler_cleanup();
+    set_clock_mode(CLOCK_MODE_WALL);
+    return outcome;
+}
+
+// Test that the virtual clock advances instantly by the executed time
+void test_virtual_clock_execution(void) {
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+    reset_virtual_clock();
+    scheduler_init(SCHEDULER_ROUND_ROBIN);
+    
+    admit_task_to_scheduler(create_task("Long", PRIORITY_HIGH, ENERGY_LOW, 250, false, 5000));
+    admit_task_to_scheduler(create_task("Short", PRIORITY_HIGH, ENERGY_LOW, 150, false, 5000));
+    
+    long virtual_start = get_current_time_ms();
+    long wall_start = wall_time_ms();
+    scheduler_start();
+    scheduler_run_loop();
+    
+    long virtual_elapsed = get_current_time_ms() - virtual_start;
+    long wall_elapsed = wall_time_ms() - wall_start;
+    
+    TEST_ASSERT(get_scheduler_statistics()->tasks_completed == 2, "Virtual run completes all tasks");
+    TEST_ASSERT(virtual_elapsed >= 400, "Virtual clock covers all execution time");
+    TEST_ASSERT(wall_elapsed < 400, "Virtual run does not sleep in real time");
+    
+    scheduler_cleanup();
+    set_clock_mode(CLOCK_MODE_WALL);
+}
+
+// Test that virtual and wall-clock runs produce the same schedule
+void test_virtual_matches_wall_clock(void) {
+    RunOutcome wall = run_workload(SCHEDULER_ROUND_ROBIN, CLOCK_MODE_WALL);
+    RunOutcome virt = run_workload(SCHEDULER_ROUND_ROBIN, CLOCK_MODE_VIRTUAL);
+    
+    TEST_ASSERT(wall.sched.tasks_completed == virt.sched.tasks_completed, "Same tasks completed");
+    TEST_ASSERT(wall.sched.context_switches == virt.sched.context_switches, "Same context switches");
+    TEST_ASSERT(wall.sched.total_energy_consumed == virt.sched.total_energy_consumed, 
+                "Same energy consumed");
+    TEST_ASSERT(wall.completed_tasks == virt.completed_tasks, "Same task statistics");
+    TEST_ASSERT(wall.missed_deadlines == virt.missed_deadlines, "Same missed deadlines");
+    TEST_ASSERT(wall.final_battery == virt.final_battery, "Same final battery level");
+    TEST_ASSERT(virt.elapsed_ms < wall.elapsed_ms, "Virtual run is faster than wall clock");
+}
+
+// Test that an idle loop blocks once for the whole idle timeout
+void test_idle_loop_blocks(void) {
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+    reset_virtual_clock();
+    scheduler_init(SCHEDULER_FCFS);
+    
+    long virtual_start = get_current_time_ms();
+    scheduler_start();
+    scheduler_run_loop();
+    
+    TEST_ASSERT(get_current_time_ms() - virtual_start >= SCHEDULER_IDLE_TIMEOUT_MS, 
+                "Idle loop exits after the idle timeout");
+    TEST_ASSERT(get_scheduler_statistics()->idle_wakeups == 1, "Idle loop wakes up only once");
+    
+    scheduler_cleanup();
+    set_clock_mode(CLOCK_MODE_WALL);
+}
+
+// Run the scheduler loop on its own thread
+static void* run_loop_thread(void *arg) {
+    (void)arg;
+    scheduler_run_loop();
+    return NULL;
+}
+
+// Test that admitting a task from another thread wakes a blocked loop
+void test_admission_wakes_idle_loop(void) {
+    scheduler_init(SCHEDULER_FCFS);
+    scheduler_start();
+    
+    pthread_t loop;
+    pthread_create(&loop, NULL, run_loop_thread, NULL);
+    sleep_ms(200);  // Let the loop go idle
+    
+    scheduler_lock();
+    Task *task = create_task("Wake", PRIORITY_HIGH, ENERGY_LOW, 10, false, 5000);
+    int64_t admitted_at = get_time_ns();
+    admit_task_to_scheduler(task);
+    scheduler_unlock();
+    
+    sleep_ms(100);
+    scheduler_lock();
+    int64_t started_at = task->start_time_ns;
+    long stop_at = wall_time_ms();
+    scheduler_stop();
+    scheduler_unlock();
+    pthread_join(loop, NULL);
+    
+    TEST_ASSERT(started_at >= admitted_at && started_at - admitted_at < 50 * NS_PER_MS, 
+                "Admitted task starts without waiting for a poll interval");
+    TEST_ASSERT(wall_time_ms() - stop_at < SCHEDULER_IDLE_TIMEOUT_MS / 2, 
+                "Stop wakes the idle loop");
+    
+    scheduler_cleanup();
+}
+
+// Test that the run loop releases the scheduler lock while a task runs, so
+// an admission does not wait for the current slice to finish
+void test_lock_free_during_slice(void) {
+    scheduler_init(SCHEDULER_FCFS);
+    scheduler_start();
+    admit_task_to_scheduler(create_task("Long", PRIORITY_HIGH, ENERGY_LOW, 400, false, 5000));
+    
+    pthread_t loop;
+    pthread_create(&loop, NULL, run_loop_thread, NULL);
+    sleep_ms(50);  // Inside the first 100 ms slice
+    
+    int64_t asked_at = get_time_ns();
+    scheduler_lock();
+    int64_t locked_at = get_time_ns();
+    Task *task = create_task("Short", PRIORITY_HIGH, ENERGY_LOW, 10, false, 5000);
+    admit_task_to_scheduler(task);
+    scheduler_unlock();
+    
+    sleep_ms(500);
+    scheduler_lock();
+    scheduler_stop();
+    scheduler_unlock();
+    pthread_join(loop, NULL);
+    
+    TEST_ASSERT(locked_at - asked_at < 20 * NS_PER_MS, "Lock available while a task runs");
+    TEST_ASSERT(task->state == TASK_STATE_COMPLETED, "Task admitted mid-slice completes");
+    
+    scheduler_cleanup();
+}
+
+// Arrival times (ms after the start) fed by the test arrival source; the
+// last one is due well after the idle timeout
+static const long arrival_offsets[] = {0, 50, 3 * SCHEDULER_IDLE_TIMEOUT_MS};
+static int arrivals_admitted;
+static long arrivals_start_ms;
+static int tasks_done;
+static int64_t max_start_delay_ns;
+
+// Arrival source: admit every task whose arrival time has passed
+static long admit_arrivals(long now_ms, void *context) {
+    (void)context;
+    while (arrivals_admitted < 3) {
+        long due = arrivals_start_ms + arrival_offsets[arrivals_admitted];
+        if (due > now_ms) {
+            return due;
+        }
+        admit_task_to_scheduler(create_task("Arrival", PRIORITY_MEDIUM, ENERGY_LOW, 30, false, 5000));
+        arrivals_admitted++;
+    }
+    return -1;
+}
+
+// Done hook: note how long the task waited to start, then release it
+static void release_done_task(Task *task, void *context) {
+    (void)context;
+    tasks_done++;
+    max_start_delay_ns = max(max_start_delay_ns, task->start_time_ns - task->arrival_time_ns);
+    remove_task(task->task_id);
+}
+
+// Test that the run loop admits tasks from an arrival source as they arrive
+// and hands finished tasks to the done hook
+void test_arrival_source(void) {
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+    reset_virtual_clock();
+    scheduler_init(SCHEDULER_FCFS);
+    
+    arrivals_admitted = 0;
+    tasks_done = 0;
+    max_start_delay_ns = 0;
+    arrivals_start_ms = get_current_time_ms();
+    set_arrival_source(admit_arrivals, NULL);
+    set_task_done_hook(release_done_task, NULL);
+    scheduler_start();
+    scheduler_run_loop();
+    
+    TEST_ASSERT(arrivals_admitted == 3, "Pending arrivals keep the idle loop alive");
+    TEST_ASSERT(tasks_done == 3, "Done hook sees every completed task");
+    TEST_ASSERT(max_start_delay_ns == 0, "Tasks start at their arrival time");
+    TEST_ASSERT(get_task_count() == 0, "Done hook may remove finished tasks");
+    TEST_ASSERT(get_scheduler_statistics()->dispatches == 3, "One decision per single-quantum task");
+    TEST_ASSERT(get_scheduler_memory_usage() >= get_task_memory_usage(), 
+                "Memory usage includes the task pool");
+    
+    scheduler_cleanup();
+    set_clock_mode(CLOCK_MODE_WALL);
+}
+
+// Test run-loop phase timings: one sample per phase per dispatch when built
+// with SCHED_PROFILE, none otherwise
+void test_phase_timings(void) {
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+    reset_virtual_clock();
+    scheduler_init(SCHEDULER_ROUND_ROBIN);
+    
+    admit_task_to_scheduler(create_task("A", PRIORITY_HIGH, ENERGY_LOW, 250, false, 5000));
+    admit_task_to_scheduler(create_task("B", PRIORITY_LOW, ENERGY_HIGH, 150, false, 5000));
+    scheduler_start();
+    scheduler_run_loop();
+    
+    SchedulerStats *stats = get_scheduler_statistics();
+    uint64_t dispatches = stats->phase_ns[SCHED_PHASE_EXECUTE].total;
+    if (SCHED_PROFILE) {
+        TEST_ASSERT(dispatches >= 4, "Every dispatch timed");  // 250 + 150 ms in 100 ms quanta
+        TEST_ASSERT(stats->phase_ns[SCHED_PHASE_DECISION].total == dispatches,
+                    "One decision sample per dispatch");
+        TEST_ASSERT(stats->phase_ns[SCHED_PHASE_SELECT].total >= dispatches,
+                    "Every selection timed");
+        TEST_ASSERT(stats->phase_ns[SCHED_PHASE_SWITCH].total == (uint64_t)stats->context_switches,
+                    "One switch sample per context switch");
+    } else {
+        bool empty = true;
+        for (int phase = 0; phase < NUM_SCHED_PHASES; phase++) {
+            empty = empty && stats->phase_ns[phase].total == 0;
+        }
+        TEST_ASSERT(empty, "No phase timing without SCHED_PROFILE");
+    }
+    
+    scheduler_cleanup();
+    set_clock_mode(CLOCK_MODE_WALL);
+}
+
+// Outcome of one run on its own scheduler context
+typedef struct {
+    SchedContext *ctx;
+    SchedulerAlgorithm algorithm;
+    SchedulerStats sched;
+    int completed_tasks;
+    int final_battery;
+    long elapsed_ms;                // On the context's own clock
+} ContextRun;
+
+// Run a fixed mixed workload to the end on the run's context
+static void* run_context_workload(void *arg) {
+    ContextRun *run = (ContextRun*)arg;
+    SchedContext *ctx = run->ctx;
+    
+    scheduler_init_ctx(ctx, run->algorithm);
+    for (int i = 0; i < 24; i++) {
+        Task *task = create_task_ctx(ctx, "Context", PRIORITY_HIGH + i % 3, ENERGY_LOW + i % 3,
+                                     50 + 40 * (i % 5), i % 7 == 0, 2000 + 100 * i);
+        admit_task_to_scheduler_ctx(ctx, task);
+    }
+    
+    long start = sim_clock_ms(ctx->clock);
+    scheduler_start_ctx(ctx);
+    scheduler_run_loop_ctx(ctx);
+    run->elapsed_ms = sim_clock_ms(ctx->clock) - start;
+    run->sched = *get_scheduler_statistics_ctx(ctx);
+    run->completed_tasks = get_task_statistics_ctx(ctx)->completed_tasks;
+    run->final_battery = get_battery_level_ctx(ctx);
+    return NULL;
+}
+
+// Same outcome from two runs
+static bool same_context_run(const ContextRun *a, const ContextRun *b) {
+    return a->sched.tasks_completed == b->sched.tasks_completed &&
+           a->sched.context_switches == b->sched.context_switches &&
+           a->sched.total_energy_consumed == b->sched.total_energy_consumed &&
+           a->sched.aging_promotions == b->sched.aging_promotions &&
+           a->completed_tasks == b->completed_tasks &&
+           a->final_battery == b->final_battery && a->elapsed_ms == b->elapsed_ms;
+}
+
+// Test that contexts run side by side on separate threads give the same
+// results as one after the other, and leave the default context alone
+void test_concurrent_contexts(void) {
+    SchedulerAlgorithm algorithms[2] = {SCHEDULER_BATTERY_AWARE, SCHEDULER_CFS};
+    ContextRun sequential[2];
+    ContextRun concurrent[2];
+    pthread_t threads[2];
+    
+    for (int i = 0; i < 2; i++) {
+        sequential[i] = (ContextRun){.ctx = sched_context_create(CLOCK_MODE_VIRTUAL),
+                                     .algorithm = algorithms[i]};
+        run_context_workload(&sequential[i]);
+        sched_context_destroy(sequential[i].ctx);
+    }
+    
+    for (int i = 0; i < 2; i++) {
+        concurrent[i] = (ContextRun){.ctx = sched_context_create(CLOCK_MODE_VIRTUAL),
+                                     .algorithm = algorithms[i]};
+        pthread_create(&threads[i], NULL, run_context_workload, &concurrent[i]);
+    }
+    for (int i = 0; i < 2; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    
+    TEST_ASSERT(sequential[0].sched.tasks_completed > 0 && sequential[1].sched.tasks_completed > 0,
+                "Every context runs its workload");
+    TEST_ASSERT(!same_context_run(&sequential[0], &sequential[1]),
+                "Each context keeps its own algorithm");
+    TEST_ASSERT(same_context_run(&concurrent[0], &sequential[0]) &&
+                same_context_run(&concurrent[1], &sequential[1]),
+                "Concurrent contexts match sequential runs");
+    TEST_ASSERT(get_scheduler_config() == NULL && get_task_count() == 0,
+                "Default context untouched");
+    TEST_ASSERT(get_clock_mode() == CLOCK_MODE_WALL, "Global clock untouched");
+    
+    for (int i = 0; i < 2; i++) {
+        sched_context_destroy(concurrent[i].ctx);
+    }
+}
 
 
 // MAIN TEST RUNNER
@@ -275,11 +1016,30 @@ int main(void) {
     RUN_TEST(test_task_admission);
     RUN_TEST(test_task_scheduling);
     RUN_TEST(test_battery_aware_scheduling);
+    RUN_TEST(test_battery_aware_modes);
+    RUN_TEST(test_keyed_selection);
+    RUN_TEST(test_aging_prevents_starvation);
+    RUN_TEST(test_aging_follows_algorithm);
+    RUN_TEST(test_edf_selection);
+    RUN_TEST(test_energy_edf_sheds_tasks);
+    RUN_TEST(test_energy_edf_deferred_expiry);
+    RUN_TEST(test_energy_edf_run_accounts_all);
+    RUN_TEST(test_cfs_weighted_fairness);
     RUN_TEST(test_preemption);
     RUN_TEST(test_suspend_resume);
+    RUN_TEST(test_remove_queued_task);
     RUN_TEST(test_scheduler_statistics);
     RUN_TEST(test_time_quantum);
     RUN_TEST(test_context_switching);
+    RUN_TEST(test_same_task_no_context_switch);
+    RUN_TEST(test_virtual_clock_execution);
+    RUN_TEST(test_virtual_matches_wall_clock);
+    RUN_TEST(test_idle_loop_blocks);
+    RUN_TEST(test_admission_wakes_idle_loop);
+    RUN_TEST(test_lock_free_during_slice);
+    RUN_TEST(test_arrival_source);
+    RUN_TEST(test_phase_timings);
+    RUN_TEST(test_concurrent_contexts);
     
     // Print summary
     printf("\n");
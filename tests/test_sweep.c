@@ -0,0 +1,275 @@
+#define _DEFAULT_SOURCE
+#include "../include/sweep.h"
+#include "../include/battery_monitor.h"
+#include "../include/task_manager.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+
+// TEST COUNTER
+
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+
+// TEST HELPER MACROS
+
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            printf("[PASS] %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("[FAIL] %s\n", message); \
+            tests_failed++; \
+        } \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        printf("\n--- Running %s ---\n", #test_func); \
+        test_func(); \
+    } while(0)
+
+
+// TEST HELPERS
+
+
+static SweepSpec spec;
+static char results_path[64];
+
+// Run a fixed mixed workload under one sweep point
+static void run_point(int index, void *context) {
+    SweepPoint *point = &((SweepPoint*)context)[index];
+    SchedContext *ctx = sched_context_create(CLOCK_MODE_VIRTUAL);
+    
+    scheduler_init_ctx(ctx, (SchedulerAlgorithm)point->params[SWEEP_ALGORITHM]);
+    sweep_apply(ctx, point);
+    for (int i = 0; i < 12; i++) {
+        Task *task = create_task_ctx(ctx, "Sweep", PRIORITY_HIGH + i % 3, ENERGY_LOW + i % 3,
+                                     100 + 50 * (i % 4), i % 5 == 0, 3000 + 200 * i);
+        admit_task_to_scheduler_ctx(ctx, task);
+    }
+    scheduler_start_ctx(ctx);
+    scheduler_run_loop_ctx(ctx);
+    sweep_record(ctx, point);
+    sched_context_destroy(ctx);
+}
+
+// Count the lines of a file
+static int count_lines(const char *path) {
+    FILE *file = fopen(path, "r");
+    int lines = 0;
+    int c;
+    while (file != NULL && (c = fgetc(file)) != EOF) {
+        lines += c == '\n';
+    }
+    if (file != NULL) {
+        fclose(file);
+    }
+    return lines;
+}
+
+
+// SPEC TESTS
+
+
+// Test that parameters left out keep their defaults
+void test_parse_defaults(void) {
+    TEST_ASSERT(sweep_parse(&spec, "") == SUCCESS, "Empty spec accepted");
+    TEST_ASSERT(spec.counts[SWEEP_ALGORITHM] == 1 &&
+                spec.values[SWEEP_ALGORITHM][0] == SCHEDULER_BATTERY_AWARE,
+                "Battery-aware by default");
+    TEST_ASSERT(spec.values[SWEEP_CRITICAL][0] == BATTERY_CRITICAL &&
+                spec.values[SWEEP_HIGH][0] == BATTERY_HIGH, "Default battery thresholds");
+    TEST_ASSERT(spec.values[SWEEP_QUANTUM][0] == DEFAULT_TIME_QUANTUM_MS &&
+                spec.values[SWEEP_AGING][0] == DEFAULT_AGING_THRESHOLD_MS &&
+                spec.values[SWEEP_PREEMPTION][0] == 1, "Default scheduler configuration");
+    TEST_ASSERT(spec.samples == 0, "Full grid by default");
+}
+
+// Test numbers, ranges, steps and algorithm names
+void test_parse_values(void) {
+    int result = sweep_parse(&spec, "algorithm=fcfs,cfs,4; critical=5:15:5 low=20:22;"
+                                    "quantum=50,100:300:100; preemption=0,1");
+    TEST_ASSERT(result == SUCCESS, "Spec parsed");
+    TEST_ASSERT(spec.counts[SWEEP_ALGORITHM] == 3 &&
+                spec.values[SWEEP_ALGORITHM][0] == SCHEDULER_FCFS &&
+                spec.values[SWEEP_ALGORITHM][1] == SCHEDULER_CFS &&
+                spec.values[SWEEP_ALGORITHM][2] == SCHEDULER_BATTERY_AWARE,
+                "Algorithms by name or number");
+    TEST_ASSERT(spec.counts[SWEEP_CRITICAL] == 3 && spec.values[SWEEP_CRITICAL][2] == 15,
+                "Range with a step");
+    TEST_ASSERT(spec.counts[SWEEP_LOW] == 3 && spec.values[SWEEP_LOW][1] == 21,
+                "Range of every integer");
+    TEST_ASSERT(spec.counts[SWEEP_QUANTUM] == 4 && spec.values[SWEEP_QUANTUM][3] == 300,
+                "Numbers and ranges mixed");
+    TEST_ASSERT(spec.counts[SWEEP_MEDIUM] == 1, "Unlisted parameter keeps one value");
+}
+
+// Test that malformed specs are refused
+void test_parse_errors(void) {
+    TEST_ASSERT(sweep_parse(&spec, "voltage=5") == ERROR, "Unknown parameter refused");
+    TEST_ASSERT(sweep_parse(&spec, "critical") == ERROR, "Missing values refused");
+    TEST_ASSERT(sweep_parse(&spec, "critical=101") == ERROR, "Out-of-range value refused");
+    TEST_ASSERT(sweep_parse(&spec, "quantum=200:100") == ERROR, "Backwards range refused");
+    TEST_ASSERT(sweep_parse(&spec, "quantum=10x") == ERROR, "Trailing junk refused");
+    TEST_ASSERT(sweep_parse(&spec, "algorithm=lottery") == ERROR, "Unknown algorithm refused");
+    TEST_ASSERT(sweep_parse(&spec, "low=20; low=30") == ERROR, "Repeated parameter refused");
+    TEST_ASSERT(sweep_parse(&spec, "aging=1:2000") == ERROR, "Too many values refused");
+}
+
+
+// EXPANSION TESTS
+
+
+// Test the grid, including skipped threshold orders
+void test_grid_expansion(void) {
+    long count = 0;
+    sweep_parse(&spec, "algorithm=fcfs,sjf; critical=10,30; quantum=50,100,200");
+    SweepPoint *points = sweep_expand(&spec, &count);
+    TEST_ASSERT(points != NULL && count == 6, "critical=30 >= low=25 skipped");
+    
+    bool all_valid = true;
+    for (long i = 0; i < count; i++) {
+        all_valid &= points[i].params[SWEEP_CRITICAL] == 10;
+    }
+    TEST_ASSERT(all_valid, "Only increasing thresholds kept");
+    TEST_ASSERT(points[0].params[SWEEP_QUANTUM] == 50 && points[1].params[SWEEP_QUANTUM] == 100 &&
+                points[3].params[SWEEP_ALGORITHM] == SCHEDULER_SJF,
+                "Last parameter varies fastest");
+    free(points);
+    
+    sweep_parse(&spec, "critical=30");
+    TEST_ASSERT(sweep_expand(&spec, &count) == NULL, "Sweep with no valid point refused");
+    sweep_parse(&spec, "critical=0:9; low=11:20; medium=26:49; quantum=1:256; aging=1:256");
+    TEST_ASSERT(sweep_expand(&spec, &count) == NULL, "Oversized grid refused");
+}
+
+// Test that random samples are reproducible and drawn from the values
+void test_random_samples(void) {
+    long count = 0, again = 0;
+    sweep_parse(&spec, "samples=500; seed=9; critical=0:50; low=10:60; quantum=10:200:10");
+    SweepPoint *points = sweep_expand(&spec, &count);
+    SweepPoint *repeat = sweep_expand(&spec, &again);
+    TEST_ASSERT(count == 500 && again == 500, "Requested number of samples");
+    TEST_ASSERT(memcmp(points, repeat, sizeof(SweepPoint) * count) == 0, "Same seed, same sample");
+    
+    bool in_range = true;
+    for (long i = 0; i < count; i++) {
+        const int *p = points[i].params;
+        in_range &= p[SWEEP_CRITICAL] < p[SWEEP_LOW] && p[SWEEP_LOW] < p[SWEEP_MEDIUM] &&
+                    p[SWEEP_QUANTUM] % 10 == 0 && p[SWEEP_QUANTUM] <= 200;
+    }
+    TEST_ASSERT(in_range, "Samples valid and on the listed values");
+    free(points);
+    free(repeat);
+}
+
+
+// RUN TESTS
+
+
+// Test that a point reconfigures its context
+void test_apply(void) {
+    SweepPoint point = {.params = {SCHEDULER_ROUND_ROBIN, 5, 20, 40, 80, 250, 700, 0}};
+    SchedContext *ctx = sched_context_create(CLOCK_MODE_VIRTUAL);
+    scheduler_init_ctx(ctx, SCHEDULER_ROUND_ROBIN);
+    sweep_apply(ctx, &point);
+    
+    SchedulerConfig *config = get_scheduler_config_ctx(ctx);
+    TEST_ASSERT(config->time_quantum == 250 && config->aging_threshold == 700 &&
+                !config->enable_preemption, "Scheduler configuration applied");
+    TEST_ASSERT(get_battery_thresholds_ctx(ctx)->low_threshold == 20, "Battery thresholds applied");
+    TEST_ASSERT(determine_scheduler_mode_ctx(ctx, 22) == MODE_BALANCED &&
+                determine_scheduler_mode(22) == MODE_POWER_SAVE,
+                "Mode follows the context's thresholds");
+    sched_context_destroy(ctx);
+}
+
+// Test that every task completes without preemption, with fewer switches
+void test_without_preemption(void) {
+    SweepPoint points[2] = {
+        {.params = {SCHEDULER_ROUND_ROBIN, 0, 1, 2, 3, 100, 5000, 1}},
+        {.params = {SCHEDULER_ROUND_ROBIN, 0, 1, 2, 3, 100, 5000, 0}}
+    };
+    run_parallel(run_point, 2, points, 1);
+    TEST_ASSERT(points[0].tasks_completed == 12 && points[1].tasks_completed == 12,
+                "Every task completes either way");
+    TEST_ASSERT(points[1].context_switches == 12 &&
+                points[1].context_switches < points[0].context_switches,
+                "Tasks run to completion once dispatched");
+}
+
+// Test that a sweep gives the same results on one thread or several
+void test_parallel_sweep(void) {
+    long count = 0;
+    sweep_parse(&spec, "algorithm=battery,eedf,cfs,rr; critical=5,10; quantum=50,150; preemption=0,1");
+    SweepPoint *sequential = sweep_expand(&spec, &count);
+    SweepPoint *parallel = sweep_expand(&spec, &count);
+    TEST_ASSERT(count == 32, "32 configurations");
+    
+    run_parallel(run_point, (int)count, sequential, 1);
+    run_parallel(run_point, (int)count, parallel, 4);
+    TEST_ASSERT(memcmp(sequential, parallel, sizeof(SweepPoint) * count) == 0,
+                "Parallel sweep matches sequential");
+    
+    bool differ = false;
+    for (long i = 1; i < count; i++) {
+        differ |= sequential[i].energy_consumed != sequential[0].energy_consumed;
+    }
+    TEST_ASSERT(differ, "Configurations change the outcome");
+    
+    TEST_ASSERT(sweep_write(results_path, sequential, count) == SUCCESS, "CSV written");
+    TEST_ASSERT(count_lines(results_path) == count + 1, "Header and one row per configuration");
+    unlink(results_path);
+    
+    strcat(results_path, ".json");
+    TEST_ASSERT(sweep_write(results_path, sequential, count) == SUCCESS, "JSON written");
+    TEST_ASSERT(count_lines(results_path) == count + 2, "One object per configuration");
+    unlink(results_path);
+    
+    free(sequential);
+    free(parallel);
+}
+
+
+// MAIN TEST RUNNER
+
+
+int main(void) {
+    printf("\n");
+    printf("========================================\n");
+    printf("   PARAMETER SWEEP UNIT TESTS\n");
+    printf("========================================\n");
+    
+    set_log_level(LOG_LEVEL_ERROR);
+    snprintf(results_path, sizeof(results_path), "/tmp/test_sweep_%d", (int)getpid());
+    
+    // Run all tests
+    RUN_TEST(test_parse_defaults);
+    RUN_TEST(test_parse_values);
+    RUN_TEST(test_parse_errors);
+    RUN_TEST(test_grid_expansion);
+    RUN_TEST(test_random_samples);
+    RUN_TEST(test_apply);
+    RUN_TEST(test_without_preemption);
+    RUN_TEST(test_parallel_sweep);
+    
+    // Print summary
+    printf("\n");
+    printf("========================================\n");
+    printf("   TEST SUMMARY\n");
+    printf("========================================\n");
+    printf("Tests Passed: %d\n", tests_passed);
+    printf("Tests Failed: %d\n", tests_failed);
+    printf("Total Tests: %d\n", tests_passed + tests_failed);
+    printf("Success Rate: %.2f%%\n",
+           (tests_passed * 100.0) / (tests_passed + tests_failed));
+    printf("========================================\n\n");
+    
+    return (tests_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -144,6 +144,54 @@ void test_remove_task(void) {
     task_manager_cleanup();
 }
 
+// Test lookup and removal among many tasks
+void test_task_index(void) {
+    task_manager_init();
+    
+    int count = 5000;
+    for (int i = 0; i < count; i++) {
+        create_task("Indexed", PRIORITY_MEDIUM, ENERGY_LOW, 300, false, 5000);
+    }
+    
+    // Remove every third task, then check every ID
+    for (int id = 1; id <= count; id += 3) {
+        remove_task(id);
+    }
+    
+    bool all_correct = true;
+    for (int id = 1; id <= count; id++) {
+        Task *task = get_task(id);
+        bool removed = ((id - 1) % 3 == 0);
+        if (removed ? (task != NULL) : (task == NULL || task->task_id != id)) {
+            all_correct = false;
+        }
+    }
+    TEST_ASSERT(all_correct, "Lookup correct after interleaved removals");
+    TEST_ASSERT(remove_task(1) == ERROR, "Removing twice fails");
+    
+    task_manager_cleanup();
+}
+
+// Test that handles detect removed tasks
+void test_task_handles(void) {
+    task_manager_init();
+    
+    Task *task = create_task("Handled", PRIORITY_HIGH, ENERGY_LOW, 300, false, 5000);
+    TaskHandle handle = get_task_handle(task);
+    TEST_ASSERT(resolve_task_handle(handle) == task, "Handle resolves to its task");
+    
+    remove_task(task->task_id);
+    TEST_ASSERT(resolve_task_handle(handle) == NULL, "Handle is stale after removal");
+    
+    // The slot is reused by the next task, but the old handle stays stale
+    Task *reused = create_task("Reused", PRIORITY_LOW, ENERGY_LOW, 300, false, 5000);
+    TEST_ASSERT(reused == task, "Slot reused");
+    TEST_ASSERT(resolve_task_handle(handle) == NULL, "Stale handle does not see the new task");
+    TEST_ASSERT(resolve_task_handle(get_task_handle(reused)) == reused, "New handle resolves");
+    
+    task_manager_cleanup();
+}
+
 // Test task queue creation
 void test_create_task_queue(void) {
     TaskQueue *queue = create_task_queue();
@@ -188,14 +236,36 @@ void test_enqueue_dequeue(void) {
     task_manager_cleanup();
 }
 
-// Test queue empty and full
+// Test that queues hold handles to pool tasks rather than copies
+void test_queue_holds_task_handles(void) {
+    task_manager_init();
+    TaskQueue *queue = create_task_queue();
+    
+    Task *task = create_task("Handle", PRIORITY_HIGH, ENERGY_LOW, 300, false, 5000);
+    enqueue_task(queue, task);
+    
+    Task *dequeued = dequeue_task(queue);
+    TEST_ASSERT(dequeued == task, "Dequeue returns the pooled task itself");
+    
+    dequeued->remaining_time = 100;
+    TEST_ASSERT(get_task(task->task_id)->remaining_time == 100, 
+                "Changes through the queue are visible via get_task");
+    
+    TEST_ASSERT(sizeof(TaskQueue) < MAX_TASKS * sizeof(Task) / 4, 
+                "Queue stores compact handles");
+    
+    destroy_task_queue(queue);
+    task_manager_cleanup();
+}
+
+// Test queue empty and growth past its initial capacity
 void test_queue_empty_full(void) {
     task_manager_init();
     TaskQueue *queue = create_task_queue();
     
     TEST_ASSERT(is_queue_empty(queue), "Queue initially empty");
     
-    // Fill queue to maximum
+    // Fill queue to its initial capacity
     for (int i = 0; i < MAX_TASKS; i++) {
         char name[MAX_TASK_NAME];
         snprintf(name, MAX_TASK_NAME, "Task%d", i);
@@ -203,18 +273,70 @@ void test_queue_empty_full(void) {
         enqueue_task(queue, task);
     }
     
-    TEST_ASSERT(is_queue_full(queue), "Queue is full");
-    TEST_ASSERT(get_queue_size(queue) == MAX_TASKS, "Queue size at maximum");
+    TEST_ASSERT(is_queue_full(queue), "Queue reaches initial capacity");
+    TEST_ASSERT(get_queue_size(queue) == MAX_TASKS, "Queue size at initial capacity");
     
-    // Try to enqueue when full
+    // Enqueue past capacity grows the queue and keeps FIFO order
     Task *extra = create_task("Extra", PRIORITY_LOW, ENERGY_LOW, 200, false, 4000);
     int result = enqueue_task(queue, extra);
-    TEST_ASSERT(result == ERROR, "Cannot enqueue when full");
+    TEST_ASSERT(result == SUCCESS, "Enqueue past initial capacity");
+    TEST_ASSERT(get_queue_size(queue) == MAX_TASKS + 1, "Queue grew by one");
+    
+    Task *first = dequeue_task(queue);
+    TEST_ASSERT(first != NULL && strcmp(first->task_name, "Task0") == 0, 
+                "FIFO order kept across growth");
     
     destroy_task_queue(queue);
     task_manager_cleanup();
 }
 
+// Heap ordering used by the keyed queue tests
+static int compare_burst(const Task *a, const Task *b) {
+    return a->burst_time - b->burst_time;
+}
+
+// Test keyed ready queue ordering, removal and key updates
+void test_task_heap(void) {
+    task_manager_init();
+    TaskHeap *heap = create_task_heap(compare_burst);
+    
+    int bursts[] = {500, 100, 900, 300, 700, 300, 200, 800};
+    Task *tasks[8];
+    for (int i = 0; i < 8; i++) {
+        tasks[i] = create_task("Keyed", PRIORITY_MEDIUM, ENERGY_LOW, bursts[i], false, 5000);
+        heap_push_task(heap, tasks[i]);
+    }
+    TEST_ASSERT(get_heap_size(heap) == 8, "Heap holds all tasks");
+    TEST_ASSERT(heap_peek_task(heap) == tasks[1], "Peek returns smallest key");
+    
+    // Remove from the middle and lower another task's key
+    heap_remove_task(heap, tasks[4]);
+    tasks[2]->burst_time = 50;
+    heap_update_task(heap, tasks[2]);
+    
+    Task *popped = heap_pop_task(heap);
+    TEST_ASSERT(popped == tasks[2], "Decreased key pops first");
+    
+    bool ordered = true;
+    int last = 0;
+    while (!is_heap_empty(heap)) {
+        Task *task = heap_pop_task(heap);
+        if (task->burst_time < last || task == tasks[4]) {
+            ordered = false;
+        }
+        last = task->burst_time;
+    }
+    TEST_ASSERT(ordered, "Remaining tasks pop in key order without the removed one");
+    
+    // Equal keys keep FIFO order
+    heap_push_task(heap, tasks[3]);
+    heap_push_task(heap, tasks[5]);
+    TEST_ASSERT(heap_pop_task(heap) == tasks[3], "Equal keys pop in enqueue order");
+    
+    destroy_task_heap(heap);
+    task_manager_cleanup();
+}
+
 // Test task state management
 void test_task_state_management(void) {
     task_manager_init();
@@ -242,19 +364,19 @@ void test_update_task_times(void) {
     Task *task = create_task("TestTask", PRIORITY_HIGH, ENERGY_LOW, 500, false, 5000);
     
     // Set start time
-    task->start_time = get_current_time_ms();
+    task->start_time_ns = get_time_ns();
     sleep_ms(50);
     
     int result = update_task_times(task);
     TEST_ASSERT(result == SUCCESS, "Update task times");
-    TEST_ASSERT(task->waiting_time >= 0, "Waiting time calculated");
+    TEST_ASSERT(task->waiting_time_ns >= 0, "Waiting time calculated");
     
     // Set completion time
     sleep_ms(50);
-    task->completion_time = get_current_time_ms();
+    task->completion_time_ns = get_time_ns();
     update_task_times(task);
     
-    TEST_ASSERT(task->turnaround_time > 0, "Turnaround time calculated");
+    TEST_ASSERT(task->turnaround_time_ns > 0, "Turnaround time calculated");
     
     task_manager_cleanup();
 }
@@ -271,10 +393,10 @@ void test_task_statistics(void) {
     TEST_ASSERT(stats->total_tasks > 0, "Total tasks count updated");
     
     // Complete the task
-    task->start_time = get_current_time_ms();
-    task->completion_time = task->start_time + 100;
-    task->turnaround_time = 100;
-    task->waiting_time = 0;
+    task->start_time_ns = get_time_ns();
+    task->completion_time_ns = task->start_time_ns + 100 * NS_PER_MS;
+    task->turnaround_time_ns = 100 * NS_PER_MS;
+    task->waiting_time_ns = 0;
     set_task_state(task, TASK_STATE_COMPLETED);
     
     TEST_ASSERT(stats->completed_tasks > 0, "Completed tasks count updated");
@@ -282,6 +404,25 @@ void test_task_statistics(void) {
     task_manager_cleanup();
 }
 
+// Test that task times keep sub-millisecond precision on the monotonic clock
+void test_sub_millisecond_times(void) {
+    task_manager_init();
+    
+    Task *task = create_task("Short", PRIORITY_HIGH, ENERGY_LOW, 1, false, 5000);
+    set_task_state(task, TASK_STATE_RUNNING);
+    while (get_time_ns() - task->start_time_ns < 200 * NS_PER_US) {
+        // Busy-wait for 0.2 ms
+    }
+    set_task_state(task, TASK_STATE_COMPLETED);
+    
+    TEST_ASSERT(task->start_time_ns >= task->arrival_time_ns, "Start not before arrival");
+    TEST_ASSERT(task->turnaround_time_ns >= 200 * NS_PER_US &&
+                task->turnaround_time_ns < 100 * NS_PER_MS, "Turnaround measured below 1 ms");
+    TEST_ASSERT(get_task_statistics()->avg_turnaround_time > 0.0, "Average keeps the fraction of a ms");
+    
+    task_manager_cleanup();
+}
+
 // Test task priorities
 void test_task_priorities(void) {
     task_manager_init();
@@ -335,13 +476,14 @@ void test_task_name_length(void) {
     task_manager_cleanup();
 }
 
-// Test maximum tasks limit
-void test_maximum_tasks_limit(void) {
+// Test that the pool grows past MAX_TASKS without moving tasks
+void test_task_pool_growth(void) {
     task_manager_init();
     
-    // Create maximum tasks
-    int created = 0;
-    for (int i = 0; i < MAX_TASKS + 5; i++) {
+    Task *first = create_task("First", PRIORITY_HIGH, ENERGY_LOW, 300, false, 5000);
+    
+    int created = 1;
+    for (int i = 0; i < MAX_TASKS * 20; i++) {
         char name[MAX_TASK_NAME];
         snprintf(name, MAX_TASK_NAME, "Task%d", i);
         Task *task = create_task(name, PRIORITY_MEDIUM, ENERGY_LOW, 300, false, 5000);
@@ -350,7 +492,94 @@ void test_maximum_tasks_limit(void) {
         }
     }
     
-    TEST_ASSERT(created <= MAX_TASKS, "Cannot create more than MAX_TASKS");
+    TEST_ASSERT(created == MAX_TASKS * 20 + 1, "Create more than MAX_TASKS tasks");
+    TEST_ASSERT(get_task_count() == created, "Live task count tracked");
+    TEST_ASSERT(strcmp(first->task_name, "First") == 0, "Task address stable across growth");
+    
+    task_manager_cleanup();
+}
+
+// Test that removed slots are recycled
+void test_task_slot_reuse(void) {
+    task_manager_init();
+    
+    Task *keep = create_task("Keep", PRIORITY_HIGH, ENERGY_LOW, 300, false, 5000);
+    Task *gone = create_task("Gone", PRIORITY_LOW, ENERGY_LOW, 300, false, 5000);
+    
+    remove_task(gone->task_id);
+    Task *reused = create_task("Reused", PRIORITY_MEDIUM, ENERGY_LOW, 300, false, 5000);
+    
+    TEST_ASSERT(reused == gone, "Freed slot is reused by the next task");
+    TEST_ASSERT(strcmp(keep->task_name, "Keep") == 0, "Other tasks are not moved");
+    TEST_ASSERT(get_task(keep->task_id) == keep, "Remaining task still found");
+    TEST_ASSERT(get_task_count() == 2, "Live task count after reuse");
+    
+    task_manager_cleanup();
+}
+
+// Test that every scan kernel picks the same lowest-score task
+void test_scan_best_task(void) {
+    task_manager_init();
+    
+    TaskScanWeights weights = {.priority = 1, .energy_cost = 4, .remaining_time = 0,
+                               .deadline = 0, .non_critical = 16};
+    Task *expected = NULL;
+    int expected_score = 0;
+    
+    // Span several pool chunks, with a partial vector at the end of the last one
+    for (int i = 0; i < 700; i++) {
+        Task *task = create_task("Scan", 1 + (i * 7) % 3, 1 + (i * 5) % 3,
+                                 100 + i, (i % 97) == 0, 5000);
+        if (i % 3 == 0) {
+            set_task_state(task, TASK_STATE_WAITING);
+            continue;
+        }
+        int score = task->priority + 4 * task->energy_cost + (task->is_critical ? 0 : 16);
+        if (expected == NULL || score < expected_score) {
+            expected = task;
+            expected_score = score;
+        }
+    }
+    
+    ScanKernel kernels[] = {SCAN_KERNEL_SCALAR, SCAN_KERNEL_SSE41, SCAN_KERNEL_AVX2};
+    for (int k = 0; k < 3; k++) {
+        set_scan_kernel(kernels[k]);
+        TEST_ASSERT(scan_best_task(TASK_STATE_READY, &weights) == expected,
+                    "Kernel agrees with reference scan");
+    }
+    
+    // Key changes made through the API are seen by the next scan
+    expected->priority = PRIORITY_LOW;
+    expected->energy_cost = ENERGY_HIGH;
+    update_task_keys(expected);
+    set_scan_kernel(SCAN_KERNEL_AUTO);
+    TEST_ASSERT(scan_best_task(TASK_STATE_READY, &weights) != expected, "Updated keys rescored");
+    TEST_ASSERT(scan_best_task(TASK_STATE_COMPLETED, &weights) == NULL, "No match returns NULL");
+    
+    task_manager_cleanup();
+}
+
+// Test filter counts served from the packed key arrays
+void test_task_key_counts(void) {
+    task_manager_init();
+    
+    Task *a = create_task("A", PRIORITY_HIGH, ENERGY_LOW, 300, true, 5000);
+    create_task("B", PRIORITY_HIGH, ENERGY_LOW, 300, false, 5000);
+    Task *c = create_task("C", PRIORITY_LOW, ENERGY_HIGH, 300, true, 5000);
+    
+    int count = 0;
+    get_tasks_by_priority(PRIORITY_HIGH, &count);
+    TEST_ASSERT(count == 2, "Count by priority");
+    get_critical_tasks(&count);
+    TEST_ASSERT(count == 2, "Count critical tasks");
+    
+    set_task_state(a, TASK_STATE_RUNNING);
+    get_tasks_by_state(TASK_STATE_READY, &count);
+    TEST_ASSERT(count == 2, "Count by state after state change");
+    
+    remove_task(c->task_id);
+    get_critical_tasks(&count);
+    TEST_ASSERT(count == 1, "Removed task no longer counted");
     
     task_manager_cleanup();
 }
@@ -380,16 +609,24 @@ int main(void) {
     RUN_TEST(test_task_id_generation);
     RUN_TEST(test_get_task);
     RUN_TEST(test_remove_task);
+    RUN_TEST(test_task_index);
+    RUN_TEST(test_task_handles);
     RUN_TEST(test_create_task_queue);
     RUN_TEST(test_enqueue_dequeue);
+    RUN_TEST(test_queue_holds_task_handles);
     RUN_TEST(test_queue_empty_full);
+    RUN_TEST(test_task_heap);
     RUN_TEST(test_task_state_management);
     RUN_TEST(test_update_task_times);
     RUN_TEST(test_task_statistics);
+    RUN_TEST(test_sub_millisecond_times);
     RUN_TEST(test_task_priorities);
     RUN_TEST(test_task_energy_costs);
     RUN_TEST(test_task_name_length);
-    RUN_TEST(test_maximum_tasks_limit);
+    RUN_TEST(test_task_pool_growth);
+    RUN_TEST(test_task_slot_reuse);
+    RUN_TEST(test_scan_best_task);
+    RUN_TEST(test_task_key_counts);
     RUN_TEST(test_cleanup_without_init);
     
     // Print summary
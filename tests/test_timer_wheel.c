@@ -0,0 +1,232 @@
+#include "../include/timer_wheel.h"
+#include "../include/utils.h"
+#include <stdio.h>
+#include <assert.h>
+
+
+// TEST COUNTER
+
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+
+// TEST HELPER MACROS
+
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            printf("[PASS] %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("[FAIL] %s\n", message); \
+            tests_failed++; \
+        } \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        printf("\n--- Running %s ---\n", #test_func); \
+        test_func(); \
+    } while(0)
+
+
+// TEST HELPERS
+
+
+#define TICK_MS 10
+
+// Expiry bookkeeping shared with the callbacks
+typedef struct {
+    long now_ms;                    // Time passed to the current advance
+    int fired;                      // Timers fired so far
+    int early;                      // Timers fired before their expiry
+    int late;                       // Timers fired after a later advance than needed
+    long step_ms;                   // Gap between advances (0 = single advance)
+} FireLog;
+
+static TimerWheel wheel;
+
+// Record when a timer fired relative to its expiry (data holds expires_ms)
+static void record_fire(TimerEntry *entry, void *context) {
+    FireLog *log = (FireLog*)context;
+    long expires_ms = *(long*)entry->data;
+    log->fired++;
+    if (log->now_ms < expires_ms) {
+        log->early++;
+    }
+    if (log->step_ms > 0 && log->now_ms >= expires_ms + log->step_ms) {
+        log->late++;
+    }
+}
+
+// Re-arm the timer once, 50 ms later
+static void rearm_once(TimerEntry *entry, void *context) {
+    FireLog *log = (FireLog*)context;
+    log->fired++;
+    if (log->fired == 1) {
+        timer_wheel_add(&wheel, entry, log->now_ms + 50, entry->data);
+    }
+}
+
+// Advance the wheel in fixed steps up to end_ms
+static void advance_in_steps(FireLog *log, long start_ms, long end_ms, long step_ms) {
+    log->step_ms = step_ms;
+    for (long now = start_ms; now <= end_ms; now += step_ms) {
+        log->now_ms = now;
+        timer_wheel_advance(&wheel, now, record_fire, log);
+    }
+}
+
+
+// TEST FUNCTIONS
+
+
+// Test that an empty wheel fires nothing
+void test_empty_wheel(void) {
+    timer_wheel_init(&wheel, TICK_MS, 0);
+    
+    TEST_ASSERT(timer_wheel_count(&wheel) == 0, "New wheel is empty");
+    TEST_ASSERT(timer_wheel_advance(&wheel, 1000000, NULL, NULL) == 0, "Nothing fires");
+    
+    TimerEntry entry;
+    timer_entry_init(&entry);
+    TEST_ASSERT(!timer_is_armed(&entry), "New timer is not armed");
+}
+
+// Test that a timer fires on its expiry tick, not before
+void test_fire_on_expiry(void) {
+    timer_wheel_init(&wheel, TICK_MS, 0);
+    FireLog log = {0};
+    
+    TimerEntry entry;
+    long expires = 125;
+    timer_entry_init(&entry);
+    timer_wheel_add(&wheel, &entry, expires, &expires);
+    TEST_ASSERT(timer_is_armed(&entry), "Timer armed");
+    
+    log.now_ms = 120;
+    timer_wheel_advance(&wheel, log.now_ms, record_fire, &log);
+    TEST_ASSERT(log.fired == 0, "Not fired before expiry");
+    
+    log.now_ms = 130;
+    timer_wheel_advance(&wheel, log.now_ms, record_fire, &log);
+    TEST_ASSERT(log.fired == 1, "Fired once expiry passed");
+    TEST_ASSERT(!timer_is_armed(&entry), "Fired timer is disarmed");
+    TEST_ASSERT(timer_wheel_count(&wheel) == 0, "Wheel empty after firing");
+}
+
+// Test cancelling armed timers
+void test_cancel(void) {
+    timer_wheel_init(&wheel, TICK_MS, 0);
+    FireLog log = {0};
+    
+    TimerEntry a, b;
+    long expires_a = 200, expires_b = 90000;
+    timer_entry_init(&a);
+    timer_entry_init(&b);
+    timer_wheel_add(&wheel, &a, expires_a, &expires_a);
+    timer_wheel_add(&wheel, &b, expires_b, &expires_b);
+    
+    timer_wheel_cancel(&wheel, &a);
+    timer_wheel_cancel(&wheel, &b);
+    timer_wheel_cancel(&wheel, &b);
+    TEST_ASSERT(timer_wheel_count(&wheel) == 0, "Cancelled timers removed");
+    
+    advance_in_steps(&log, 0, 100000, 1000);
+    TEST_ASSERT(log.fired == 0, "Cancelled timers never fire");
+}
+
+// Test timers on every wheel level, including ones beyond its range
+void test_cascade_levels(void) {
+    timer_wheel_init(&wheel, TICK_MS, 0);
+    FireLog log = {0};
+    
+    long expires[] = {30, 700, 41000, 2700000, 180000000};
+    TimerEntry entries[5];
+    for (int i = 0; i < 5; i++) {
+        timer_entry_init(&entries[i]);
+        timer_wheel_add(&wheel, &entries[i], expires[i], &expires[i]);
+    }
+    
+    advance_in_steps(&log, 0, 200000000, TICK_MS * 7);
+    TEST_ASSERT(log.fired == 5, "Every level fires");
+    TEST_ASSERT(log.early == 0, "No timer fires early");
+    TEST_ASSERT(log.late == 0, "Timers fire on the first advance past expiry");
+}
+
+// Test one large advance past many expiries
+void test_large_jump(void) {
+    timer_wheel_init(&wheel, TICK_MS, 500);
+    FireLog log = {0};
+    
+    static TimerEntry entries[1000];
+    static long expires[1000];
+    for (int i = 0; i < 1000; i++) {
+        expires[i] = 500 + (long)i * 977;
+        timer_entry_init(&entries[i]);
+        timer_wheel_add(&wheel, &entries[i], expires[i], &expires[i]);
+    }
+    
+    log.now_ms = 500 + 500 * 977;
+    timer_wheel_advance(&wheel, log.now_ms, record_fire, &log);
+    TEST_ASSERT(log.fired == 501, "Jump fires exactly the due timers");
+    TEST_ASSERT(timer_wheel_count(&wheel) == 499, "Later timers stay armed");
+    
+    log.now_ms = 500 + 1000 * 977;
+    timer_wheel_advance(&wheel, log.now_ms, record_fire, &log);
+    TEST_ASSERT(log.fired == 1000, "Remaining timers fire");
+    TEST_ASSERT(log.early == 0, "No timer fires early");
+}
+
+// Test that a callback can re-arm its own timer
+void test_rearm_from_callback(void) {
+    timer_wheel_init(&wheel, TICK_MS, 0);
+    FireLog log = {0};
+    
+    TimerEntry entry;
+    timer_entry_init(&entry);
+    timer_wheel_add(&wheel, &entry, 100, NULL);
+    
+    for (log.now_ms = 0; log.now_ms <= 300; log.now_ms += TICK_MS) {
+        timer_wheel_advance(&wheel, log.now_ms, rearm_once, &log);
+        if (log.now_ms == 140) {
+            TEST_ASSERT(log.fired == 1 && timer_is_armed(&entry), "Re-armed timer pending");
+        }
+    }
+    TEST_ASSERT(log.fired == 2, "Re-armed timer fires again");
+}
+
+
+// MAIN TEST RUNNER
+
+
+int main(void) {
+    printf("\n");
+    printf("========================================\n");
+    printf("   TIMER WHEEL UNIT TESTS\n");
+    printf("========================================\n");
+    
+    // Run all tests
+    RUN_TEST(test_empty_wheel);
+    RUN_TEST(test_fire_on_expiry);
+    RUN_TEST(test_cancel);
+    RUN_TEST(test_cascade_levels);
+    RUN_TEST(test_large_jump);
+    RUN_TEST(test_rearm_from_callback);
+    
+    // Print summary
+    printf("\n");
+    printf("========================================\n");
+    printf("   TEST SUMMARY\n");
+    printf("========================================\n");
+    printf("Tests Passed: %d\n", tests_passed);
+    printf("Tests Failed: %d\n", tests_failed);
+    printf("Total Tests: %d\n", tests_passed + tests_failed);
+    printf("Success Rate: %.2f%%\n",
+           (tests_passed * 100.0) / (tests_passed + tests_failed));
+    printf("========================================\n\n");
+    
+    return (tests_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
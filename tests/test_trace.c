@@ -0,0 +1,210 @@
+#define _DEFAULT_SOURCE
+#include "../include/trace.h"
+#include "../include/scheduler.h"
+#include "../include/utils.h"
+#include <stdio.h>
+#include <assert.h>
+#include <unistd.h>
+
+
+// TEST COUNTER
+
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+
+// TEST HELPER MACROS
+
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            printf("[PASS] %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("[FAIL] %s\n", message); \
+            tests_failed++; \
+        } \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        printf("\n--- Running %s ---\n", #test_func); \
+        test_func(); \
+    } while(0)
+
+
+// TEST HELPERS
+
+
+#define MAX_READ_EVENTS 4096
+
+static char trace_path[64];
+static TraceHeader header;
+static TraceEvent events[MAX_READ_EVENTS];
+
+// Read a closed trace back; returns the number of events in the file
+static int read_trace(void) {
+    FILE *file = fopen(trace_path, "rb");
+    if (file == NULL) {
+        return -1;
+    }
+    
+    int count = 0;
+    if (fread(&header, sizeof(header), 1, file) == 1) {
+        while (count < MAX_READ_EVENTS && fread(&events[count], sizeof(TraceEvent), 1, file) == 1) {
+            count++;
+        }
+    }
+    fclose(file);
+    return count;
+}
+
+// Count events of one type in the last trace read
+static int count_events(TraceEventType type, int total) {
+    int count = 0;
+    for (int i = 0; i < total; i++) {
+        if (events[i].type == type) {
+            count++;
+        }
+    }
+    return count;
+}
+
+
+// TEST FUNCTIONS
+
+
+// Test that recording without an open trace is a no-op
+void test_trace_disabled(void) {
+    TEST_ASSERT(!trace_enabled(), "Tracing off by default");
+    trace_record(TRACE_ADMIT, 1, 0, 0, 0, 0);
+    TEST_ASSERT(trace_close() == ERROR, "Closing without a trace fails");
+}
+
+// Test that events are written and read back intact
+void test_trace_roundtrip(void) {
+    TEST_ASSERT(trace_open(trace_path, 16) == SUCCESS, "Trace opened");
+    TEST_ASSERT(trace_enabled(), "Tracing enabled");
+    
+    trace_record(TRACE_ADMIT, 7, PRIORITY_HIGH, ENERGY_LOW, 300, 5000);
+    trace_record(TRACE_DISPATCH, 7, SCHEDULER_FCFS, MODE_PERFORMANCE, 300, 100);
+    trace_record(TRACE_MODE_CHANGE, -1, MODE_PERFORMANCE, MODE_BALANCED, 50, 0);
+    TEST_ASSERT(trace_close() == SUCCESS, "Trace closed");
+    
+    int count = read_trace();
+    TEST_ASSERT(memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) == 0, "Header has magic");
+    TEST_ASSERT(header.event_size == sizeof(TraceEvent) && sizeof(TraceEvent) == 32,
+                "Events are 32 bytes");
+    TEST_ASSERT(header.count == 3 && count == 3, "File truncated to recorded events");
+    TEST_ASSERT(events[0].type == TRACE_ADMIT && events[0].task_id == 7 &&
+                events[0].payload[2] == 300 && events[0].payload[3] == 5000, "Admit event intact");
+    TEST_ASSERT(events[2].type == TRACE_MODE_CHANGE && events[2].task_id == -1 &&
+                events[2].payload[1] == MODE_BALANCED, "Mode change event intact");
+    TEST_ASSERT(events[0].timestamp_ns <= events[1].timestamp_ns &&
+                events[1].timestamp_ns <= events[2].timestamp_ns, "Timestamps in order");
+}
+
+// Test that a full trace counts the events it cannot hold
+void test_trace_overflow(void) {
+    trace_open(trace_path, 4);
+    for (int i = 0; i < 10; i++) {
+        trace_record(TRACE_BATTERY, -1, 100 - i, 0, 1, 0);
+    }
+    trace_close();
+    
+    int count = read_trace();
+    TEST_ASSERT(count == 4 && header.count == 4, "Only capacity events kept");
+    TEST_ASSERT(header.dropped == 6, "Overflow counted as dropped");
+    TEST_ASSERT(events[3].payload[0] == 97, "Earliest events kept");
+}
+
+// Test the events recorded by a scheduler run
+void test_scheduler_trace(void) {
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+    reset_virtual_clock();
+    scheduler_init(SCHEDULER_ROUND_ROBIN);
+    trace_open(trace_path, MAX_READ_EVENTS);
+    
+    admit_task_to_scheduler(create_task("A", PRIORITY_LOW, ENERGY_HIGH, 150, false, 5000));
+    admit_task_to_scheduler(create_task("B", PRIORITY_HIGH, ENERGY_LOW, 30, true, 5000));
+    admit_task_to_scheduler(create_task("C", PRIORITY_MEDIUM, ENERGY_MEDIUM, 20, false, 5000));
+    scheduler_start();
+    scheduler_run_loop();
+    
+    trace_close();
+    SchedulerStats stats = *get_scheduler_statistics();
+    scheduler_cleanup();
+    set_clock_mode(CLOCK_MODE_WALL);
+    
+    int count = read_trace();
+    TEST_ASSERT(count_events(TRACE_ADMIT, count) == 3, "One ADMIT per admitted task");
+    TEST_ASSERT(count_events(TRACE_COMPLETE, count) == stats.tasks_completed,
+                "One COMPLETE per completed task");
+    TEST_ASSERT(count_events(TRACE_CONTEXT_SWITCH, count) == stats.context_switches,
+                "One CONTEXT_SWITCH per context switch");
+    TEST_ASSERT(count_events(TRACE_DISPATCH, count) == count_events(TRACE_BATTERY, count),
+                "Every dispatch records a battery sample");
+    
+    bool ordered = true;
+    for (int i = 1; i < count; i++) {
+        ordered = ordered && events[i].timestamp_ns >= events[i - 1].timestamp_ns;
+    }
+    TEST_ASSERT(ordered, "Virtual-clock timestamps never go backwards");
+}
+
+// Test the cost of recording an event
+void test_trace_cost(void) {
+    const int iterations = 1000000;
+    trace_open(trace_path, iterations);
+    
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < iterations; i++) {
+        trace_record(TRACE_DISPATCH, i, 0, 0, i, 0);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    trace_close();
+    
+    double per_event = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) /
+                       iterations;
+    printf("Average cost per event: %.1f ns\n", per_event);
+    TEST_ASSERT(per_event < 1000.0, "Recording an event is cheap");
+}
+
+
+// MAIN TEST RUNNER
+
+
+int main(void) {
+    printf("\n");
+    printf("========================================\n");
+    printf("   TRACE UNIT TESTS\n");
+    printf("========================================\n");
+    
+    snprintf(trace_path, sizeof(trace_path), "/tmp/test_trace_%d.bin", (int)getpid());
+    
+    // Run all tests
+    RUN_TEST(test_trace_disabled);
+    RUN_TEST(test_trace_roundtrip);
+    RUN_TEST(test_trace_overflow);
+    RUN_TEST(test_scheduler_trace);
+    RUN_TEST(test_trace_cost);
+    
+    unlink(trace_path);
+    
+    // Print summary
+    printf("\n");
+    printf("========================================\n");
+    printf("   TEST SUMMARY\n");
+    printf("========================================\n");
+    printf("Tests Passed: %d\n", tests_passed);
+    printf("Tests Failed: %d\n", tests_failed);
+    printf("Total Tests: %d\n", tests_passed + tests_failed);
+    printf("Success Rate: %.2f%%\n",
+           (tests_passed * 100.0) / (tests_passed + tests_failed));
+    printf("========================================\n\n");
+    
+    return (tests_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,377 @@
+#include "../include/workload.h"
+#include "../include/scheduler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+
+// TEST COUNTER
+
+
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+
+// TEST HELPER MACROS
+
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (condition) { \
+            printf("[PASS] %s\n", message); \
+            tests_passed++; \
+        } else { \
+            printf("[FAIL] %s\n", message); \
+            tests_failed++; \
+        } \
+    } while(0)
+
+#define RUN_TEST(test_func) \
+    do { \
+        printf("\n--- Running %s ---\n", #test_func); \
+        test_func(); \
+    } while(0)
+
+
+// TEST HELPERS
+
+
+// Relative difference between a measured and an expected value
+static double relative_error(double measured, double expected) {
+    return fabs(measured - expected) / expected;
+}
+
+// Default workload with the given size and burst distribution
+static WorkloadConfig make_config(long task_count, BurstDistribution burst) {
+    WorkloadConfig config;
+    workload_default_config(&config);
+    config.task_count = task_count;
+    config.burst = burst;
+    return config;
+}
+
+
+// RANDOM NUMBER GENERATOR TESTS
+
+
+// Test that a seed fixes the sequence
+void test_rng_reproducible(void) {
+    Rng a, b, c;
+    rng_seed(&a, 42);
+    rng_seed(&b, 42);
+    rng_seed(&c, 43);
+    
+    bool same = true;
+    bool differs = false;
+    for (int i = 0; i < 1000; i++) {
+        uint64_t value = rng_next(&a);
+        same = same && value == rng_next(&b);
+        differs = differs || value != rng_next(&c);
+    }
+    TEST_ASSERT(same, "Same seed gives the same sequence");
+    TEST_ASSERT(differs, "Different seeds give different sequences");
+    
+    rng_seed(&a, 0);
+    TEST_ASSERT(rng_next(&a) != 0 || rng_next(&a) != 0, "Seed 0 still produces output");
+}
+
+// Test the uniform and exponential deviates
+void test_rng_distributions(void) {
+    Rng rng;
+    rng_seed(&rng, 7);
+    
+    double sum = 0.0;
+    double exp_sum = 0.0;
+    bool in_range = true;
+    int samples = 200000;
+    for (int i = 0; i < samples; i++) {
+        double u = rng_uniform(&rng);
+        in_range = in_range && u >= 0.0 && u < 1.0;
+        sum += u;
+        exp_sum += rng_exponential(&rng, 25.0);
+    }
+    TEST_ASSERT(in_range, "Uniform deviates lie in [0, 1)");
+    TEST_ASSERT(relative_error(sum / samples, 0.5) < 0.01, "Uniform mean is 0.5");
+    TEST_ASSERT(relative_error(exp_sum / samples, 25.0) < 0.02, "Exponential mean is as requested");
+}
+
+
+// WORKLOAD GENERATOR TESTS
+
+
+// Test invalid configurations are refused
+void test_workload_validation(void) {
+    WorkloadGenerator gen;
+    WorkloadConfig config = make_config(10, BURST_PARETO);
+    TEST_ASSERT(workload_init(&gen, &config) == SUCCESS, "Default configuration accepted");
+    
+    config.pareto_alpha = 1.0;
+    TEST_ASSERT(workload_init(&gen, &config) == ERROR, "Pareto index of 1 refused (infinite mean)");
+    
+    config = make_config(10, BURST_EXPONENTIAL);
+    config.mean_interarrival_ms = 0;
+    TEST_ASSERT(workload_init(&gen, &config) == ERROR, "Zero interarrival refused");
+    
+    config = make_config(10, BURST_EXPONENTIAL);
+    config.min_burst_ms = 500;
+    config.max_burst_ms = 100;
+    TEST_ASSERT(workload_init(&gen, &config) == ERROR, "Inverted burst bounds refused");
+    
+    config = make_config(10, BURST_EXPONENTIAL);
+    config.energy_mix[0] = config.energy_mix[1] = config.energy_mix[2] = 0;
+    TEST_ASSERT(workload_init(&gen, &config) == ERROR, "Empty energy mix refused");
+}
+
+// Test generated tasks: count, order, field ranges and reproducibility
+void test_workload_tasks(void) {
+    WorkloadGenerator gen, again;
+    WorkloadConfig config = make_config(50000, BURST_PARETO);
+    config.critical_fraction = 0.1;
+    workload_init(&gen, &config);
+    workload_init(&again, &config);
+    
+    TaskSpec spec, other;
+    long count = 0, critical = 0, high_energy = 0;
+    int64_t last_arrival = 0;
+    bool ordered = true, valid = true, reproducible = true;
+    while (workload_next(&gen, &spec)) {
+        workload_next(&again, &other);
+        reproducible = reproducible && spec.arrival_ms == other.arrival_ms &&
+                       spec.burst_time == other.burst_time && spec.priority == other.priority;
+        ordered = ordered && spec.arrival_ms >= last_arrival;
+        last_arrival = spec.arrival_ms;
+        valid = valid && spec.priority >= PRIORITY_HIGH && spec.priority <= PRIORITY_LOW &&
+                spec.energy_cost >= ENERGY_LOW && spec.energy_cost <= ENERGY_HIGH &&
+                spec.burst_time >= config.min_burst_ms && spec.burst_time <= config.max_burst_ms &&
+                spec.deadline >= spec.burst_time * config.deadline_slack_min &&
+                spec.deadline <= ceil(spec.burst_time * config.deadline_slack_max) &&
+                (!spec.is_critical || spec.priority == PRIORITY_HIGH);
+        critical += spec.is_critical;
+        high_energy += spec.energy_cost == ENERGY_HIGH;
+        count++;
+    }
+    
+    TEST_ASSERT(count == config.task_count, "Exactly task_count tasks generated");
+    TEST_ASSERT(!workload_next(&gen, &spec), "Generator stays exhausted");
+    TEST_ASSERT(ordered, "Tasks come in arrival order");
+    TEST_ASSERT(valid, "Fields within their configured ranges");
+    TEST_ASSERT(reproducible, "Same configuration gives the same workload");
+    TEST_ASSERT(relative_error((double)critical / count, 0.1) < 0.1, "Critical fraction honoured");
+    TEST_ASSERT(relative_error((double)high_energy / count, 0.2) < 0.1, "Energy mix honoured");
+    TEST_ASSERT(relative_error((double)last_arrival / count, config.mean_interarrival_ms) < 0.05,
+                "Poisson arrivals at the configured rate");
+}
+
+// Test the burst time distributions
+void test_burst_distributions(void) {
+    WorkloadGenerator gen;
+    TaskSpec spec;
+    
+    // Exponential: mean as configured (bounds set wide enough not to matter)
+    WorkloadConfig config = make_config(100000, BURST_EXPONENTIAL);
+    config.min_burst_ms = 1;
+    config.max_burst_ms = 100000;
+    workload_init(&gen, &config);
+    double sum = 0.0;
+    while (workload_next(&gen, &spec)) {
+        sum += spec.burst_time;
+    }
+    TEST_ASSERT(relative_error(sum / config.task_count, config.burst_mean_ms) < 0.03,
+                "Exponential bursts have the configured mean");
+    
+    // Pareto: nothing below the scale, and a heavy tail
+    config = make_config(100000, BURST_PARETO);
+    workload_init(&gen, &config);
+    long long_bursts = 0;
+    int shortest = config.max_burst_ms;
+    while (workload_next(&gen, &spec)) {
+        shortest = min(shortest, spec.burst_time);
+        long_bursts += spec.burst_time >= 10 * config.min_burst_ms;
+    }
+    TEST_ASSERT(shortest == config.min_burst_ms, "Pareto bursts start at the scale");
+    // P(X >= 10 x_m) = 10^-alpha, about 3.2% for alpha 1.5
+    TEST_ASSERT(relative_error(long_bursts / 100000.0, pow(10.0, -config.pareto_alpha)) < 0.1,
+                "Pareto tail has the configured index");
+    
+    // Bimodal: only the two modes, long ones at the configured share
+    config = make_config(100000, BURST_BIMODAL);
+    workload_init(&gen, &config);
+    long long_mode = 0;
+    bool two_modes = true;
+    while (workload_next(&gen, &spec)) {
+        two_modes = two_modes && (spec.burst_time == config.short_burst_ms ||
+                                  spec.burst_time == config.long_burst_ms);
+        long_mode += spec.burst_time == config.long_burst_ms;
+    }
+    TEST_ASSERT(two_modes, "Bimodal bursts take one of two values");
+    TEST_ASSERT(relative_error(long_mode / 100000.0, config.long_fraction) < 0.1,
+                "Bimodal long fraction honoured");
+}
+
+// Test periodic, batched and critical-burst arrivals
+void test_arrival_processes(void) {
+    WorkloadGenerator gen;
+    TaskSpec spec;
+    
+    WorkloadConfig config = make_config(100, BURST_EXPONENTIAL);
+    config.arrival = ARRIVAL_PERIODIC;
+    config.mean_interarrival_ms = 25;
+    workload_init(&gen, &config);
+    bool periodic = true;
+    for (int i = 0; workload_next(&gen, &spec); i++) {
+        periodic = periodic && spec.arrival_ms == i * 25;
+    }
+    TEST_ASSERT(periodic, "Periodic arrivals are evenly spaced");
+    
+    config = make_config(10000, BURST_EXPONENTIAL);
+    config.arrival = ARRIVAL_BATCH;
+    config.batch_size = 5;
+    workload_init(&gen, &config);
+    long shared = 0;
+    int64_t last_arrival = -1;
+    while (workload_next(&gen, &spec)) {
+        shared += spec.arrival_ms == last_arrival;
+        last_arrival = spec.arrival_ms;
+    }
+    // Batches average 3 tasks, two of which share the first one's arrival time
+    TEST_ASSERT(shared > 10000 / 2, "Batched tasks arrive together");
+    
+    config = make_config(20000, BURST_EXPONENTIAL);
+    config.critical_fraction = 0.0;
+    config.critical_bursts_per_sec = 1.0;
+    workload_init(&gen, &config);
+    long critical = 0, bursts = 0;
+    bool previous_critical = false;
+    while (workload_next(&gen, &spec)) {
+        critical += spec.is_critical;
+        bursts += spec.is_critical && !previous_critical;
+        previous_critical = spec.is_critical;
+        last_arrival = spec.arrival_ms;
+    }
+    double expected_bursts = last_arrival / 1000.0;
+    TEST_ASSERT(critical > 0 && fabs(bursts - expected_bursts) < 4 * sqrt(expected_bursts),
+                "Critical bursts arrive at the configured rate");
+    TEST_ASSERT((double)critical / bursts > 3.0 && (double)critical / bursts < 6.0,
+                "Critical bursts hold 1..critical_burst_max tasks");
+}
+
+
+// STREAMING ADMISSION TESTS
+
+
+static WorkloadStream stream;
+
+// Arrival source that keeps the battery charged, then streams the workload
+static long admit_charged(long now_ms, void *context) {
+    (void)context;
+    set_battery_level(100);
+    return workload_stream_admit(now_ms, &stream);
+}
+
+// Test that a long workload streams through the scheduler in bounded memory
+void test_stream_constant_memory(void) {
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+    reset_virtual_clock();
+    scheduler_init(SCHEDULER_FCFS);
+    
+    WorkloadGenerator gen;
+    WorkloadConfig config = make_config(100000, BURST_PARETO);
+    config.mean_interarrival_ms = workload_mean_burst_ms(&config) / 0.7;
+    workload_init(&gen, &config);
+    
+    long start_ms = get_current_time_ms();
+    TEST_ASSERT(workload_stream_start(&stream, workload_next, &gen) == SUCCESS, "Stream started");
+    TEST_ASSERT(get_task_count() == 0, "Tasks are not created up front");
+    set_arrival_source(admit_charged, NULL);
+    
+    scheduler_start();
+    scheduler_run_loop();
+    
+    SchedulerStats *stats = get_scheduler_statistics();
+    TEST_ASSERT(stream.admitted + stream.rejected == config.task_count, "Every task offered");
+    TEST_ASSERT(stats->tasks_completed == stream.admitted, "Every admitted task completes");
+    TEST_ASSERT(get_task_count() == 0, "Finished tasks are released");
+    TEST_ASSERT(stream.peak_live < 1000, "Live tasks stay bounded at 70% load");
+    TEST_ASSERT(get_task_memory_usage() < 1000 * 1024, "Task memory does not grow with the workload");
+    TEST_ASSERT(get_current_time_ms() - start_ms >= gen.next_arrival_ms,
+                "Clock ran through the last arrival");
+    
+    scheduler_cleanup();
+    set_clock_mode(CLOCK_MODE_WALL);
+}
+
+// Test that streamed tasks start no earlier than their arrival time
+static int64_t earliest_start_offset_ns;
+
+static void check_start(Task *task, void *context) {
+    (void)context;
+    int64_t offset = task->start_time_ns - task->arrival_time_ns;
+    earliest_start_offset_ns = offset < earliest_start_offset_ns ? offset : earliest_start_offset_ns;
+    remove_task(task->task_id);
+}
+
+void test_stream_arrival_times(void) {
+    set_clock_mode(CLOCK_MODE_VIRTUAL);
+    reset_virtual_clock();
+    scheduler_init(SCHEDULER_ROUND_ROBIN);
+    
+    WorkloadGenerator gen;
+    WorkloadConfig config = make_config(20, BURST_EXPONENTIAL);
+    config.arrival = ARRIVAL_PERIODIC;
+    config.mean_interarrival_ms = 2 * SCHEDULER_IDLE_TIMEOUT_MS;  // Idle gaps between tasks
+    config.energy_mix[1] = config.energy_mix[2] = 0;
+    workload_init(&gen, &config);
+    
+    long start_ms = get_current_time_ms();
+    workload_stream_start(&stream, workload_next, &gen);
+    set_task_done_hook(check_start, NULL);
+    earliest_start_offset_ns = INT64_MAX;
+    
+    scheduler_start();
+    scheduler_run_loop();
+    
+    TEST_ASSERT(get_scheduler_statistics()->tasks_completed == 20, "Tasks spread past the idle timeout all run");
+    TEST_ASSERT(earliest_start_offset_ns >= 0, "No task starts before it arrives");
+    TEST_ASSERT(get_current_time_ms() - start_ms >= 19 * config.mean_interarrival_ms,
+                "Tasks arrive on the workload's timeline");
+    
+    scheduler_cleanup();
+    set_clock_mode(CLOCK_MODE_WALL);
+}
+
+
+// MAIN TEST RUNNER
+
+
+int main(void) {
+    printf("\n");
+    printf("========================================\n");
+    printf("   WORKLOAD GENERATOR UNIT TESTS\n");
+    printf("========================================\n");
+    
+    set_log_level(LOG_LEVEL_ERROR);
+    
+    // Run all tests
+    RUN_TEST(test_rng_reproducible);
+    RUN_TEST(test_rng_distributions);
+    RUN_TEST(test_workload_validation);
+    RUN_TEST(test_workload_tasks);
+    RUN_TEST(test_burst_distributions);
+    RUN_TEST(test_arrival_processes);
+    RUN_TEST(test_stream_constant_memory);
+    RUN_TEST(test_stream_arrival_times);
+    
+    // Print summary
+    printf("\n");
+    printf("========================================\n");
+    printf("   TEST SUMMARY\n");
+    printf("========================================\n");
+    printf("Tests Passed: %d\n", tests_passed);
+    printf("Tests Failed: %d\n", tests_failed);
+    printf("Total Tests: %d\n", tests_passed + tests_failed);
+    printf("Success Rate: %.2f%%\n",
+           (tests_passed * 100.0) / (tests_passed + tests_failed));
+    printf("========================================\n\n");
+    
+    return (tests_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,122 @@
+#include "../include/trace.h"
+#include "../include/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+
+// FIELD LABELS
+
+
+// Payload field names per event type (NULL = unused)
+static const char *payload_labels[][TRACE_PAYLOAD_FIELDS] = {
+    [TRACE_ADMIT] = {"priority", "energy", "burst_ms", "deadline_ms"},
+    [TRACE_DISPATCH] = {"algorithm", "mode", "remaining_ms", "battery"},
+    [TRACE_PREEMPT] = {"remaining_ms", NULL, NULL, NULL},
+    [TRACE_SUSPEND] = {"remaining_ms", NULL, NULL, NULL},
+    [TRACE_RESUME] = {"remaining_ms", NULL, NULL, NULL},
+    [TRACE_COMPLETE] = {"waiting_us", "turnaround_us", "missed", NULL},
+    [TRACE_DROP] = {"remaining_ms", "deadline_ms", NULL, NULL},
+    [TRACE_MODE_CHANGE] = {"old_mode", "new_mode", "battery", NULL},
+    [TRACE_BATTERY] = {"battery", "state", "energy", NULL},
+    [TRACE_CONTEXT_SWITCH] = {"previous", "switches", NULL, NULL},
+};
+
+#define NUM_LABELLED_TYPES (sizeof(payload_labels) / sizeof(payload_labels[0]))
+
+
+// OUTPUT
+
+
+// Print one event as a CSV row
+static void print_csv(const TraceEvent *event) {
+    printf("%llu,%s,%d,%d,%d,%d,%d\n", (unsigned long long)event->timestamp_ns,
+           trace_event_name(event->type), event->task_id,
+           event->payload[0], event->payload[1], event->payload[2], event->payload[3]);
+}
+
+// Print one event as text, time relative to the start of the trace
+static void print_text(const TraceEvent *event, uint64_t start_ns) {
+    double offset_ms = (double)(int64_t)(event->timestamp_ns - start_ns) / 1e6;
+    printf("%12.3f ms  %-14s", offset_ms, trace_event_name(event->type));
+    if (event->task_id >= 0) {
+        printf(" task=%-4d", event->task_id);
+    } else {
+        printf("          ");
+    }
+    
+    if (event->type < NUM_LABELLED_TYPES) {
+        for (int i = 0; i < TRACE_PAYLOAD_FIELDS; i++) {
+            if (payload_labels[event->type][i] != NULL) {
+                printf(" %s=%d", payload_labels[event->type][i], event->payload[i]);
+            }
+        }
+    }
+    printf("\n");
+}
+
+
+// MAIN
+
+
+int main(int argc, char *argv[]) {
+    bool csv = false;
+    const char *path = NULL;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (path == NULL) {
+        fprintf(stderr, "Usage: %s [--csv] TRACE_FILE\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return EXIT_FAILURE;
+    }
+    
+    TraceHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) != 0) {
+        fprintf(stderr, "%s is not a scheduler trace\n", path);
+        fclose(file);
+        return EXIT_FAILURE;
+    }
+    if (header.version != TRACE_VERSION || header.event_size != sizeof(TraceEvent)) {
+        fprintf(stderr, "Unsupported trace version %u (event size %u)\n",
+                header.version, header.event_size);
+        fclose(file);
+        return EXIT_FAILURE;
+    }
+    
+    if (csv) {
+        printf("timestamp_ns,event,task_id,p0,p1,p2,p3\n");
+    } else {
+        printf("# %llu events, %llu dropped\n",
+               (unsigned long long)header.count, (unsigned long long)header.dropped);
+    }
+    
+    // A trace that was never closed has count 0; read whatever is present
+    TraceEvent event;
+    uint64_t decoded = 0;
+    while ((header.count == 0 || decoded < header.count) &&
+           fread(&event, sizeof(event), 1, file) == 1) {
+        if (event.type == 0) {
+            break;  // Unused preallocated space
+        }
+        if (csv) {
+            print_csv(&event);
+        } else {
+            print_text(&event, header.start_ns);
+        }
+        decoded++;
+    }
+    
+    fclose(file);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+#include "../include/replay.h"
+#include "../include/workload.h"
+#include "../include/utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+
+// MAIN
+
+
+int main(int argc, char *argv[]) {
+    long generate = 0;
+    uint64_t seed = 1;
+    const char *paths[2] = {NULL, NULL};
+    int path_count = 0;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--generate=", 11) == 0) {
+            generate = atol(argv[i] + 11);
+        } else if (strncmp(argv[i], "--seed=", 7) == 0) {
+            seed = strtoull(argv[i] + 7, NULL, 10);
+        } else if (path_count < 2) {
+            paths[path_count++] = argv[i];
+        } else {
+            path_count = 3;
+        }
+    }
+    if ((generate > 0 && path_count != 1) || (generate <= 0 && path_count != 2)) {
+        fprintf(stderr, "Usage: %s INPUT OUTPUT\n"
+                "       %s --generate=N [--seed=S] OUTPUT\n"
+                "Output is CSV if its name ends in .csv, else binary; "
+                "input format is detected\n", argv[0], argv[0]);
+        return EXIT_FAILURE;
+    }
+    
+    // Tasks come from the default synthetic workload or the input trace
+    WorkloadGenerator gen;
+    WorkloadReplay replay;
+    TaskSpecSource next;
+    void *source;
+    if (generate > 0) {
+        WorkloadConfig config;
+        workload_default_config(&config);
+        config.task_count = generate;
+        config.seed = seed;
+        workload_init(&gen, &config);
+        next = workload_next;
+        source = &gen;
+    } else {
+        if (replay_open(&replay, paths[0]) != SUCCESS) {
+            fprintf(stderr, "Cannot read %s\n", paths[0]);
+            return EXIT_FAILURE;
+        }
+        next = replay_next;
+        source = &replay;
+    }
+    
+    const char *output = paths[path_count - 1];
+    WorkloadWriter writer;
+    int result = workload_writer_open(&writer, output);
+    
+    TaskSpec spec;
+    while (result == SUCCESS && next(source, &spec)) {
+        result = workload_writer_write(&writer, &spec);
+    }
+    if (writer.file != NULL && workload_writer_close(&writer) != SUCCESS) {
+        result = ERROR;
+    }
+    
+    if (generate <= 0) {
+        replay_close(&replay);
+        if (replay.errors > 0 || replay.reordered > 0) {
+            fprintf(stderr, "%ld malformed lines skipped, %ld tasks moved to keep arrival order\n",
+                    replay.errors, replay.reordered);
+        }
+    }
+    if (result != SUCCESS) {
+        fprintf(stderr, "Cannot write %s\n", output);
+        return EXIT_FAILURE;
+    }
+    
+    printf("Wrote %llu tasks to %s\n", (unsigned long long)writer.count, output);
+    return EXIT_SUCCESS;
+}